@@ -13,7 +13,57 @@
  * ==============================================================================
  */
 
+#ifndef XD_ALIASES_H
+#define XD_ALIASES_H
+
 #include "xd_list.h"
+#include "xd_vec.h"
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Represents the type of a token of an alias value.
+ */
+typedef enum xd_alias_token_type_t {
+  XD_ALIAS_TOKEN_WORD,             // word (`xd_alias_token_t.word`)
+  XD_ALIAS_TOKEN_NEWLINE,          // `\n`
+  XD_ALIAS_TOKEN_LT,               // `<`
+  XD_ALIAS_TOKEN_GT,               // `>`
+  XD_ALIAS_TOKEN_GT_GT,            // `>>`
+  XD_ALIAS_TOKEN_TWO_GT,           // `2>`
+  XD_ALIAS_TOKEN_TWO_GT_GT,        // `2>>`
+  XD_ALIAS_TOKEN_GT_AMPERSAND,     // `>&`
+  XD_ALIAS_TOKEN_GT_GT_AMPERSAND,  // `>>&`
+  XD_ALIAS_TOKEN_PIPE,             // `|`
+  XD_ALIAS_TOKEN_AMPERSAND,        // `&`
+} xd_alias_token_type_t;
+
+/**
+ * @brief Represents a token of an alias value.
+ */
+typedef struct xd_alias_token_t {
+  xd_alias_token_type_t type;  // type of the token
+  char *word;                  // text of the word (quotes kept), or `NULL`
+  int end;                     // offset in the alias value after the token
+} xd_alias_token_t;
+
+/**
+ * @brief Represents a defined alias.
+ */
+typedef struct xd_alias_t {
+  char *value;               // alias value
+  int is_tokenized;          // whether `value` was split into `tokens`
+  xd_alias_token_t *tokens;  // tokens of `value`
+  int token_count;           // number of tokens
+  int ref_count;             // number of holders (the aliases map included)
+  int expanding_frame;       // innermost input frame expanding it, or `-1`
+} xd_alias_t;
+
+// ========================
+// Function Declarations
+// ========================
 
 /**
  * @brief Initializes the aliases hash map.
@@ -51,9 +101,26 @@ void xd_aliases_clear();
  */
 char *xd_aliases_get(char *name);
 
+/**
+ * @brief Retrieves an alias by its name.
+ *
+ * @param name Pointer to the null-terminated string representing the alias
+ * name.
+ *
+ * @return A pointer to the alias, or `NULL` if the alias does not exist.
+ *
+ * @note The returned alias is owned by the aliases map, it must be passed to
+ * `xd_aliases_hold()` to be used after the alias is updated or removed.
+ */
+xd_alias_t *xd_aliases_get_alias(char *name);
+
 /**
  * @brief Inserts a new alias or updates an existing alias in the aliases map.
  *
+ * The value is split into tokens here, as the scanner would split it, so
+ * expanding the alias doesn't scan its value again. Values the tokens can't
+ * represent (an unterminated quote, or a trailing `\`) are left unsplit.
+ *
  * @param name Pointer to the null-terminated string representing the alias
  * name.
  * @param value Pointer to the null-terminated string representing the alias
@@ -78,18 +145,34 @@ void xd_aliases_put(char *name, char *value);
 int xd_aliases_remove(char *name);
 
 /**
- * @brief Returns a newly allocated `xd_list` structure containing the names of
+ * @brief Adds a holder to the passed alias, keeping it valid until
+ * `xd_aliases_release()` is called for it.
+ *
+ * @param alias Pointer to the alias.
+ */
+void xd_aliases_hold(xd_alias_t *alias);
+
+/**
+ * @brief Removes a holder from the passed alias, freeing it when it's no
+ * longer held.
+ *
+ * @param alias Pointer to the alias.
+ */
+void xd_aliases_release(xd_alias_t *alias);
+
+/**
+ * @brief Returns a newly allocated `xd_vec_t` structure containing the names of
  * all defined aliases.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing the names of all
+ * @return Pointer to a newly allocated `xd_vec_t` containing the names of all
  * defined aliases or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_listr_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-xd_list_t *xd_aliases_names_list();
+xd_vec_t *xd_aliases_names_list();
 
 /**
  * @brief Prints all aliases to stdout.
@@ -104,3 +187,5 @@ void xd_aliases_print_all();
  * @return `1` if the passed string is a valid alias name, `0` otherwise.
  */
 int xd_aliases_is_valid_name(const char *name);
+
+#endif  // XD_ALIASES_H
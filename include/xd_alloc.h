@@ -0,0 +1,150 @@
+/*
+ * ==============================================================================
+ * File: xd_alloc.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_ALLOC_H
+#define XD_ALLOC_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Subsystems whose allocations are accounted separately.
+ */
+typedef enum xd_alloc_subsystem_t {
+  XD_ALLOC_STRING,    // `xd_string_t` structures and buffers
+  XD_ALLOC_LIST,      // `xd_list_t` structures and nodes
+  XD_ALLOC_MAP,       // `xd_map_t` structures, buckets and entries
+  XD_ALLOC_COMMAND,   // `xd_command_t` structures and arguments
+  XD_ALLOC_JOB,       // `xd_job_t` structures and command arrays
+  XD_ALLOC_READLINE,  // Input buffers and history of `xd_readline`
+  XD_ALLOC_VEC,       // `xd_vec_t` structures and arrays
+  XD_ALLOC_INTERN,    // Interned symbols and the intern table
+  XD_ALLOC_SUBSYSTEM_COUNT
+} xd_alloc_subsystem_t;
+
+/**
+ * @brief Allocation counters of a subsystem.
+ */
+typedef struct xd_alloc_stats_t {
+  size_t allocations;    // Number of blocks allocated so far
+  size_t frees;          // Number of blocks freed so far
+  size_t current_bytes;  // Bytes currently allocated
+  size_t peak_bytes;     // Highest value reached by `current_bytes`
+} xd_alloc_stats_t;
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Allocates `size` bytes on behalf of the passed subsystem.
+ *
+ * @param subsystem The subsystem the allocation is accounted to.
+ * @param size The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+void *xd_alloc_malloc(xd_alloc_subsystem_t subsystem, size_t size);
+
+/**
+ * @brief Resizes the passed block to `size` bytes on behalf of the passed
+ * subsystem.
+ *
+ * @param subsystem The subsystem the allocation is accounted to.
+ * @param ptr The block to be resized, must have been allocated by the same
+ * subsystem, or `NULL` to allocate a new block.
+ * @param size The new size in bytes.
+ *
+ * @return A pointer to the resized memory.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+void *xd_alloc_realloc(xd_alloc_subsystem_t subsystem, void *ptr, size_t size);
+
+/**
+ * @brief Duplicates the passed string on behalf of the passed subsystem.
+ *
+ * @param subsystem The subsystem the allocation is accounted to.
+ * @param str The null-terminated string to be duplicated.
+ *
+ * @return A pointer to the duplicated string.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+char *xd_alloc_strdup(xd_alloc_subsystem_t subsystem, const char *str);
+
+/**
+ * @brief Frees the passed block on behalf of the passed subsystem.
+ *
+ * @param subsystem The subsystem the block was allocated by.
+ * @param ptr The block to be freed.
+ *
+ * @note If the passed pointer is `NULL` no action shall occur.
+ */
+void xd_alloc_free(xd_alloc_subsystem_t subsystem, void *ptr);
+
+/**
+ * @brief Stops accounting the passed block to the passed subsystem without
+ * freeing it, for blocks handed over to code that frees them with `free()`.
+ *
+ * @param subsystem The subsystem the block was allocated by.
+ * @param ptr The block being handed over.
+ *
+ * @note If the passed pointer is `NULL` no action shall occur.
+ */
+void xd_alloc_hand_off(xd_alloc_subsystem_t subsystem, void *ptr);
+
+/**
+ * @brief Returns the counters of the passed subsystem.
+ *
+ * @param subsystem The subsystem whose counters are returned.
+ *
+ * @return A pointer to the counters of the subsystem, or `NULL` if the
+ * subsystem is invalid.
+ */
+const xd_alloc_stats_t *xd_alloc_get_stats(xd_alloc_subsystem_t subsystem);
+
+/**
+ * @brief Returns the counters of all subsystems together.
+ *
+ * @return A pointer to the total counters, whose peak is the highest total
+ * reached at once.
+ */
+const xd_alloc_stats_t *xd_alloc_get_total();
+
+/**
+ * @brief Returns the name of the passed subsystem.
+ *
+ * @param subsystem The subsystem whose name is returned.
+ *
+ * @return The name of the subsystem, or `NULL` if the subsystem is invalid.
+ */
+const char *xd_alloc_get_name(xd_alloc_subsystem_t subsystem);
+
+/**
+ * @brief Prints the counters of all subsystems as a table, followed by their
+ * total.
+ *
+ * @param stream The stream to print to.
+ */
+void xd_alloc_print_stats(FILE *stream);
+
+#endif  // XD_ALLOC_H
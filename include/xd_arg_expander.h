@@ -16,7 +16,7 @@
 #ifndef XD_ARG_EXPANDER_H
 #define XD_ARG_EXPANDER_H
 
-#include "xd_list.h"
+#include "xd_vec.h"
 
 /**
  * @brief Initializes the argument expander.
@@ -31,7 +31,7 @@ void xd_arg_expander_init();
 void xd_arg_expander_destroy();
 
 /**
- * @brief Performs shell expansions on the passed argument and returns a list
+ * @brief Performs shell expansions on the passed argument and returns an array
  * containing the result of the expansions.
  *
  * Expansions are performed in the following order:
@@ -50,14 +50,14 @@ void xd_arg_expander_destroy();
  *
  * @param arg Pointer to the null-terminated argument string to be expanded.
  *
- * @return Pointer to a newly allocated `xd_list_t` structure containing the
+ * @return Pointer to a newly allocated `xd_vec_t` structure containing the
  * result of the expansions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-xd_list_t *xd_arg_expander(char *arg);
+xd_vec_t *xd_arg_expander(char *arg);
 
 #endif  // XD_ARG_EXPANDER_H
@@ -17,6 +17,7 @@
 #define XD_BUILTINS_H
 
 #include "xd_list.h"
+#include "xd_vec.h"
 
 /**
  * @brief Checks if the passed string is a built-in command name.
@@ -40,17 +41,27 @@ int xd_builtins_is_builtin(const char *str);
 int xd_builtins_execute(int argc, char **argv);
 
 /**
- * @brief Returns a newly allocated `xd_list` structure containing the names of
+ * @brief Returns the flag holding the state of the shell option with the passed
+ * long name (`set -o <name>`).
+ *
+ * @param name The long name of the option.
+ *
+ * @return A pointer to the flag of the option, or `NULL` if not found.
+ */
+int *xd_builtins_option_flag(const char *name);
+
+/**
+ * @brief Returns a newly allocated `xd_vec_t` structure containing the names of
  * all defined builtins.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing the names of all
+ * @return Pointer to a newly allocated `xd_vec_t` containing the names of all
  * defined builtins or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_listr_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-xd_list_t *xd_builtins_names_list();
+xd_vec_t *xd_builtins_names_list();
 
 #endif  // XD_BUILTINS_H
@@ -16,9 +16,13 @@
 #ifndef XD_COMMAND_H
 #define XD_COMMAND_H
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 
+#include "xd_vec.h"
+
 // ========================
 // Typedefs
 // ========================
@@ -28,16 +32,21 @@
  * information.
  */
 typedef struct xd_command_t {
-  int argc;           // Number of arguments
-  char **argv;        // Array of arguments (null-terminated)
-  char *input_file;   // File for stdin redirection
-  char *output_file;  // File for stdout redirection
-  int append_output;  // Whether to append to the output file
-  char *error_file;   // File for stderr redirection
-  int append_error;   // Whether to append to the error file
-  pid_t pid;          // PID of the process executing the command
-  int wait_status;    // Status of command process when reaped with wait
-  char *str;          // String used to run this command
+  int argc;               // Number of arguments
+  char **argv;            // Array of arguments (null-terminated)
+  xd_vec_t *args;         // Arguments, `argv` is its buffer (or `NULL`)
+  char *input_file;       // File for stdin redirection
+  char *output_file;      // File for stdout redirection
+  int append_output;      // Whether to append to the output file
+  char *error_file;       // File for stderr redirection
+  int append_error;       // Whether to append to the error file
+  pid_t pid;              // PID of the process executing the command
+  int pidfd;              // pidfd of the process (`-1` if not open)
+  int wait_status;        // Status of command process when reaped with wait
+  char *str;              // String used to run this command
+  struct rusage rusage;   // Resource usage of the process once reaped
+  uint64_t start_time;    // Time the process was started (nanoseconds)
+  uint64_t end_time;      // Time the process was reaped (nanoseconds)
 } xd_command_t;
 
 // ========================
@@ -69,6 +78,9 @@ void xd_command_destroy(xd_command_t *command);
  * @brief Adds the passed argument to the arguments array of the passed
  * `xd_command_t` structure.
  *
+ * The arguments are kept in an `xd_vec_t` whose buffer is `argv`, so adding
+ * an argument takes amortized constant time.
+ *
  * @param command A pointer to the `xd_command_t` structure to which the
  * argument will be added.
  * @param arg The argument to be added.
@@ -0,0 +1,119 @@
+/*
+ * ==============================================================================
+ * File: xd_intern.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_INTERN_H
+#define XD_INTERN_H
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Returns the unique symbol for the passed string, adding it to the
+ * intern table if it wasn't interned before.
+ *
+ * Equal strings always yield the same symbol, so symbols can be compared by
+ * pointer. A symbol stays valid until `xd_intern_destroy()` is called.
+ *
+ * @param str Pointer to the null-terminated string to intern.
+ *
+ * @return The symbol of the string, or `NULL` if the passed pointer is `NULL`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note The returned symbol is owned by the intern table and must not be
+ * freed or modified.
+ */
+const char *xd_intern(const char *str);
+
+/**
+ * @brief Returns the symbol for the passed string without interning it.
+ *
+ * @param str Pointer to the null-terminated string to look up.
+ *
+ * @return The symbol of the string, or `NULL` if the string was never
+ * interned or the passed pointer is `NULL`.
+ */
+const char *xd_intern_lookup(const char *str);
+
+/**
+ * @brief Returns the hash of the passed symbol, which is computed once when
+ * the symbol is interned.
+ *
+ * @param symbol A symbol returned by `xd_intern()`.
+ *
+ * @return The hash of the symbol, or `0` if the passed pointer is `NULL`.
+ *
+ * @warning Passing a string that isn't a symbol is undefined behavior.
+ */
+unsigned int xd_intern_hash(const char *symbol);
+
+/**
+ * @brief Returns the number of interned symbols.
+ *
+ * @return The number of symbols in the intern table.
+ */
+int xd_intern_count();
+
+/**
+ * @brief Frees all interned symbols and the intern table.
+ *
+ * @warning All previously returned symbols become invalid.
+ */
+void xd_intern_destroy();
+
+/**
+ * @brief Interns the passed string, to be passed to generic data structures
+ * as copy function for symbol keys.
+ *
+ * @param data Pointer to the null-terminated string to intern.
+ *
+ * @return The symbol of the string, or `NULL` if the passed pointer is `NULL`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+void *xd_intern_copy_func(void *data);
+
+/**
+ * @brief Does nothing, symbols are owned by the intern table. To be passed to
+ * generic data structures as destroy function for symbol keys.
+ *
+ * @param data Pointer to a symbol.
+ */
+void xd_intern_destroy_func(void *data);
+
+/**
+ * @brief Compares two symbols by their addresses, to be passed to generic data
+ * structures as comparison function for symbol keys.
+ *
+ * @param data1 Pointer to the first symbol.
+ * @param data2 Pointer to the second symbol.
+ *
+ * @return `0` if both are the same symbol, a negative or positive value
+ * otherwise.
+ */
+int xd_intern_comp_func(const void *data1, const void *data2);
+
+/**
+ * @brief Returns the precomputed hash of the passed symbol, to be passed to
+ * generic data structures as hash function for symbol keys.
+ *
+ * @param data Pointer to a symbol.
+ *
+ * @return The hash of the symbol, or `0` if the passed pointer is `NULL`.
+ */
+unsigned int xd_intern_hash_func(void *data);
+
+#endif  // XD_INTERN_H
@@ -17,15 +17,42 @@
 #define XD_JOB_H
 
 #include <inttypes.h>
+#include <stdio.h>
 #include <sys/types.h>
 #include <termios.h>
 
 #include "xd_command.h"
 
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Format used to report the times of a job run with `time` when
+ * `TIMEFORMAT` is unset.
+ */
+#define XD_JOB_DEF_TIMEFORMAT \
+  "\nreal\t%3lR\nuser\t%3lU\nsys\t%3lS\nmaxrss\t%MK"
+
+/**
+ * @brief Format used to report the times of a job run with `time -p`, one
+ * `key value` pair per line for easy parsing by scripts.
+ */
+#define XD_JOB_POSIX_TIMEFORMAT "real %2R\nuser %2U\nsys %2S\nmaxrss %M"
+
 // ========================
 // Typedefs
 // ========================
 
+/**
+ * @brief Whether and how a job is timed with the `time` keyword.
+ */
+typedef enum xd_job_time_t {
+  XD_JOB_TIME_NONE,     // Not timed
+  XD_JOB_TIME_DEFAULT,  // Timed with `time`, reported using `TIMEFORMAT`
+  XD_JOB_TIME_POSIX,    // Timed with `time -p`, reported in portable format
+} xd_job_time_t;
+
 /**
  * @brief Represents a shell job (pipeline of commands).
  */
@@ -40,8 +67,17 @@ typedef struct xd_job_t {
   int job_id;                // Id of the job (in jobs list)
   uint64_t last_active;      // Last time job recived a signal
   int notify;                // Whether to notify the status change
+  int is_waited;             // Whether `wait` already returned the status
   struct termios tty_modes;  // tty modes for the job
   int has_tty_modes;         // Whether tty modes were stored in `tty_modes`
+  xd_job_time_t time_mode;   // Whether the job is timed with `time`
+  uint64_t start_time;       // Time the job was started (nanoseconds)
+  uint64_t end_time;         // Time the last process was reaped (nanoseconds)
+  uint64_t expansion_time;   // Time spent expanding arguments (nanoseconds)
+  uint64_t spawn_time;       // Time spent forking processes (nanoseconds)
+  uint64_t wait_time;        // Time spent waiting in foreground (nanoseconds)
+  uint64_t parse_time;       // Time spent parsing, without expansion (ns)
+  char *location;            // Source location of the job when profiling
 } xd_job_t;
 
 // ========================
@@ -134,6 +170,40 @@ void xd_job_print_string(xd_job_t *job);
 void xd_job_print_status(xd_job_t *job, char marker, int detailed,
                          int print_pid);
 
+/**
+ * @brief Prints the elapsed real time and the user and system CPU times of
+ * the passed finished job, summed over all of its processes, to the passed
+ * stream followed by a newline.
+ *
+ * The format is interpreted like bash's `TIMEFORMAT`: `%%` is a literal `%`,
+ * `%[p][l]R`, `%[p][l]U` and `%[p][l]S` are the real, user and system times in
+ * seconds with `p` (`0`-`3`, default `3`) fractional digits, where `l` selects
+ * the longer `MMmSS.FFs` form, and `%P` is the CPU percentage. In addition,
+ * `%M` is the largest maximum resident set size of the processes in
+ * kilobytes. Any other character is printed as is.
+ *
+ * @param job A pointer to the `xd_job_t` structure to print its times.
+ * @param format The format of the report, nothing is printed if empty.
+ * @param stream The stream to print the report to.
+ */
+void xd_job_print_times(const xd_job_t *job, const char *format,
+                        FILE *stream);
+
+/**
+ * @brief Prints a line with the resource usage of each process of the passed
+ * job: its PID, the elapsed real time, the user plus system CPU time and the
+ * peak resident set size.
+ *
+ * Reaped processes report the usage collected by `wait4()`, processes still
+ * running report their current usage read from `/proc`.
+ *
+ * @param job A pointer to the `xd_job_t` structure to print its usage.
+ * @param now The current time of the monotonic clock (nanoseconds), used as
+ * the end time of processes still running.
+ * @param stream The stream to print to.
+ */
+void xd_job_print_usage(const xd_job_t *job, uint64_t now, FILE *stream);
+
 /**
  * @brief Executes the passed job.
  *
@@ -25,4 +25,20 @@
  */
 void xd_job_executor(xd_job_t *job);
 
+/**
+ * @brief Starts the processes of the passed job in background without adding
+ * it to the jobs table, printing it, or waiting for it.
+ *
+ * Used by builtins that manage their own jobs (e.g. `parallel`), this function
+ * can be called while a job is being executed.
+ *
+ * @param job A pointer to the `xd_job_t` structure to be started.
+ *
+ * @return `0` on success, or `-1` on failure (the job is destroyed).
+ *
+ * @note The caller is responsible for waiting for the job, e.g. with
+ * `xd_jobs_wait_any()`, and freeing it by calling `xd_job_destroy()`.
+ */
+int xd_job_executor_launch(xd_job_t *job);
+
 #endif  // XD_JOB_EXECUTOR_H
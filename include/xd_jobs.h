@@ -18,22 +18,26 @@
 
 #include <sys/types.h>
 
+#include "xd_command.h"
 #include "xd_job.h"
 
 /**
- * @brief Initialize the jobs list.
+ * @brief Initialize the jobs table.
  */
 void xd_jobs_init();
 
 /**
- * @brief Frees the memory allocated for the jobs list.
+ * @brief Frees the memory allocated for the jobs table.
  */
 void xd_jobs_destroy();
 
 /**
- * @brief Adds the passed job to the end of the jobs list and gives it a job id.
+ * @brief Adds the passed job to the jobs table and gives it the lowest free job
+ * id.
  *
  * @param job A pointer to the job to be added.
+ *
+ * @note Ids start over from `1` once all jobs are removed.
  */
 void xd_jobs_add(xd_job_t *job);
 
@@ -43,17 +47,63 @@ void xd_jobs_add(xd_job_t *job);
  * @param pid pid The process id to look for.
  *
  * @return A pointer to the job that has a child with the passed PID, or `NULL`
- * if not found or if the jobs list is not initialized yet.
+ * if not found or if the jobs table is not initialized yet.
+ *
+ * @note The lookup is done in constant time through the PID index.
  */
 xd_job_t *xd_jobs_get_with_pid(pid_t pid);
 
+/**
+ * @brief Returns the command executed by the child process with the passed PID,
+ * along with the job that owns it.
+ *
+ * @param pid The process id to look for.
+ * @param job If not `NULL`, receives a pointer to the job that owns the
+ * command, or `NULL` if not found.
+ *
+ * @return A pointer to the command executed by the child process with the
+ * passed PID, or `NULL` if not found or if the jobs table is not initialized
+ * yet.
+ *
+ * @note The lookup is done in constant time through the PID index, which holds
+ * the child processes of the jobs in the jobs table.
+ */
+xd_command_t *xd_jobs_get_command_with_pid(pid_t pid, xd_job_t **job);
+
+/**
+ * @brief Collects the saved status of the finished background process with the
+ * passed PID, the statuses of the processes of the finished background jobs
+ * are saved when the jobs are removed from the jobs table.
+ *
+ * @param pid The process id to look for.
+ * @param wait_status Receives the wait status of the process.
+ *
+ * @return `0` if a saved status was found and collected (it's no longer
+ * saved), or `-1` if not found.
+ */
+int xd_jobs_collect_pid_status(pid_t pid, int *wait_status);
+
+/**
+ * @brief Collects the saved status of the finished background job that had the
+ * passed job id.
+ *
+ * @param job_id The job id to look for.
+ * @param wait_status Receives the wait status of the job.
+ *
+ * @return `0` if a saved status was found and collected (the statuses of the
+ * processes of the job are no longer saved), or `-1` if not found.
+ */
+int xd_jobs_collect_job_status(int job_id, int *wait_status);
+
 /**
  * @brief Returns the job with the passed job id.
  *
  * @param job_id The id of the job.
  *
  * @return A pointer to the job with the passed job id, or `NULL` if not found
- * or if the jobs list is not initialized yet.
+ * or if the jobs table is not initialized yet.
+ *
+ * @note The lookup is done in constant time, the table is indexed by job id.
  */
 xd_job_t *xd_jobs_get_with_id(int job_id);
 
@@ -71,20 +121,49 @@ xd_job_t *xd_jobs_get_current();
  */
 xd_job_t *xd_jobs_get_previous();
 
+/**
+ * @brief Returns the number of jobs in the jobs table.
+ *
+ * @return The number of jobs in the jobs table.
+ */
+int xd_jobs_get_count();
+
+/**
+ * @brief Stores the jobs of the jobs table in the passed array, ordered by
+ * job id.
+ *
+ * @param jobs The array to fill, must have room for `xd_jobs_get_count()` jobs.
+ *
+ * @return The number of jobs stored.
+ */
+int xd_jobs_get_all(xd_job_t **jobs);
+
 /**
  * @brief Prints the status of all the jobs.
  *
  * @param detailed Whether to print the detailed status.
  * @param print_pids Whether to print the process ID(s).
+ * @param verbose Whether to print the resource usage of each process.
  */
-void xd_jobs_print_status_all(int detailed, int print_pids);
+void xd_jobs_print_status_all(int detailed, int print_pids, int verbose);
 
 /**
- * @brief Print job notifications, remove finished jobs, and update current
- * (`+`) and previous (`-`) jobs.
+ * @brief Reap pending children, print job notifications, remove finished jobs,
+ * and update current (`+`) and previous (`-`) jobs.
+ *
+ * @note Only the jobs that were active since the last call are visited, this
+ * function does nothing when no job was active.
  */
 void xd_jobs_refresh();
 
+/**
+ * @brief Checks whether a job has a status notification that will be printed
+ * by the next call to `xd_jobs_refresh()`.
+ *
+ * @return `1` if a notification is pending, `0` otherwise.
+ */
+int xd_jobs_has_notifications();
+
 /**
  * @brief Puts the process group with the passed id in control of the terminal.
  *
@@ -113,9 +192,53 @@ int xd_jobs_kill(xd_job_t *job, int signum);
  * @param job The job to wait for.
  *
  * @return The last exit code of the passed job.
+ *
+ * @note The processes are waited through their pidfds and the `SIGCHLD`
+ * self-pipe in a single `poll()`, every state change is collected as soon as it
+ * happens regardless of the position of the process in the pipeline.
  */
 int xd_jobs_wait(xd_job_t *job);
 
+/**
+ * @brief Waits, without putting them in foreground, until one of the passed
+ * jobs (or processes) terminates or stops.
+ *
+ * @param jobs Array of the jobs to wait for.
+ * @param commands Array of the same length as `jobs`, a non-`NULL` entry
+ * restricts the wait to the process executing that command of the job, may be
+ * `NULL` to wait for whole jobs.
+ * @param count The number of entries in `jobs`.
+ * @param timeout_ms The timeout in milliseconds, or `-1` to wait indefinitely.
+ *
+ * @return The index of the first job (or process) found terminated or stopped,
+ * or `-1` on failure (`errno` is set to `ETIMEDOUT` if the timeout expired, or
+ * to `EINTR` if the shell was interrupted).
+ *
+ * @note The wait blocks in `xd_jobs_poll()`, no busy-polling is done.
+ */
+int xd_jobs_wait_any(xd_job_t **jobs, xd_command_t **commands, int count,
+                     int timeout_ms);
+
+/**
+ * @brief Converts the passed wait status to a shell exit code.
+ *
+ * @param wait_status The wait status returned by `waitpid()`, or `-1`.
+ *
+ * @return The exit status if the process exited, `128` plus the signal number
+ * if it was terminated or stopped by a signal, or `0` otherwise.
+ */
+int xd_jobs_exit_code(int wait_status);
+
+/**
+ * @brief Prints the times of the passed finished job to `stderr` if it was run
+ * with the `time` keyword, using `TIMEFORMAT` (or `XD_JOB_DEF_TIMEFORMAT` if
+ * unset) for `time` and `XD_JOB_POSIX_TIMEFORMAT` for `time -p`.
+ *
+ * @param job A pointer to the `xd_job_t` structure to report its times, it's
+ * reported at most once.
+ */
+void xd_jobs_report_times(xd_job_t *job);
+
 /**
  * @brief Non-blocking wait, used to update the status of the passed job after
  * sending a signal.
@@ -125,19 +248,59 @@ int xd_jobs_wait(xd_job_t *job);
 void xd_jobs_wait_non_blocking(xd_job_t *job);
 
 /**
- * @brief Blocks delivery of the `SIGCHLD` signal.
+ * @brief Records the delivery of a `SIGCHLD` signal, the children are reaped
+ * later from the main loop by `xd_jobs_reap()`.
  *
- * @note This function must be paired with a corresponding call to
- * `xd_jobs_sigchld_unblock()`.
+ * @note This function is async-signal-safe and is meant to be the only thing
+ * done by the `SIGCHLD` handler.
  */
-void xd_jobs_sigchld_block();
+void xd_jobs_sigchld_notify();
 
 /**
- * @brief Unblocks delivery of the `SIGCHLD` signal.
+ * @brief Returns the read-end of the pipe written by `xd_jobs_sigchld_notify()`.
+ *
+ * @return The file descriptor that becomes readable when a `SIGCHLD` is
+ * received, or `-1` if the jobs table is not initialized yet.
+ *
+ * @note Used to wake up blocking waits (e.g. `xd_readline()`), the descriptor
+ * doesn't need to be drained by the caller, `xd_jobs_reap()` does that.
+ */
+int xd_jobs_sigchld_fd();
+
+/**
+ * @brief Replaces the `SIGCHLD` self-pipe with a new one.
+ *
+ * @note Called by a forked child that waits for children of its own (e.g. a
+ * builtin in a pipeline), so it doesn't share the pipe with the parent shell.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` if the pipe can't be
+ * created.
+ */
+void xd_jobs_sigchld_reopen();
+
+/**
+ * @brief Reaps the children that changed state since the last recorded
+ * `SIGCHLD` and updates their jobs.
+ *
+ * @note This function does nothing if no `SIGCHLD` was recorded, it's called
+ * by `xd_jobs_refresh()`.
+ */
+void xd_jobs_reap();
+
+/**
+ * @brief Waits until a process of the passed jobs may have changed state, or
+ * until the passed timeout expires.
+ *
+ * @param jobs Array of the jobs to wait for.
+ * @param job_count The number of jobs in `jobs`.
+ * @param timeout_ms The timeout in milliseconds, or `-1` to wait indefinitely.
+ *
+ * @return `1` if a process may have changed state, `0` if the timeout expired,
+ * or `-1` on failure or if interrupted by a signal (`errno` is set).
  *
- * @note This function must be called only after a matching call to
- * `xd_jobs_sigchld_block()`.
+ * @note This function doesn't reap, the state changes are collected by
+ * `xd_jobs_wait_non_blocking()`.
  */
-void xd_jobs_sigchld_unblock();
+int xd_jobs_poll(xd_job_t **jobs, int job_count, int timeout_ms);
 
 #endif  // XD_JOBS_H
@@ -68,6 +68,23 @@ xd_list_t *xd_list_create(xd_gens_copy_func_t copy_func,
                           xd_gens_destroy_func_t destroy_func,
                           xd_gens_comp_func_t comp_func);
 
+/**
+ * @brief Creates and initializes a new `xd_list_t` structure that stores the
+ * passed pointers themselves instead of copies of the data.
+ *
+ * @param comp_func A pointer to the function used to compare two data elements
+ * in the list.
+ *
+ * @return A pointer to the newly created `xd_list_t` on success, or `NULL` if
+ * the passed function pointer is `NULL`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note The list doesn't own the stored data, which must outlive its nodes and
+ * is not freed when they are removed.
+ */
+xd_list_t *xd_list_create_borrowed(xd_gens_comp_func_t comp_func);
+
 /**
  * @brief Frees the memory allocated for the passed `xd_list_t` structure.
  *
@@ -239,4 +256,12 @@ int xd_list_remove_node(xd_list_t *list, xd_list_node_t *node);
  */
 void *xd_list_get_node(xd_list_t *list, int index);
 
+/**
+ * @brief Frees the nodes kept for reuse by all lists.
+ *
+ * @note Nodes freed by lists are pooled and reused by later insertions instead
+ * of being returned to the allocator.
+ */
+void xd_list_pool_clear();
+
 #endif  // XD_LIST_H
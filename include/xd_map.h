@@ -27,8 +27,9 @@
  * @brief Represents a hash map bucket entry.
  */
 typedef struct xd_bucket_entry_t {
-  void *key;    // The key
-  void *value;  // The value
+  void *key;          // The key
+  void *value;        // The value
+  unsigned int hash;  // Hash of the key, computed once on insertion
 } xd_bucket_entry_t;
 
 /**
@@ -0,0 +1,68 @@
+/*
+ * ==============================================================================
+ * File: xd_profile.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_PROFILE_H
+#define XD_PROFILE_H
+
+#include "xd_job.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Name of the variable that enables profiling at startup and holds the
+ * path of the profile report.
+ */
+#define XD_PROFILE_VAR "XDSH_PROFILE"
+
+/**
+ * @brief Suffix appended to the report path to get the path of the collapsed
+ * stacks file.
+ */
+#define XD_PROFILE_FOLDED_SUFFIX ".folded"
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Writes the profile report and the collapsed stacks file if any job
+ * was profiled, then frees the memory allocated for the profile.
+ *
+ * The report is written to the path in `XDSH_PROFILE`, or to
+ * `xd-shell.<pid>.profile` if it's unset, with one row per source line sorted
+ * by the total time. The collapsed stacks, one `location;...;location time`
+ * line per input stack (times in microseconds), are written next to it with
+ * the `.folded` suffix, ready for flamegraph tools.
+ *
+ * @note Nothing is written by forked children of the shell.
+ */
+void xd_profile_destroy();
+
+/**
+ * @brief Adds the times of the passed finished job to its source location in
+ * the profile.
+ *
+ * The total time of a job is its parse, expansion and execution time, where
+ * the execution time covers forking, running and waiting for its processes.
+ * The CPU time is the user and system time of its processes.
+ *
+ * @param job A pointer to the finished `xd_job_t` structure, ignored if it has
+ * no location (it wasn't parsed while profiling).
+ */
+void xd_profile_record(const xd_job_t *job);
+
+#endif  // XD_PROFILE_H
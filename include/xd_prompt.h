@@ -0,0 +1,99 @@
+/*
+ * ==============================================================================
+ * File: xd_prompt.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_PROMPT_H
+#define XD_PROMPT_H
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Name of the variable holding the prompt string.
+ */
+#define XD_PROMPT_VAR "PS1"
+
+/**
+ * @brief Name of the variable holding the time in milliseconds to wait for the
+ * commands of the prompt before showing it.
+ */
+#define XD_PROMPT_BUDGET_VAR "XDSH_PROMPT_BUDGET"
+
+/**
+ * @brief Default time in milliseconds to wait for the commands of the prompt.
+ */
+#define XD_PROMPT_DEF_BUDGET (20)
+
+/**
+ * @brief Maximum number of `$(command)` segments in the prompt, the ones after
+ * are shown as is.
+ */
+#define XD_PROMPT_ASYNC_MAX (4)
+
+/**
+ * @brief Prompt string used when `PS1` is unset.
+ */
+#define XD_PROMPT_DEF_PS1 \
+  "\\[\\e[91m\\]\\u@\\H\\[\\e[0m\\]:\\[\\e[94m\\]\\w\\[\\e[0m\\]\\$ "
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Caches the user name, host name and working directory used by the
+ * prompt, called once at startup by an interactive shell.
+ */
+void xd_prompt_init();
+
+/**
+ * @brief Frees the memory used by the compiled and rendered prompt.
+ */
+void xd_prompt_destroy();
+
+/**
+ * @brief Updates the cached working directory, called whenever the shell
+ * changes its working directory.
+ *
+ * @param cwd The new working directory.
+ */
+void xd_prompt_set_cwd(const char *cwd);
+
+/**
+ * @brief Returns the prompt rendered from `PS1`, starting its commands.
+ *
+ * `PS1` is compiled into a list of segments only when it changes, and the
+ * segments are rendered again only when one of their inputs (the working
+ * directory, `HOME`, the number of jobs, the last exit code or the time)
+ * changes.
+ *
+ * Each `$(command)` in `PS1` is run in a background subshell for every new
+ * prompt (unless its previous run is still going), and the prompt waits for
+ * at most `XDSH_PROMPT_BUDGET` milliseconds for them. Commands that take
+ * longer show their previous output (or nothing) until they finish, then the
+ * prompt is redrawn in place.
+ *
+ * The following escapes are supported: `\u` user name, `\h` host name up to
+ * the first `.`, `\H` host name, `\w` working directory with `$HOME`
+ * abbreviated as `~`, `\W` base name of `\w`, `\$` `#` for the superuser and
+ * `$` otherwise, `\t` time as `HH:MM:SS`, `\j` number of jobs, `\?` last exit
+ * code, `\s` shell name, `\n` newline, `\e` escape, `\a` bell, `\\` backslash,
+ * and `\[` `\]` which are ignored.
+ *
+ * @return The rendered prompt, valid until the next call.
+ */
+const char *xd_prompt_get();
+
+#endif  // XD_PROMPT_H
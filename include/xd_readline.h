@@ -21,6 +21,12 @@
  */
 #define XD_RL_HISTORY_MAX (1000)
 
+/**
+ * @brief Maximum number of file descriptors that can be watched by
+ * `xd_readline()` while waiting for input.
+ */
+#define XD_RL_WATCHED_FDS_MAX (8)
+
 /**
  * @brief Characters which define the start of the word to be completed when
  * `Tab` key is pressed.
@@ -64,6 +70,14 @@ typedef char **(*xd_readline_completion_gen_func_t)(const char *line, int start,
  */
 extern xd_readline_completion_gen_func_t xd_readline_completions_generator;
 
+/**
+ * @brief Function type for the functions called by `xd_readline()` when a
+ * watched file descriptor becomes readable while waiting for input.
+ *
+ * @param fd The file descriptor that became readable.
+ */
+typedef void (*xd_readline_fd_handler_func_t)(int fd);
+
 /**
  * @brief Prompt string displayed at the beginning of each input line.
  *
@@ -84,6 +98,80 @@ extern const char *xd_readline_prompt;
  */
 char *xd_readline();
 
+/**
+ * @brief Adds the passed file descriptor to the set of file descriptors watched
+ * by `xd_readline()` while waiting for input, the passed handler is called
+ * whenever the file descriptor becomes readable.
+ *
+ * Used to serve events (e.g. child processes changing state) while the user is
+ * typing, without waiting for the line to be submitted.
+ *
+ * @param fd The file descriptor to watch.
+ * @param handler The function to call when `fd` becomes readable.
+ *
+ * @return `0` on success, or `-1` if `fd` is negative, `handler` is `NULL`, or
+ * `XD_RL_WATCHED_FDS_MAX` file descriptors are already watched.
+ *
+ * @warning The handler is called within `xd_readline()` where the terminal
+ * settings are changed, don't read/write to `stdout` or `stdin` within it,
+ * except for writing between `xd_readline_output_begin()` and
+ * `xd_readline_output_end()`.
+ *
+ * @note The handler must consume the data available on `fd`, otherwise it will
+ * be called again immediately.
+ *
+ * @note A signal that interrupts the wait without making any watched file
+ * descriptor readable still makes `xd_readline()` return `NULL` with `errno`
+ * set to `EINTR`.
+ */
+int xd_readline_watch_fd(int fd, xd_readline_fd_handler_func_t handler);
+
+/**
+ * @brief Removes the passed file descriptor from the set of file descriptors
+ * watched by `xd_readline()`.
+ *
+ * @param fd The file descriptor to stop watching.
+ *
+ * @return `0` on success, or `-1` if `fd` is not watched.
+ */
+int xd_readline_unwatch_fd(int fd);
+
+/**
+ * @brief Clears the prompt and the line being edited so that a watched file
+ * descriptor handler can write to the terminal.
+ *
+ * @warning Must only be called from within a watched file descriptor handler,
+ * and must be followed by a call to `xd_readline_output_end()`.
+ */
+void xd_readline_output_begin();
+
+/**
+ * @brief Flushes `stdout` and redraws the prompt and the line being edited
+ * after the output written since `xd_readline_output_begin()`.
+ *
+ * @note The output is expected to end with a newline, the prompt is redrawn
+ * at the beginning of the current line.
+ */
+void xd_readline_output_end();
+
+/**
+ * @brief Tells `xd_readline()` that the terminal may have been written to
+ * since it last returned, so the next call makes sure the prompt starts at the
+ * beginning of a line.
+ *
+ * @note Without this call, `xd_readline()` assumes the cursor is still at the
+ * beginning of the line following the last line read.
+ */
+void xd_readline_cursor_unknown();
+
+/**
+ * @brief Redraws the prompt and the line being edited in place after the
+ * string pointed to by `xd_readline_prompt` changed.
+ *
+ * @warning Must only be called from within a watched file descriptor handler.
+ */
+void xd_readline_prompt_redraw();
+
 /**
  * @brief Clears the history.
  */
@@ -95,8 +183,9 @@ void xd_readline_history_clear();
  *
  * @param str The string to be added to the history, must be null-terminated.
  *
- * @return `0` on success or `-1` if the passed string is `NULL` or on
- * allcoation failure.
+ * @return `0` on success or `-1` if the passed string is `NULL`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  */
 int xd_readline_history_add(const char *str);
 
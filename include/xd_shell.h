@@ -48,6 +48,11 @@
  */
 #define XD_SH_EXIT_CODE_NOT_FOUND (127)
 
+/**
+ * @brief Exit code when a wait times out (same as `timeout(1)`).
+ */
+#define XD_SH_EXIT_CODE_TIMEOUT (124)
+
 /**
  * @brief Offset added to signal numbers to generate a shell-compatible exit
  * status.
@@ -80,8 +85,8 @@
 // ========================
 
 /**
- * @brief Rebuilds `xd_sh_prompt` with the current user, host and working
- * directory.
+ * @brief Rebuilds `xd_sh_prompt` from the `PS1` variable (see
+ * `xd_prompt_get()`).
  */
 void xd_sh_update_prompt();
 
@@ -160,6 +165,31 @@ extern int xd_sh_last_exit_code;
  */
 extern pid_t xd_sh_last_bg_job_pid;
 
+/**
+ * @brief Indicates whether the status changes of background jobs are
+ * reported immediately (non-zero) or before the next prompt (zero), set by
+ * `set -b`.
+ */
+extern int xd_sh_notify;
+
+/**
+ * @brief Indicates whether the time spent on each source line is profiled,
+ * set by `set -o profile` or when `XDSH_PROFILE` is set at startup.
+ */
+extern int xd_sh_profile;
+
+/**
+ * @brief Indicates whether commands are traced before being executed, set by
+ * `set -x`.
+ */
+extern int xd_sh_xtrace;
+
+/**
+ * @brief Indicates whether traced commands are prefixed with timestamps, set
+ * by `set -o xtracetime`.
+ */
+extern int xd_sh_xtrace_time;
+
 /**
  * @brief The current modes for the shell.
  */
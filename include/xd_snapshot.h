@@ -0,0 +1,97 @@
+/*
+ * ==============================================================================
+ * File: xd_snapshot.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_SNAPSHOT_H
+#define XD_SNAPSHOT_H
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Name of the variable holding the path of the startup snapshot, the
+ * snapshot is disabled if it's unset or empty.
+ */
+#define XD_SNAPSHOT_VAR "XDSH_SNAPSHOT"
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Restores the variables, aliases, and shell options of the startup
+ * file at the passed path from the snapshot at the path held by
+ * `XDSH_SNAPSHOT`.
+ *
+ * The snapshot is used only if every file sourced while it was recorded still
+ * has the same modification time and size, and every variable read before
+ * being set by those files still has the same value and export state.
+ *
+ * @note The output of the command substitutions run by the startup files is
+ * restored as recorded, it can be stale until one of the files changes.
+ *
+ * @param rc_path The path of the startup file.
+ *
+ * @return `0` if the snapshot was restored, `-1` otherwise (nothing is
+ * changed in this case).
+ */
+int xd_snapshot_restore(const char *rc_path);
+
+/**
+ * @brief Starts recording the variables read and set by the startup file at
+ * the passed path.
+ *
+ * @param rc_path The path of the startup file.
+ */
+void xd_snapshot_record_start(const char *rc_path);
+
+/**
+ * @brief Adds the file at the passed path to the files the recorded snapshot
+ * depends on, does nothing if not recording.
+ *
+ * @param path The path of the sourced file.
+ */
+void xd_snapshot_track_file(const char *path);
+
+/**
+ * @brief Adds the shell option with the passed name to the options the
+ * recorded snapshot sets, does nothing if not recording.
+ *
+ * @param name The long name of the option (`set -o <name>`).
+ */
+void xd_snapshot_track_option(const char *name);
+
+/**
+ * @brief Checks whether a snapshot is being recorded by this process.
+ *
+ * @return `1` if recording, `0` otherwise.
+ */
+int xd_snapshot_is_recording();
+
+/**
+ * @brief Stops recording and writes the snapshot to the path held by
+ * `XDSH_SNAPSHOT`.
+ *
+ * @note The snapshot is written to a temporary file then renamed, so a
+ * concurrent restore never sees a partial snapshot.
+ */
+void xd_snapshot_save();
+
+/**
+ * @brief Stops recording and frees the memory used by the recording.
+ */
+void xd_snapshot_destroy();
+
+#endif  // XD_SNAPSHOT_H
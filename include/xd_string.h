@@ -21,8 +21,9 @@
 // ========================
 
 /**
- * Default initial capacity for `xd_string_t` buffers. The capacity grows in
- * multiples of this value when appending exceeds the current capacity.
+ * Default initial capacity for `xd_string_t` buffers, which is also the size
+ * of the inline storage embedded in every `xd_string_t`. The capacity doubles
+ * when appending exceeds the current capacity.
  */
 #define XD_STR_DEF_CAP (32)
 
@@ -32,11 +33,15 @@
 
 /**
  * @brief Represents a dynamically growable string buffer.
+ *
+ * Strings shorter than `XD_STR_DEF_CAP` bytes are kept in the inline `small`
+ * buffer, so `str` only points to a separate heap buffer once they outgrow it.
  */
 typedef struct xd_string_t {
-  char *str;     // Pointer to the internal null-terminated buffer
-  int length;    // Number of characters currently stored excluding '\0'
-  int capacity;  // Allocated buffer size in bytes including '\0'
+  char *str;                   // Pointer to the null-terminated buffer
+  int length;                  // Number of characters stored excluding '\0'
+  int capacity;                // Buffer size in bytes including '\0'
+  char small[XD_STR_DEF_CAP];  // Inline buffer used while the string fits
 } xd_string_t;
 
 // ========================
@@ -95,4 +100,69 @@ void xd_string_append_str(xd_string_t *string, const char *str);
  */
 void xd_string_append_chr(xd_string_t *string, char chr);
 
+/**
+ * @brief Appends the first `n` characters of the passed string to the end of
+ * the passed `xd_string_t`, without scanning it for its length.
+ *
+ * @param string A pointer to the target `xd_string_t` to append to.
+ * @param str A pointer to the characters to append, it must hold at least `n`
+ * characters and does not need to be null-terminated.
+ * @param n The number of characters to append.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note If `string` or `str` is `NULL` or `n` is not positive no action shall
+ * occur.
+ */
+void xd_string_append_n(xd_string_t *string, const char *str, int n);
+
+/**
+ * @brief Appends the result of formatting the passed arguments according to
+ * the `printf()`-style format string to the end of the passed `xd_string_t`.
+ *
+ * @param string A pointer to the target `xd_string_t` to append to.
+ * @param format A pointer to the null-terminated format string.
+ * @param ... The arguments referenced by the format string.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note If `string` or `format` is `NULL` or formatting fails no action shall
+ * occur.
+ */
+void xd_string_append_fmt(xd_string_t *string, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Grows the buffer of the passed `xd_string_t` so it can hold at least
+ * `capacity` bytes including '\0' without further reallocation.
+ *
+ * @param string A pointer to the `xd_string_t` to grow.
+ * @param capacity The minimum capacity in bytes including '\0'.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note If `string` is `NULL` or it already has enough capacity no action
+ * shall occur.
+ */
+void xd_string_reserve(xd_string_t *string, int capacity);
+
+/**
+ * @brief Hands the contents of the passed `xd_string_t` over to the caller and
+ * leaves the string empty.
+ *
+ * Strings that outgrew the inline buffer give away their heap buffer without
+ * copying it, short strings are copied into a new exactly sized buffer.
+ *
+ * @param string A pointer to the `xd_string_t` to release.
+ *
+ * @return A pointer to the null-terminated contents or `NULL` if the passed
+ * pointer is `NULL`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note The caller is responsible for freeing the returned buffer using
+ * `free()`.
+ */
+char *xd_string_release(xd_string_t *string);
+
 #endif  // XD_STRING_H
@@ -0,0 +1,63 @@
+/*
+ * ==============================================================================
+ * File: xd_telemetry.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_TELEMETRY_H
+#define XD_TELEMETRY_H
+
+#include "xd_job.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Name of the variable holding the path of the telemetry log, the
+ * logging is disabled if it's unset or empty.
+ */
+#define XD_TELEMETRY_VAR "XDSH_TELEMETRY"
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Flushes the buffered records and closes the telemetry log.
+ */
+void xd_telemetry_destroy();
+
+/**
+ * @brief Appends a record of the passed finished job to the telemetry log if
+ * `XDSH_TELEMETRY` is set.
+ *
+ * Each record is one JSON object per line holding the start and end times of
+ * the job (monotonic clock, nanoseconds), its exit code, the time spent in
+ * argument expansion, forking and waiting, the PIDs of its processes and the
+ * string used to run it.
+ *
+ * @param job A pointer to the finished `xd_job_t` structure to be recorded.
+ * @param exit_code The exit code of the job.
+ *
+ * @note Records are buffered and written with `O_APPEND` once the buffer
+ * fills up, the log changes or the shell exits. Records buffered by a parent
+ * shell are never written by its subshells.
+ */
+void xd_telemetry_record(const xd_job_t *job, int exit_code);
+
+/**
+ * @brief Writes the buffered records to the telemetry log.
+ */
+void xd_telemetry_flush();
+
+#endif  // XD_TELEMETRY_H
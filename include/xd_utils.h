@@ -16,6 +16,9 @@
 #ifndef XD_UTILS_H
 #define XD_UTILS_H
 
+#include <stdint.h>
+#include <sys/types.h>
+
 // ========================
 // Macros
 // ========================
@@ -102,8 +105,8 @@ void xd_utils_str_destroy_func(void *data);
 int xd_utils_str_comp_func(const void *data1, const void *data2);
 
 /**
- * @brief Calculates the hash value for the passed string useing the `djb2`
- * algorithm.
+ * @brief Calculates the hash value for the passed string using
+ * `xd_utils_hash()`.
  *
  * @param data Pointer to the null-terminated string to be hashed.
  *
@@ -112,6 +115,32 @@ int xd_utils_str_comp_func(const void *data1, const void *data2);
  */
 unsigned int xd_utils_str_hash_func(void *data);
 
+/**
+ * @brief Calculates the hash value of the passed bytes using SipHash-1-3 keyed
+ * with a random per-process seed.
+ *
+ * The seed makes the hash values differ between shell processes, so inputs
+ * such as imported environment variables can't be chosen to collide.
+ *
+ * @param data Pointer to the bytes to be hashed.
+ * @param length Number of bytes to hash.
+ *
+ * @return An unsigned integer representing the hash value of the bytes.
+ */
+unsigned int xd_utils_hash(const void *data, size_t length);
+
+/**
+ * @brief Replaces the random key of `xd_utils_hash()` with the passed fixed
+ * key, for known-answer tests and reproducible hash orders.
+ *
+ * @param key0 The first (little-endian) half of the 128-bit key.
+ * @param key1 The second (little-endian) half of the 128-bit key.
+ *
+ * @warning Must be called before anything is hashed, the hash tables built
+ * with the previous key are not rehashed.
+ */
+void xd_utils_hash_set_key(uint64_t key0, uint64_t key1);
+
 /**
  * @brief Wrapper for `strdup()` with error handling, it copies the string and
  * returns a pointer to the copy.
@@ -133,4 +162,25 @@ char *xd_utils_strdup(char *str);
  */
 int xd_utils_is_bin(const char *path);
 
+/**
+ * @brief Wrapper for the `pidfd_open()` system call, it obtains a file
+ * descriptor referring to the process with the passed PID.
+ *
+ * @param pid The PID of the process.
+ *
+ * @return The pidfd (close-on-exec) on success, or `-1` on failure or if not
+ * supported by the kernel (`errno` is set).
+ *
+ * @note The returned file descriptor becomes readable when the process
+ * terminates.
+ */
+int xd_utils_pidfd_open(pid_t pid);
+
+/**
+ * @brief Returns the current time of the monotonic clock.
+ *
+ * @return The current time in nanoseconds.
+ */
+uint64_t xd_utils_now();
+
 #endif  // XD_UTILS_H
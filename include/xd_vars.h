@@ -14,9 +14,44 @@
  */
 
 #include "xd_list.h"
+#include "xd_vec.h"
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Function type for the function called before a variable is read or
+ * modified.
+ *
+ * @param name The name of the variable.
+ * @param is_write `1` if the variable is about to be set or removed, `0` if it
+ * is about to be read.
+ */
+typedef void (*xd_vars_access_func_t)(const char *name, int is_write);
+
+// ========================
+// Public Variables
+// ========================
+
+/**
+ * @brief Pointer to the function called before a variable is read or
+ * modified by name, if not set (the default) no function is called.
+ *
+ * @note The function may itself read variables, it is responsible for
+ * ignoring the nested calls.
+ */
+extern xd_vars_access_func_t xd_vars_access_hook;
+
+// ========================
+// Function Declarations
+// ========================
 
 /**
- * @brief Initializes the variables hash map and loads the environment.
+ * @brief Initializes the variables hash map and captures the environment.
+ *
+ * Environment variables aren't copied here, each one is copied into the map
+ * the first time it is read or modified.
  *
  * @warning This function may call `exit(EXIT_FAILURE)` if memory allocation
  * fails.
@@ -98,37 +133,45 @@ void xd_vars_print_all_exported();
  * @brief Constructs a null-terminated array of environment variables and
  * returns it.
  *
- * @return A newly allocated null-terminated array of string pointers containing
- * all defined environment variables.
+ * The variables the shell started with keep their order in the original
+ * environment, the other exported variables follow sorted by name.
  *
- * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_vars_destroy_envp()` and passing it the returned pointer.
+ * @return A null-terminated array of string pointers containing all defined
+ * environment variables. This is the environment the shell started with when
+ * no exported variable was modified.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note The array is kept and returned again until an exported variable
+ * changes, it must be passed to `xd_vars_destroy_envp()` once done with and
+ * its strings must not be modified.
  */
 char **xd_vars_create_envp();
 
 /**
- * @brief Frees an environment array created by `xd_vars_get_env()`.
+ * @brief Releases an environment array returned by `xd_vars_create_envp()`.
  *
  * @param envp The null-terminated array of environment variable strings to be
- * freed.
+ * released.
  *
- * @note If the passed pointer is `NULL`, no action shall occur.
+ * @note The array itself is freed once an exported variable changes, or by
+ * `xd_vars_destroy()`.
  */
 void xd_vars_destroy_envp(char **envp);
 
 /**
- * @brief Returns a list containing the names (identifiers) of all defined
+ * @brief Returns an array containing the names (identifiers) of all defined
  * variables.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing the identifiers
+ * @return Pointer to a newly allocated `xd_vec_t` containing the identifiers
  * of all defined variables or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-xd_list_t *xd_vars_names_list();
+xd_vec_t *xd_vars_names_list();
 
 /**
  * @brief Checks if the passed string is a valid variable name.
@@ -0,0 +1,183 @@
+/*
+ * ==============================================================================
+ * File: xd_vec.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_VEC_H
+#define XD_VEC_H
+
+#include "xd_generic_funcs.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Default initial capacity of `xd_vec_t` arrays, the capacity doubles
+ * whenever pushing exceeds it.
+ */
+#define XD_VEC_DEF_CAP (8)
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Represents a generic dynamic array.
+ */
+typedef struct xd_vec_t {
+  void **data;                    // Array of the elements (null-terminated)
+  int length;                     // Number of elements currently in the array
+  int capacity;                   // Number of elements the array can hold
+  xd_gens_copy_func_t copy_func;  // Function to copy data into the array
+  xd_gens_destroy_func_t destroy_func;  // Function to free data in the array
+  xd_gens_comp_func_t comp_func;  // Function to compare data in the array
+} xd_vec_t;
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Creates and initializes a new `xd_vec_t` structure.
+ *
+ * @param copy_func A pointer to the function used to copy data into the array.
+ * @param destroy_func A pointer to the function used to free data stored in the
+ * array.
+ * @param comp_func A pointer to the function used to compare two data elements
+ * in the array.
+ *
+ * @return A pointer to the newly created `xd_vec_t` on success, or `NULL` if
+ * any of the provided function pointers are `NULL`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note The caller is responsible for freeing the allocated memory by calling
+ * `xd_vec_destroy()` and passing it the returned pointer.
+ */
+xd_vec_t *xd_vec_create(xd_gens_copy_func_t copy_func,
+                        xd_gens_destroy_func_t destroy_func,
+                        xd_gens_comp_func_t comp_func);
+
+/**
+ * @brief Frees the memory allocated for the passed `xd_vec_t` structure and
+ * the elements it holds.
+ *
+ * @param vec A pointer to the `xd_vec_t` to be freed.
+ *
+ * @note If the passed pointer is `NULL` no action shall occur.
+ */
+void xd_vec_destroy(xd_vec_t *vec);
+
+/**
+ * @brief Removes all elements from the passed array, leaving it empty with the
+ * same capacity.
+ *
+ * @param vec A pointer to the `xd_vec_t` to be cleared.
+ */
+void xd_vec_clear(xd_vec_t *vec);
+
+/**
+ * @brief Appends a copy of the passed element to the end of the passed array.
+ *
+ * @param vec A pointer to the `xd_vec_t` to add the element to.
+ * @param data A pointer to the data element to be added.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note If the passed pointer is `NULL` no action shall occur.
+ */
+void xd_vec_push(xd_vec_t *vec, void *data);
+
+/**
+ * @brief Removes the last element of the passed array.
+ *
+ * @param vec A pointer to the `xd_vec_t` to remove the last element from.
+ *
+ * @return `0` on success, `-1` if the array is `NULL` or empty.
+ */
+int xd_vec_pop(xd_vec_t *vec);
+
+/**
+ * @brief Returns the element at the passed index from the passed array.
+ *
+ * @param vec A pointer to the `xd_vec_t`.
+ * @param index The index of the element to be returned.
+ *
+ * @return A pointer to the element at the passed index, or `NULL` if the passed
+ * array is `NULL` or if the index is out of bounds.
+ */
+void *xd_vec_get(const xd_vec_t *vec, int index);
+
+/**
+ * @brief Replaces the element at the passed index of the passed array with a
+ * copy of the passed element.
+ *
+ * @param vec A pointer to the `xd_vec_t`.
+ * @param index The index of the element to be replaced.
+ * @param data A pointer to the new data element.
+ *
+ * @return `0` on success, `-1` if the passed array is `NULL` or if the index
+ * is out of bounds.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+int xd_vec_set(xd_vec_t *vec, int index, void *data);
+
+/**
+ * @brief Sorts the elements of the passed array in ascending order according
+ * to its comparison function.
+ *
+ * @param vec A pointer to the `xd_vec_t` to be sorted.
+ */
+void xd_vec_sort(xd_vec_t *vec);
+
+/**
+ * @brief Removes the consecutive duplicates from the passed array, keeping the
+ * first of each run, a sorted array is left without any duplicates.
+ *
+ * @param vec A pointer to the `xd_vec_t` to remove the duplicates from.
+ *
+ * @return The number of removed elements, or `-1` if the array is `NULL`.
+ */
+int xd_vec_dedupe(xd_vec_t *vec);
+
+/**
+ * @brief Searches the passed sorted array for the passed element.
+ *
+ * @param vec A pointer to the sorted `xd_vec_t` to be searched.
+ * @param data A pointer to the data element to be searched for.
+ *
+ * @return The index of a matching element, or `-1` if not found or if the
+ * array is `NULL`.
+ */
+int xd_vec_bsearch(const xd_vec_t *vec, const void *data);
+
+/**
+ * @brief Hands off the buffer of the passed array without copying it, leaving
+ * the array empty.
+ *
+ * @param vec A pointer to the `xd_vec_t` whose buffer is released.
+ *
+ * @return The null-terminated array of elements, or `NULL` if the passed
+ * array is `NULL`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note The caller owns the returned array and its elements, and is
+ * responsible for freeing them with `free()` or the destroy function of the
+ * array.
+ */
+void **xd_vec_release(xd_vec_t *vec);
+
+#endif  // XD_VEC_H
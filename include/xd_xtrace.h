@@ -0,0 +1,61 @@
+/*
+ * ==============================================================================
+ * File: xd_xtrace.h
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#ifndef XD_XTRACE_H
+#define XD_XTRACE_H
+
+#include "xd_job.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Name of the variable holding the file descriptor the trace is written
+ * to, `stderr` is used if it's unset or invalid.
+ */
+#define XD_XTRACE_FD_VAR "XDSH_XTRACEFD"
+
+// ========================
+// Function Declarations
+// ========================
+
+/**
+ * @brief Writes the buffered trace and frees the resources of the trace.
+ */
+void xd_xtrace_destroy();
+
+/**
+ * @brief Traces the passed job about to be executed, one `+ argv...` line per
+ * command with the expanded arguments quoted for reuse.
+ *
+ * If `set -o xtracetime` is on, each line is prefixed by the monotonic time in
+ * nanoseconds and the nanoseconds elapsed since the previous trace line.
+ *
+ * @param job A pointer to the `xd_job_t` structure to be traced.
+ *
+ * @note The trace is buffered and written with a single `write()` per job when
+ * it goes to `stderr` (keeping it in order with the output of the commands),
+ * otherwise when the buffer fills up, the descriptor changes or the shell
+ * exits.
+ */
+void xd_xtrace_job(const xd_job_t *job);
+
+/**
+ * @brief Writes the buffered trace to its file descriptor.
+ */
+void xd_xtrace_flush();
+
+#endif  // XD_XTRACE_H
@@ -21,18 +21,43 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "xd_intern.h"
 #include "xd_list.h"
 #include "xd_map.h"
+#include "xd_string.h"
 #include "xd_utils.h"
 
 // ========================
 // Macros
 // ========================
 
+/**
+ * @brief Initial capacity of the tokens array of an alias.
+ */
+#define XD_ALIAS_TOKENS_MIN_CAPACITY (4)
+
+/**
+ * @brief Characters ending a word outside quotes.
+ */
+#define XD_ALIAS_WORD_DELIMITERS " \t\n<>|&"
+
 // ========================
 // Function Declarations
 // ========================
 
+static xd_alias_t *xd_alias_create(const char *value);
+static void *xd_alias_copy_func(void *data);
+static void xd_alias_destroy_func(void *data);
+static int xd_alias_comp_func(const void *data1, const void *data2);
+
+static void xd_alias_add_token(xd_alias_t *alias, int *capacity,
+                               xd_alias_token_type_t type, char *word,
+                               int end);
+static int xd_alias_scan_nested(const char *value, int pos, char closer,
+                                xd_string_t *word);
+static int xd_alias_scan_word(const char *value, int pos, xd_string_t *word);
+static void xd_alias_tokenize(xd_alias_t *alias);
+
 // ========================
 // Variables
 // ========================
@@ -46,15 +71,330 @@ static xd_map_t *xd_aliases = NULL;
 // Function Definitions
 // ========================
 
+/**
+ * @brief Creates a new alias with the passed value, held once by the caller.
+ *
+ * @param value The alias value.
+ *
+ * @return A pointer to the newly allocated alias.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ *
+ * @note The caller is responsible for calling `xd_aliases_release()` and
+ * passing it the returned pointer.
+ */
+static xd_alias_t *xd_alias_create(const char *value) {
+  xd_alias_t *alias = (xd_alias_t *)malloc(sizeof(xd_alias_t));
+  if (alias == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  alias->value = xd_utils_strdup((char *)value);
+  alias->is_tokenized = 0;
+  alias->tokens = NULL;
+  alias->token_count = 0;
+  alias->ref_count = 1;
+  alias->expanding_frame = -1;
+  xd_alias_tokenize(alias);
+  return alias;
+}  // xd_alias_create()
+
+/**
+ * @brief Holds the passed alias for the aliases map instead of copying it.
+ *
+ * @param data Pointer to the `xd_alias_t` structure.
+ *
+ * @return The passed pointer.
+ */
+static void *xd_alias_copy_func(void *data) {
+  if (data != NULL) {
+    xd_aliases_hold(data);
+  }
+  return data;
+}  // xd_alias_copy_func()
+
+/**
+ * @brief Releases the passed alias held by the aliases map.
+ *
+ * @param data Pointer to the `xd_alias_t` structure.
+ */
+static void xd_alias_destroy_func(void *data) {
+  xd_aliases_release(data);
+}  // xd_alias_destroy_func()
+
+/**
+ * @brief Compares two aliases based on their values.
+ *
+ * @param data1 Pointer to the first `xd_alias_t` structure.
+ * @param data2 Pointer to the second `xd_alias_t` structure.
+ *
+ * @return The result of comparing the values with `xd_utils_str_comp_func()`,
+ * a `NULL` alias is less than any other.
+ */
+static int xd_alias_comp_func(const void *data1, const void *data2) {
+  const xd_alias_t *alias1 = data1;
+  const xd_alias_t *alias2 = data2;
+  if (alias1 == NULL && alias2 == NULL) {
+    return 0;
+  }
+  if (alias1 == NULL) {
+    return -1;
+  }
+  if (alias2 == NULL) {
+    return 1;
+  }
+  return xd_utils_str_comp_func(alias1->value, alias2->value);
+}  // xd_alias_comp_func()
+
+/**
+ * @brief Appends a token to the tokens of the passed alias.
+ *
+ * @param alias Pointer to the alias.
+ * @param capacity Pointer to the capacity of the tokens array, updated when
+ * the array grows.
+ * @param type The type of the token.
+ * @param word The text of the word (ownership is taken), or `NULL`.
+ * @param end The offset in the alias value after the token.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static void xd_alias_add_token(xd_alias_t *alias, int *capacity,
+                               xd_alias_token_type_t type, char *word,
+                               int end) {
+  if (alias->token_count == *capacity) {
+    int new_capacity = (*capacity == 0) ? XD_ALIAS_TOKENS_MIN_CAPACITY
+                                        : 2 * (*capacity);
+    xd_alias_token_t *tokens = (xd_alias_token_t *)realloc(
+        alias->tokens, sizeof(xd_alias_token_t) * new_capacity);
+    if (tokens == NULL) {
+      fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+              strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+    alias->tokens = tokens;
+    *capacity = new_capacity;
+  }
+  xd_alias_token_t *token = &alias->tokens[alias->token_count++];
+  token->type = type;
+  token->word = word;
+  token->end = end;
+}  // xd_alias_add_token()
+
+/**
+ * @brief Appends the part of a word inside quotes, `${...}` or `$(...)` to the
+ * passed string, following the rules of the scanner.
+ *
+ * @param value The alias value.
+ * @param pos Offset in `value` after the opening character.
+ * @param closer The closing character: `'`, `"`, `}` or `)`.
+ * @param word The string to append to.
+ *
+ * @return The offset after the closing character, or `-1` if it's missing.
+ */
+static int xd_alias_scan_nested(const char *value, int pos, char closer,
+                                xd_string_t *word) {
+  while (value[pos] != '\0') {
+    char chr = value[pos];
+    if (chr == closer) {
+      xd_string_append_chr(word, chr);
+      return pos + 1;
+    }
+    if (closer == '\'') {
+      xd_string_append_chr(word, chr);
+      pos++;
+    }
+    else if (chr == '\\') {
+      if (value[pos + 1] == '\0') {
+        return -1;
+      }
+      if (value[pos + 1] != '\n') {
+        // line continuations are dropped
+        xd_string_append_chr(word, chr);
+        xd_string_append_chr(word, value[pos + 1]);
+      }
+      pos += 2;
+    }
+    else if (chr == '$' && (value[pos + 1] == '{' || value[pos + 1] == '(')) {
+      xd_string_append_chr(word, chr);
+      xd_string_append_chr(word, value[pos + 1]);
+      char nested_closer = (value[pos + 1] == '{') ? '}' : ')';
+      pos = xd_alias_scan_nested(value, pos + 2, nested_closer, word);
+      if (pos == -1) {
+        return -1;
+      }
+    }
+    else if (closer != '"' && (chr == '\'' || chr == '"')) {
+      xd_string_append_chr(word, chr);
+      pos = xd_alias_scan_nested(value, pos + 1, chr, word);
+      if (pos == -1) {
+        return -1;
+      }
+    }
+    else {
+      xd_string_append_chr(word, chr);
+      pos++;
+    }
+  }
+  return -1;
+}  // xd_alias_scan_nested()
+
+/**
+ * @brief Appends the word starting at the passed offset to the passed string,
+ * following the rules of the scanner.
+ *
+ * @param value The alias value.
+ * @param pos Offset in `value` of the first character of the word.
+ * @param word The string to append to.
+ *
+ * @return The offset after the word, or `-1` if it isn't terminated.
+ */
+static int xd_alias_scan_word(const char *value, int pos, xd_string_t *word) {
+  while (value[pos] != '\0' &&
+         strchr(XD_ALIAS_WORD_DELIMITERS, value[pos]) == NULL) {
+    char chr = value[pos];
+    if (chr == '\\') {
+      if (value[pos + 1] == '\0') {
+        return -1;
+      }
+      if (value[pos + 1] != '\n') {
+        xd_string_append_chr(word, chr);
+        xd_string_append_chr(word, value[pos + 1]);
+      }
+      pos += 2;
+    }
+    else if (chr == '\'' || chr == '"') {
+      xd_string_append_chr(word, chr);
+      pos = xd_alias_scan_nested(value, pos + 1, chr, word);
+      if (pos == -1) {
+        return -1;
+      }
+    }
+    else if (chr == '$' && (value[pos + 1] == '{' || value[pos + 1] == '(')) {
+      xd_string_append_chr(word, chr);
+      xd_string_append_chr(word, value[pos + 1]);
+      char closer = (value[pos + 1] == '{') ? '}' : ')';
+      pos = xd_alias_scan_nested(value, pos + 2, closer, word);
+      if (pos == -1) {
+        return -1;
+      }
+    }
+    else {
+      xd_string_append_chr(word, chr);
+      pos++;
+    }
+  }
+  return pos;
+}  // xd_alias_scan_word()
+
+/**
+ * @brief Splits the value of the passed alias into tokens the way the scanner
+ * would, leaving it unsplit if it ends inside a word.
+ *
+ * @param alias Pointer to the alias.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static void xd_alias_tokenize(xd_alias_t *alias) {
+  const char *value = alias->value;
+  xd_string_t *word = xd_string_create();
+  int capacity = 0;
+  int pos = 0;
+
+  while (value[pos] != '\0') {
+    char chr = value[pos];
+    char next = value[pos + 1];
+    xd_alias_token_type_t type = XD_ALIAS_TOKEN_WORD;
+    int length = 1;
+
+    if (chr == ' ' || chr == '\t') {
+      pos++;
+      continue;
+    }
+    if (chr == '#') {
+      // comment
+      while (value[pos] != '\0' && value[pos] != '\n') {
+        pos++;
+      }
+      continue;
+    }
+    if (chr == '\\' && next == '\n') {
+      // line continuation
+      pos += 2;
+      continue;
+    }
+
+    if (chr == '\n') {
+      type = XD_ALIAS_TOKEN_NEWLINE;
+    }
+    else if (chr == '<') {
+      type = XD_ALIAS_TOKEN_LT;
+    }
+    else if (chr == '>' && next == '>' && value[pos + 2] == '&') {
+      type = XD_ALIAS_TOKEN_GT_GT_AMPERSAND;
+      length = 3;
+    }
+    else if (chr == '>' && next == '>') {
+      type = XD_ALIAS_TOKEN_GT_GT;
+      length = 2;
+    }
+    else if (chr == '>' && next == '&') {
+      type = XD_ALIAS_TOKEN_GT_AMPERSAND;
+      length = 2;
+    }
+    else if (chr == '>') {
+      type = XD_ALIAS_TOKEN_GT;
+    }
+    else if (chr == '2' && next == '>' && value[pos + 2] == '>') {
+      type = XD_ALIAS_TOKEN_TWO_GT_GT;
+      length = 3;
+    }
+    else if (chr == '2' && next == '>') {
+      type = XD_ALIAS_TOKEN_TWO_GT;
+      length = 2;
+    }
+    else if (chr == '|') {
+      type = XD_ALIAS_TOKEN_PIPE;
+    }
+    else if (chr == '&') {
+      type = XD_ALIAS_TOKEN_AMPERSAND;
+    }
+
+    if (type != XD_ALIAS_TOKEN_WORD) {
+      pos += length;
+      xd_alias_add_token(alias, &capacity, type, NULL, pos);
+      continue;
+    }
+
+    pos = xd_alias_scan_word(value, pos, word);
+    if (pos == -1) {
+      // the word continues after the alias, it's scanned with what follows
+      xd_string_destroy(word);
+      for (int i = 0; i < alias->token_count; i++) {
+        free(alias->tokens[i].word);
+      }
+      free(alias->tokens);
+      alias->tokens = NULL;
+      alias->token_count = 0;
+      return;
+    }
+    xd_alias_add_token(alias, &capacity, XD_ALIAS_TOKEN_WORD,
+                       xd_string_release(word), pos);
+  }
+
+  xd_string_destroy(word);
+  alias->is_tokenized = 1;
+}  // xd_alias_tokenize()
+
 // ========================
 // Public Functions
 // ========================
 
 void xd_aliases_init() {
-  xd_aliases = xd_map_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                             xd_utils_str_comp_func, xd_utils_str_copy_func,
-                             xd_utils_str_destroy_func, xd_utils_str_comp_func,
-                             xd_utils_str_hash_func);
+  xd_aliases = xd_map_create(xd_intern_copy_func, xd_intern_destroy_func,
+                             xd_intern_comp_func, xd_alias_copy_func,
+                             xd_alias_destroy_func, xd_alias_comp_func,
+                             xd_intern_hash_func);
 }  // xd_aliases_init()
 
 void xd_aliases_destroy() {
@@ -66,31 +406,67 @@ void xd_aliases_clear() {
 }  // xd_aliases_clear()
 
 char *xd_aliases_get(char *name) {
-  return xd_map_get(xd_aliases, name);
+  // a word that was never interned can't be an alias
+  const char *symbol = xd_intern_lookup(name);
+  if (symbol == NULL) {
+    return NULL;
+  }
+  xd_alias_t *alias = xd_map_get(xd_aliases, (void *)symbol);
+  return (alias == NULL) ? NULL : alias->value;
 }  // xd_aliases_get()
 
+xd_alias_t *xd_aliases_get_alias(char *name) {
+  const char *symbol = xd_intern_lookup(name);
+  if (symbol == NULL) {
+    return NULL;
+  }
+  return xd_map_get(xd_aliases, (void *)symbol);
+}  // xd_aliases_get_alias()
+
 void xd_aliases_put(char *name, char *value) {
-  xd_map_put(xd_aliases, name, value);
+  xd_alias_t *alias = xd_alias_create(value);
+  xd_map_put(xd_aliases, (void *)xd_intern(name), alias);
+  xd_aliases_release(alias);
 }  // xd_aliases_put()
 
 int xd_aliases_remove(char *name) {
-  return xd_map_remove(xd_aliases, name);
+  const char *symbol = xd_intern_lookup(name);
+  if (symbol == NULL) {
+    return -1;
+  }
+  return xd_map_remove(xd_aliases, (void *)symbol);
 }  // xd_aliases_remove()
 
-xd_list_t *xd_aliases_names_list() {
+void xd_aliases_hold(xd_alias_t *alias) {
+  alias->ref_count++;
+}  // xd_aliases_hold()
+
+void xd_aliases_release(xd_alias_t *alias) {
+  if (alias == NULL || --alias->ref_count > 0) {
+    return;
+  }
+  for (int i = 0; i < alias->token_count; i++) {
+    free(alias->tokens[i].word);
+  }
+  free(alias->tokens);
+  free(alias->value);
+  free(alias);
+}  // xd_aliases_release()
+
+xd_vec_t *xd_aliases_names_list() {
   if (xd_aliases == NULL) {
     return NULL;
   }
 
-  xd_list_t *list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
   for (int i = 0; i < xd_aliases->bucket_count; i++) {
     xd_list_t *bucket = xd_aliases->buckets[i];
     for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
       xd_bucket_entry_t *entry = node->data;
       char *name = entry->key;
-      xd_list_add_last(list, name);
+      xd_vec_push(list, name);
     }
   }
 
@@ -101,15 +477,15 @@ void xd_aliases_print_all() {
   if (xd_aliases == NULL) {
     return;
   }
-  for (int i = 0; i < xd_aliases->bucket_count; i++) {
-    xd_list_t *bucket = xd_aliases->buckets[i];
-    for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
-      xd_bucket_entry_t *entry = node->data;
-      char *name = entry->key;
-      char *value = entry->value;
-      printf("alias %s='%s'\n", name, value);
-    }
+  // the buckets are in hash order, print the names sorted
+  xd_vec_t *names = xd_aliases_names_list();
+  xd_vec_sort(names);
+  for (int i = 0; i < names->length; i++) {
+    char *name = names->data[i];
+    xd_alias_t *alias = xd_aliases_get_alias(name);
+    printf("alias %s='%s'\n", name, alias->value);
   }
+  xd_vec_destroy(names);
 }  // xd_aliases_print()
 
 int xd_aliases_is_valid_name(const char *name) {
@@ -0,0 +1,181 @@
+/*
+ * ==============================================================================
+ * File: xd_alloc.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_alloc.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ========================
+// Function Declarations
+// ========================
+
+static void xd_alloc_failure();
+static void xd_alloc_update(xd_alloc_subsystem_t subsystem, size_t old_size,
+                            size_t new_size);
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief Counters of each subsystem.
+ */
+static xd_alloc_stats_t xd_alloc_stats[XD_ALLOC_SUBSYSTEM_COUNT];
+
+/**
+ * @brief Counters of all subsystems together, its peak is the highest total
+ * reached at once rather than the sum of the peaks.
+ */
+static xd_alloc_stats_t xd_alloc_total;
+
+/**
+ * @brief Names of the subsystems, indexed by `xd_alloc_subsystem_t`.
+ */
+static const char *const xd_alloc_names[XD_ALLOC_SUBSYSTEM_COUNT] = {
+    [XD_ALLOC_STRING] = "string",   [XD_ALLOC_LIST] = "list",
+    [XD_ALLOC_MAP] = "map",         [XD_ALLOC_COMMAND] = "command",
+    [XD_ALLOC_JOB] = "job",         [XD_ALLOC_READLINE] = "readline",
+    [XD_ALLOC_VEC] = "vec",         [XD_ALLOC_INTERN] = "intern",
+};
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Reports an allocation failure and exits.
+ */
+static void xd_alloc_failure() {
+  fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+          strerror(errno));
+  exit(EXIT_FAILURE);
+}  // xd_alloc_failure()
+
+/**
+ * @brief Updates the counters of the passed subsystem after one of its blocks
+ * changes size, `0` standing for a block that doesn't exist.
+ *
+ * @param subsystem The subsystem the block belongs to.
+ * @param old_size The usable size of the block before the change in bytes.
+ * @param new_size The usable size of the block after the change in bytes.
+ */
+static void xd_alloc_update(xd_alloc_subsystem_t subsystem, size_t old_size,
+                            size_t new_size) {
+  xd_alloc_stats_t *stats = &xd_alloc_stats[subsystem];
+#ifdef DEBUG
+  // a block of another subsystem or from plain `malloc()` breaks the counts
+  assert(old_size <= stats->current_bytes);
+#endif
+  stats->current_bytes = stats->current_bytes - old_size + new_size;
+  xd_alloc_total.current_bytes =
+      xd_alloc_total.current_bytes - old_size + new_size;
+  if (stats->current_bytes > stats->peak_bytes) {
+    stats->peak_bytes = stats->current_bytes;
+  }
+  if (xd_alloc_total.current_bytes > xd_alloc_total.peak_bytes) {
+    xd_alloc_total.peak_bytes = xd_alloc_total.current_bytes;
+  }
+}  // xd_alloc_update()
+
+// ========================
+// Public Functions
+// ========================
+
+void *xd_alloc_malloc(xd_alloc_subsystem_t subsystem, size_t size) {
+  void *ptr = malloc(size);
+  if (ptr == NULL) {
+    xd_alloc_failure();
+  }
+  xd_alloc_stats[subsystem].allocations++;
+  xd_alloc_total.allocations++;
+  xd_alloc_update(subsystem, 0, malloc_usable_size(ptr));
+  return ptr;
+}  // xd_alloc_malloc()
+
+void *xd_alloc_realloc(xd_alloc_subsystem_t subsystem, void *ptr,
+                       size_t size) {
+  if (ptr == NULL) {
+    return xd_alloc_malloc(subsystem, size);
+  }
+  size_t old_size = malloc_usable_size(ptr);
+  void *new_ptr = realloc(ptr, size);
+  if (new_ptr == NULL) {
+    xd_alloc_failure();
+  }
+  xd_alloc_update(subsystem, old_size, malloc_usable_size(new_ptr));
+  return new_ptr;
+}  // xd_alloc_realloc()
+
+char *xd_alloc_strdup(xd_alloc_subsystem_t subsystem, const char *str) {
+  size_t size = strlen(str) + 1;
+  char *dup = (char *)xd_alloc_malloc(subsystem, size);
+  memcpy(dup, str, size);
+  return dup;
+}  // xd_alloc_strdup()
+
+void xd_alloc_free(xd_alloc_subsystem_t subsystem, void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+  xd_alloc_stats[subsystem].frees++;
+  xd_alloc_total.frees++;
+  xd_alloc_update(subsystem, malloc_usable_size(ptr), 0);
+  free(ptr);
+}  // xd_alloc_free()
+
+void xd_alloc_hand_off(xd_alloc_subsystem_t subsystem, void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+  xd_alloc_stats[subsystem].frees++;
+  xd_alloc_total.frees++;
+  xd_alloc_update(subsystem, malloc_usable_size(ptr), 0);
+}  // xd_alloc_hand_off()
+
+const xd_alloc_stats_t *xd_alloc_get_stats(xd_alloc_subsystem_t subsystem) {
+  if ((int)subsystem < 0 || subsystem >= XD_ALLOC_SUBSYSTEM_COUNT) {
+    return NULL;
+  }
+  return &xd_alloc_stats[subsystem];
+}  // xd_alloc_get_stats()
+
+const xd_alloc_stats_t *xd_alloc_get_total() {
+  return &xd_alloc_total;
+}  // xd_alloc_get_total()
+
+const char *xd_alloc_get_name(xd_alloc_subsystem_t subsystem) {
+  if ((int)subsystem < 0 || subsystem >= XD_ALLOC_SUBSYSTEM_COUNT) {
+    return NULL;
+  }
+  return xd_alloc_names[subsystem];
+}  // xd_alloc_get_name()
+
+void xd_alloc_print_stats(FILE *stream) {
+  fprintf(stream, "%-10s %12s %12s %12s %12s\n", "subsystem", "current",
+          "peak", "allocs", "frees");
+  for (int i = 0; i <= XD_ALLOC_SUBSYSTEM_COUNT; i++) {
+    const xd_alloc_stats_t *stats =
+        i < XD_ALLOC_SUBSYSTEM_COUNT ? &xd_alloc_stats[i] : &xd_alloc_total;
+    fprintf(stream, "%-10s %12zu %12zu %12zu %12zu\n",
+            i < XD_ALLOC_SUBSYSTEM_COUNT ? xd_alloc_names[i] : "total",
+            stats->current_bytes, stats->peak_bytes, stats->allocations,
+            stats->frees);
+  }
+}  // xd_alloc_print_stats()
@@ -26,11 +26,11 @@
 #include <unistd.h>
 #include <wait.h>
 
-#include "xd_list.h"
 #include "xd_shell.h"
 #include "xd_string.h"
 #include "xd_utils.h"
 #include "xd_vars.h"
+#include "xd_vec.h"
 
 // ========================
 // Macros
@@ -95,12 +95,12 @@ static void xd_exec_capture_output(char *arg, const char *orig_mask,
 static char *xd_tidle_expansion(char *arg, char **orig_mask);
 static char *xd_param_expansion(char *arg, char **orig_mask);
 static char *xd_command_substitution(char *arg, char **orig_mask);
-static xd_list_t *xd_word_splitting(char *arg, char *orig_mask,
-                                    xd_list_t **orig_mask_list);
-static int xd_filename_expansion(xd_list_t **arg_list,
-                                 xd_list_t **orig_mask_list);
-static int xd_quote_removal(xd_list_t **arg_list,
-                            const xd_list_t *orig_mask_list);
+static xd_vec_t *xd_word_splitting(char *arg, char *orig_mask,
+                                   xd_vec_t **orig_mask_list);
+static int xd_filename_expansion(xd_vec_t **arg_list,
+                                 xd_vec_t **orig_mask_list);
+static int xd_quote_removal(xd_vec_t *arg_list,
+                            const xd_vec_t *orig_mask_list);
 
 // ========================
 // Variables
@@ -379,10 +379,10 @@ static void xd_exec_capture_output(char *arg, const char *orig_mask,
     yyparse_cleanup();
     yyparse_initialize();
 
-    // setup scanner input to be the command string
+    // setup scanner input to be the command string, which points into `arg`
+    // and is scanned without being copied
     xd_sh_is_interactive = 0;
     yylex_scan_string(cmd_str);
-    free(arg);
 
     yyparse();
 
@@ -521,11 +521,12 @@ static char *xd_tidle_expansion(char *arg, char **orig_mask) {
   int expanded_prefix_len = (int)strlen(expanded_prefix);
 
   xd_string_t *str = xd_string_create();
-  xd_string_append_str(str, expanded_prefix);
-  xd_string_append_str(str, suffix);
-  char *expanded_arg = xd_utils_strdup(str->str);
+  xd_string_reserve(str, expanded_prefix_len + suffix_len + 1);
+  xd_string_append_n(str, expanded_prefix, expanded_prefix_len);
+  xd_string_append_n(str, suffix, suffix_len);
+  char *expanded_arg = xd_string_release(str);
 
-  xd_string_clear(str);
+  xd_string_reserve(str, expanded_prefix_len + suffix_len + 1);
   for (int i = 0; i < expanded_prefix_len; i++) {
     xd_string_append_chr(str, '0');
   }
@@ -534,7 +535,7 @@ static char *xd_tidle_expansion(char *arg, char **orig_mask) {
   }
 
   free(*orig_mask);
-  *orig_mask = xd_utils_strdup(str->str);
+  *orig_mask = xd_string_release(str);
   xd_string_destroy(str);
 
   return expanded_arg;
@@ -694,11 +695,11 @@ static char *xd_param_expansion(char *arg, char **orig_mask) {
     xd_ss_stack_update(arg, *orig_mask, idx);
   }
 
-  char *expanded_arg = xd_utils_strdup(exp_arg_str->str);
+  char *expanded_arg = xd_string_release(exp_arg_str);
   xd_string_destroy(exp_arg_str);
 
   free(*orig_mask);
-  *orig_mask = xd_utils_strdup(orig_mask_str->str);
+  *orig_mask = xd_string_release(orig_mask_str);
   xd_string_destroy(orig_mask_str);
 
   return expanded_arg;
@@ -776,11 +777,11 @@ static char *xd_command_substitution(char *arg, char **orig_mask) {
     xd_ss_stack_update(arg, *orig_mask, idx);
   }
 
-  char *expanded_arg = xd_utils_strdup(exp_arg_str->str);
+  char *expanded_arg = xd_string_release(exp_arg_str);
   xd_string_destroy(exp_arg_str);
 
   free(*orig_mask);
-  *orig_mask = xd_utils_strdup(orig_mask_str->str);
+  *orig_mask = xd_string_release(orig_mask_str);
   xd_string_destroy(orig_mask_str);
 
   return expanded_arg;
@@ -794,28 +795,28 @@ static char *xd_command_substitution(char *arg, char **orig_mask) {
  * the argument's originality mask, which indicates which characters are from
  * the original argument and which are a result of expansion.
  * @param orig_mask_list Output parameter, pointer to a newly allocated
- * `xd_list_t` containing the splitted originality mask.
+ * `xd_vec_t` containing the splitted originality mask.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing the splitted
+ * @return Pointer to a newly allocated `xd_vec_t` containing the splitted
  * argument or `NULL` on failure or if the passed pointer is `NULL`.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` on both the returned lists.
+ * `xd_vec_destroy()` on both the returned arrays.
  */
-static xd_list_t *xd_word_splitting(char *arg, char *orig_mask,
-                                    xd_list_t **orig_mask_list) {
+static xd_vec_t *xd_word_splitting(char *arg, char *orig_mask,
+                                   xd_vec_t **orig_mask_list) {
   if (arg == NULL) {
     return NULL;
   }
 
-  xd_list_t *arg_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
-  xd_list_t *mask_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *arg_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
+  xd_vec_t *mask_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   int start_idx = 0;
   int end_idx = 0;
@@ -836,8 +837,8 @@ static xd_list_t *xd_word_splitting(char *arg, char *orig_mask,
       orig_mask[end_idx] = '\0';
 
       if (strchr(XD_IFS, arg[start_idx]) == NULL) {
-        xd_list_add_last(arg_list, arg + start_idx);
-        xd_list_add_last(mask_list, orig_mask + start_idx);
+        xd_vec_push(arg_list, arg + start_idx);
+        xd_vec_push(mask_list, orig_mask + start_idx);
       }
 
       // restore
@@ -858,8 +859,8 @@ static xd_list_t *xd_word_splitting(char *arg, char *orig_mask,
   }
 
   if (start_idx != end_idx && strchr(XD_IFS, arg[start_idx]) == NULL) {
-    xd_list_add_last(arg_list, arg + start_idx);
-    xd_list_add_last(mask_list, orig_mask + start_idx);
+    xd_vec_push(arg_list, arg + start_idx);
+    xd_vec_push(mask_list, orig_mask + start_idx);
   }
 
   *orig_mask_list = mask_list;
@@ -869,10 +870,10 @@ static xd_list_t *xd_word_splitting(char *arg, char *orig_mask,
 /**
  * @brief Performs filename expansion (globbing) on the passed arguments.
  *
- * @param arg_list Pointer to a pointer to the `xd_list_t` structure containing
+ * @param arg_list Pointer to a pointer to the `xd_vec_t` structure containing
  * the arguments resulting from word splitting, it will be updated when this
  * function is called to store the result of expansions.
- * @param orig_mask_list Pointer to a pointer to the `xd_list_t` structure
+ * @param orig_mask_list Pointer to a pointer to the `xd_vec_t` structure
  * containing the argument masks resulting from word splitting, it will be
  * updated when this function is called to store masks after after filename
  * expansion.
@@ -881,27 +882,25 @@ static xd_list_t *xd_word_splitting(char *arg, char *orig_mask,
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  */
-static int xd_filename_expansion(xd_list_t **arg_list,
-                                 xd_list_t **orig_mask_list) {
+static int xd_filename_expansion(xd_vec_t **arg_list,
+                                 xd_vec_t **orig_mask_list) {
   if (*arg_list == NULL) {
     return -1;
   }
 
-  xd_list_t *new_arg_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
-  xd_list_t *new_mask_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *new_arg_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
+  xd_vec_t *new_mask_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   xd_string_t *mask_str = xd_string_create();
   glob_t glob_result;
 
-  xd_list_node_t *arg_node = (*arg_list)->head;
-  xd_list_node_t *mask_node = (*orig_mask_list)->head;
   for (int i = 0; i < (*arg_list)->length; i++) {
-    int glob_ret =
-        glob(arg_node->data, GLOB_BRACE | GLOB_NOSORT, NULL, &glob_result);
+    int glob_ret = glob((*arg_list)->data[i], GLOB_BRACE | GLOB_NOSORT, NULL,
+                        &glob_result);
 
     if (glob_ret == 0) {
       // sort then add matches
@@ -914,31 +913,29 @@ static int xd_filename_expansion(xd_list_t **arg_list,
         for (int k = 0; path[k] != '\0'; k++) {
           xd_string_append_chr(mask_str, '0');
         }
-        xd_list_add_last(new_arg_list, path);
-        xd_list_add_last(new_mask_list, mask_str->str);
+        xd_vec_push(new_arg_list, path);
+        xd_vec_push(new_mask_list, mask_str->str);
       }
     }
     else if (glob_ret == GLOB_NOMATCH) {
       // no match leave as is
-      xd_list_add_last(new_arg_list, arg_node->data);
-      xd_list_add_last(new_mask_list, mask_node->data);
+      xd_vec_push(new_arg_list, (*arg_list)->data[i]);
+      xd_vec_push(new_mask_list, (*orig_mask_list)->data[i]);
     }
     else {
       // error
-      xd_list_destroy(new_arg_list);
-      xd_list_destroy(new_mask_list);
+      xd_vec_destroy(new_arg_list);
+      xd_vec_destroy(new_mask_list);
       xd_string_destroy(mask_str);
       return -1;
     }
 
     globfree(&glob_result);
-    arg_node = arg_node->next;
-    mask_node = mask_node->next;
   }
 
   xd_string_destroy(mask_str);
-  xd_list_destroy(*arg_list);
-  xd_list_destroy(*orig_mask_list);
+  xd_vec_destroy(*arg_list);
+  xd_vec_destroy(*orig_mask_list);
 
   *arg_list = new_arg_list;
   *orig_mask_list = new_mask_list;
@@ -950,33 +947,27 @@ static int xd_filename_expansion(xd_list_t **arg_list,
  * @brief Performs quote removal and escape character handling on the passed
  * arguments.
  *
- * @param arg_list Pointer to a pointer to the `xd_list_t` structure containing
- * the arguments resulting from word splitting, it will be updated when this
- * function is called to store the result.
- * @param orig_mask_list Pointer to a pointer to the `xd_list_t` structure
- * containing the argument masks resulting from word splitting.
+ * @param arg_list Pointer to the `xd_vec_t` structure containing the arguments
+ * resulting from word splitting, its elements are replaced in place with the
+ * result.
+ * @param orig_mask_list Pointer to the `xd_vec_t` structure containing the
+ * argument masks resulting from word splitting.
  *
  * @return `0` on success or `-1` on failure or if the passed pointer is `NULL`.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  */
-static int xd_quote_removal(xd_list_t **arg_list,
-                            const xd_list_t *orig_mask_list) {
+static int xd_quote_removal(xd_vec_t *arg_list,
+                            const xd_vec_t *orig_mask_list) {
   if (arg_list == NULL || orig_mask_list == NULL) {
     return -1;
   }
 
-  xd_list_t *new_arg_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
-
-  xd_list_node_t *arg_node = (*arg_list)->head;
-  xd_list_node_t *mask_node = orig_mask_list->head;
   xd_string_t *exp_arg_str = xd_string_create();
 
-  for (int i = 0; i < (*arg_list)->length; i++) {
-    char *arg = arg_node->data;
-    char *orig_mask = mask_node->data;
+  for (int i = 0; i < arg_list->length; i++) {
+    char *arg = arg_list->data[i];
+    char *orig_mask = orig_mask_list->data[i];
 
     xd_string_clear(exp_arg_str);
 
@@ -1013,14 +1004,10 @@ static int xd_quote_removal(xd_list_t **arg_list,
       xd_ss_stack_update(arg, orig_mask, idx);
     }
 
-    xd_list_add_last(new_arg_list, exp_arg_str->str);
-    arg_node = arg_node->next;
-    mask_node = mask_node->next;
+    xd_vec_set(arg_list, i, exp_arg_str->str);
   }
 
   xd_string_destroy(exp_arg_str);
-  xd_list_destroy(*arg_list);
-  *arg_list = new_arg_list;
   return 0;
 }  // xd_quote_removal()
 
@@ -1044,7 +1031,7 @@ void xd_arg_expander_destroy() {
   free(xd_ss_stack);
 }  // xd_arg_expander_destroy()
 
-xd_list_t *xd_arg_expander(char *arg) {
+xd_vec_t *xd_arg_expander(char *arg) {
   xd_original_arg = arg;
   arg = xd_utils_strdup(arg);
 
@@ -1080,8 +1067,8 @@ xd_list_t *xd_arg_expander(char *arg) {
   arg = expanded_arg;
 
   // 4. Word splitting
-  xd_list_t *orig_mask_list = NULL;
-  xd_list_t *exp_arg_list = xd_word_splitting(arg, orig_mask, &orig_mask_list);
+  xd_vec_t *orig_mask_list = NULL;
+  xd_vec_t *exp_arg_list = xd_word_splitting(arg, orig_mask, &orig_mask_list);
   free(arg);
   free(orig_mask);
   if (exp_arg_list == NULL) {
@@ -1091,21 +1078,21 @@ xd_list_t *xd_arg_expander(char *arg) {
 
   // 5. Filename expansion
   if (xd_filename_expansion(&exp_arg_list, &orig_mask_list) == -1) {
-    xd_list_destroy(exp_arg_list);
-    xd_list_destroy(orig_mask_list);
+    xd_vec_destroy(exp_arg_list);
+    xd_vec_destroy(orig_mask_list);
     fprintf(stderr, "xd-shell: %s: filename expansion error\n",
             xd_original_arg);
     return NULL;
   }
 
   // 6. Quote removal and escape character handling
-  if (xd_quote_removal(&exp_arg_list, orig_mask_list) == -1) {
-    xd_list_destroy(exp_arg_list);
-    xd_list_destroy(orig_mask_list);
+  if (xd_quote_removal(exp_arg_list, orig_mask_list) == -1) {
+    xd_vec_destroy(exp_arg_list);
+    xd_vec_destroy(orig_mask_list);
     fprintf(stderr, "xd-shell: %s: quote removal error\n", xd_original_arg);
     return NULL;
   }
 
-  xd_list_destroy(orig_mask_list);
+  xd_vec_destroy(orig_mask_list);
   return exp_arg_list;
 }  // xd_arg_expander()
@@ -17,19 +17,27 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <pwd.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "xd_aliases.h"
+#include "xd_alloc.h"
+#include "xd_intern.h"
+#include "xd_job_executor.h"
 #include "xd_jobs.h"
+#include "xd_prompt.h"
 #include "xd_readline.h"
 #include "xd_shell.h"
 #include "xd_signals.h"
+#include "xd_snapshot.h"
+#include "xd_string.h"
 #include "xd_utils.h"
 #include "xd_vars.h"
 
@@ -42,6 +50,23 @@
  */
 #define XD_EXIT_CODE_MASK (0xff)
 
+/**
+ * @brief Highest exit code of the `parallel` builtin, it's the number of failed
+ * jobs capped to this value.
+ */
+#define XD_PARALLEL_EXIT_CODE_MAX (101)
+
+/**
+ * @brief Template of the temporary files buffering the output of the jobs of
+ * the `parallel` builtin when the output is kept in input order.
+ */
+#define XD_PARALLEL_TMP_TEMPLATE "/xd-shell-parallel-XXXXXX"
+
+/**
+ * @brief Directory of the temporary files when `TMPDIR` isn't defined.
+ */
+#define XD_PARALLEL_DEF_TMPDIR "/tmp"
+
 // ========================
 // Typedefs
 // ========================
@@ -59,12 +84,32 @@ typedef struct xd_builtin_mapping_t {
   xd_builtin_func_t func;  // Executor function of the builtin
 } xd_builtin_mapping_t;
 
+/**
+ * @brief Represents a shell option that can be turned on and off with the
+ * `set` builtin.
+ */
+typedef struct xd_set_option_t {
+  char letter;       // Single letter of the option (`set -<letter>`)
+  const char *name;  // Long name of the option (`set -o <name>`)
+  int *flag;         // Flag holding the option's state
+} xd_set_option_t;
+
+/**
+ * @brief Represents a work item of the `parallel` builtin.
+ */
+typedef struct xd_parallel_task_t {
+  char *item;         // The work item
+  xd_job_t *job;      // The job processing the item, `NULL` if not running
+  char *output_file;  // File buffering the job's output, or `NULL`
+  int is_done;        // Whether the job finished
+} xd_parallel_task_t;
+
 // ========================
 // Function Declarations
 // ========================
 
 // flex function
-extern void yylex_scan_file(FILE *file);
+extern int yylex_scan_file(FILE *file, const char *name);
 
 static void xd_jobs_usage();
 static void xd_jobs_help();
@@ -82,6 +127,23 @@ static void xd_bg_usage();
 static void xd_bg_help();
 static int xd_bg(int argc, char **argv);
 
+static void xd_wait_usage();
+static void xd_wait_help();
+static int xd_wait(int argc, char **argv);
+static int xd_wait_parse_operand(const char *operand, int is_parent,
+                                 xd_job_t **job, xd_command_t **command,
+                                 int *saved_status);
+
+static void xd_parallel_usage();
+static void xd_parallel_help();
+static int xd_parallel(int argc, char **argv);
+static xd_parallel_task_t *xd_parallel_read_tasks(int argc, char **argv,
+                                                  int *task_count);
+static xd_job_t *xd_parallel_create_job(char **template, int template_count,
+                                        const xd_parallel_task_t *task);
+static char *xd_parallel_create_output_file();
+static void xd_parallel_print_output(xd_parallel_task_t *task);
+
 static void xd_alias_usage();
 static void xd_alias_help();
 static int xd_alias(int argc, char **argv);
@@ -93,6 +155,9 @@ static int xd_unalias(int argc, char **argv);
 static void xd_set_usage();
 static void xd_set_help();
 static int xd_set(int argc, char **argv);
+static const xd_set_option_t *xd_set_option_find(char letter,
+                                                 const char *name);
+static void xd_set_options_print();
 
 static void xd_unset_usage();
 static void xd_unset_help();
@@ -127,6 +192,10 @@ static void xd_source_usage();
 static void xd_source_help();
 static int xd_source(int argc, char **argv);
 
+static void xd_memstats_usage();
+static void xd_memstats_help();
+static int xd_memstats(int argc, char **argv);
+
 static void xd_exit_usage();
 static void xd_exit_help();
 static int xd_exit(int argc, char **argv);
@@ -135,6 +204,8 @@ static void xd_logout_usage();
 static void xd_logout_help();
 static int xd_logout(int argc, char **argv);
 
+static int xd_builtins_find(const char *str);
+
 // ========================
 // Variables
 // ========================
@@ -147,6 +218,8 @@ static const xd_builtin_mapping_t xd_builtins[] = {
     {"kill",     xd_kill    },
     {"fg",       xd_fg      },
     {"bg",       xd_bg      },
+    {"wait",     xd_wait    },
+    {"parallel", xd_parallel},
     {"alias",    xd_alias   },
     {"unalias",  xd_unalias },
     {"set",      xd_set     },
@@ -158,6 +231,7 @@ static const xd_builtin_mapping_t xd_builtins[] = {
     {"echo",     xd_echo    },
     {"history",  xd_history },
     {"source",   xd_source  },
+    {"memstats", xd_memstats},
     {"exit",     xd_exit    },
     {"logout",   xd_logout  },
 };
@@ -168,6 +242,29 @@ static const xd_builtin_mapping_t xd_builtins[] = {
 static const int xd_builtins_count =
     sizeof(xd_builtins) / sizeof(xd_builtins[0]);
 
+/**
+ * @brief Interned names of the builtins, in the same order as `xd_builtins`,
+ * filled on the first lookup.
+ */
+static const char *xd_builtins_symbols[sizeof(xd_builtins) /
+                                       sizeof(xd_builtins[0])];
+
+/**
+ * @brief Array of the shell options handled by the `set` builtin.
+ */
+static const xd_set_option_t xd_set_options[] = {
+    {'b',  "notify",     &xd_sh_notify     },
+    {'\0', "profile",    &xd_sh_profile    },
+    {'x',  "xtrace",     &xd_sh_xtrace     },
+    {'\0', "xtracetime", &xd_sh_xtrace_time},
+};
+
+/**
+ * @brief Number of shell options handled by the `set` builtin.
+ */
+static const int xd_set_options_count =
+    sizeof(xd_set_options) / sizeof(xd_set_options[0]);
+
 // ========================
 // Public Variables
 // ========================
@@ -180,7 +277,7 @@ static const int xd_builtins_count =
  * @brief Prints usage information for the `jobs` builtin.
  */
 static void xd_jobs_usage() {
-  fprintf(stderr, "jobs: usage: jobs [-lp]\n");
+  fprintf(stderr, "jobs: usage: jobs [-lpv]\n");
 }  // xd_jobs_usage()
 
 /**
@@ -188,12 +285,14 @@ static void xd_jobs_usage() {
  */
 static void xd_jobs_help() {
   printf(
-      "jobs: jobs [-lp]\n"
+      "jobs: jobs [-lpv]\n"
       "    Display status of all jobs.\n"
       "\n"
       "    Options:\n"
       "      -l    show detailed status of each process in the job\n"
       "      -p    show process ID(s)\n"
+      "      -v    show elapsed time, CPU time and peak memory of each\n"
+      "            process in the job\n"
       "\n"
       "    Exit Status:\n"
       "    Returns success unless invalid option is given or error occurs.\n");
@@ -212,9 +311,10 @@ static int xd_jobs(int argc, char **argv) {
 
   int detailed = 0;
   int print_pids = 0;
+  int verbose = 0;
 
   int opt;
-  while ((opt = getopt(argc, argv, "+lp")) != -1) {
+  while ((opt = getopt(argc, argv, "+lpv")) != -1) {
     switch (opt) {
       case 'l':
         detailed = 1;
@@ -222,6 +322,9 @@ static int xd_jobs(int argc, char **argv) {
       case 'p':
         print_pids = 1;
         break;
+      case 'v':
+        verbose = 1;
+        break;
       case '?':
       default:
         fprintf(stderr, "xd-shell: jobs: -%c: invalid option\n",
@@ -237,7 +340,7 @@ static int xd_jobs(int argc, char **argv) {
     return XD_SH_EXIT_CODE_USAGE;
   }
 
-  xd_jobs_print_status_all(detailed, print_pids);
+  xd_jobs_print_status_all(detailed, print_pids, verbose);
   return EXIT_SUCCESS;
 }  // xd_jobs()
 
@@ -346,7 +449,13 @@ static int xd_kill(int argc, char **argv) {
 
   // parse pids and jobspecs
 
-  xd_job_t *killed_jobs[operand_count];
+  xd_job_t **killed_jobs =
+      (xd_job_t **)malloc(sizeof(xd_job_t *) * operand_count);
+  if (killed_jobs == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
 
   int success_count = 0;
   for (int i = 0; i < operand_count; i++) {
@@ -408,6 +517,7 @@ static int xd_kill(int argc, char **argv) {
     }
     xd_jobs_wait_non_blocking(job);
   }
+  free(killed_jobs);
 
   return success_count == operand_count ? EXIT_SUCCESS : EXIT_FAILURE;
 }  // xd_kill()
@@ -666,6 +776,695 @@ static int xd_bg(int argc, char **argv) {
   return success_count == argc - 1 ? EXIT_SUCCESS : EXIT_FAILURE;
 }  // xd_bg()
 
+/**
+ * @brief Prints usage information for the `wait` builtin.
+ */
+static void xd_wait_usage() {
+  fprintf(stderr, "wait: usage: wait [-n] [-t timeout] [id ...]\n");
+}  // xd_wait_usage()
+
+/**
+ * @brief Prints detailed help information for the `wait` builtin.
+ */
+static void xd_wait_help() {
+  printf(
+      "wait: wait [-n] [-t timeout] [id ...]\n"
+      "    Wait for job completion and return exit status.\n"
+      "\n"
+      "    Waits for each process identified by an id, which may be a process\n"
+      "    ID or a job specification, and reports its termination status. If\n"
+      "    id is not given, waits for all currently active child processes.\n"
+      "    A job that is stopped stops the wait as well.\n"
+      "\n"
+      "    Options:\n"
+      "      -n            wait for a single job from the list of ids, or if\n"
+      "                    no ids are supplied, for the next job to complete\n"
+      "      -t timeout    give up after timeout seconds (may be fractional)\n"
+      "\n"
+      "    Exit Status:\n"
+      "    Returns the status of the last id, 124 if the timeout expires, 130\n"
+      "    if interrupted, or 127 if id is invalid or not a child of the\n"
+      "    shell.\n");
+}  // xd_wait_help()
+
+/**
+ * @brief Executor of `wait` builtin command.
+ */
+static int xd_wait(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--help") == 0) {
+      xd_wait_help();
+      return EXIT_SUCCESS;
+    }
+  }
+
+  int wait_next = 0;
+  int timeout_ms = -1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "+:nt:")) != -1) {
+    switch (opt) {
+      case 'n':
+        wait_next = 1;
+        break;
+      case 't': {
+        char *end = NULL;
+        errno = 0;
+        double seconds = strtod(optarg, &end);
+        if (errno != 0 || end == optarg || *end != '\0' || seconds < 0 ||
+            seconds > INT_MAX / 1000) {
+          fprintf(stderr, "xd-shell: wait: %s: invalid timeout\n", optarg);
+          xd_wait_usage();
+          return XD_SH_EXIT_CODE_USAGE;
+        }
+        timeout_ms = (int)(seconds * 1000);
+        break;
+      }
+      case ':':
+        fprintf(stderr, "xd-shell: wait: -%c: option requires an argument\n",
+                optopt);
+        xd_wait_usage();
+        return XD_SH_EXIT_CODE_USAGE;
+      case '?':
+      default:
+        fprintf(stderr, "xd-shell: wait: -%c: invalid option\n",
+                optopt != 0 ? optopt : '?');
+        xd_wait_usage();
+        return XD_SH_EXIT_CODE_USAGE;
+    }
+  }
+
+  // a forked child (e.g. pipeline member) doesn't own the jobs in the table
+  int is_parent = (getpid() == xd_sh_pid);
+
+  // collect the jobs (or processes) to wait for
+  int operand_count = argc - optind;
+  int capacity = operand_count > 0 ? operand_count : xd_jobs_get_count();
+  xd_job_t **jobs = (xd_job_t **)malloc(sizeof(xd_job_t *) * (capacity + 1));
+  xd_command_t **commands =
+      (xd_command_t **)malloc(sizeof(xd_command_t *) * (capacity + 1));
+  if (jobs == NULL || commands == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  int count = 0;
+  int exit_code = EXIT_SUCCESS;
+  int finished_exit_code = -1;  // exit code of the last finished operand
+  int last_operand_finished = 0;
+
+  if (operand_count == 0) {
+    count = is_parent ? xd_jobs_get_all(jobs) : 0;
+    for (int i = 0; i < count; i++) {
+      commands[i] = NULL;
+    }
+  }
+  for (int i = optind; i < argc; i++) {
+    int saved_status = -1;
+    exit_code = xd_wait_parse_operand(argv[i], is_parent, &jobs[count],
+                                      &commands[count], &saved_status);
+    last_operand_finished = 0;
+    if (exit_code != EXIT_SUCCESS) {
+      continue;
+    }
+    if (saved_status != -1) {
+      // finished and removed from the jobs table before `wait` was called
+      finished_exit_code = xd_jobs_exit_code(saved_status);
+      last_operand_finished = 1;
+      continue;
+    }
+    count++;
+  }
+  int last_operand_valid = (exit_code == EXIT_SUCCESS);
+
+  int result = -1;
+  if (wait_next && finished_exit_code != -1) {
+    result = finished_exit_code;
+  }
+  else if (wait_next && count == 0) {
+    result = XD_SH_EXIT_CODE_NOT_FOUND;
+  }
+
+  long long deadline =
+      timeout_ms >= 0 ? (long long)(xd_utils_now() / 1000000) + timeout_ms
+                      : -1;
+  int last_exit_code = EXIT_SUCCESS;
+  int remaining = result == -1 ? count : 0;
+  while (remaining > 0) {
+    int remaining_ms = -1;
+    if (deadline != -1) {
+      long long now = (long long)(xd_utils_now() / 1000000);
+      remaining_ms = now < deadline ? (int)(deadline - now) : 0;
+    }
+
+    int idx = xd_jobs_wait_any(jobs, commands, remaining, remaining_ms);
+    if (idx == -1) {
+      if (errno == ETIMEDOUT) {
+        result = XD_SH_EXIT_CODE_TIMEOUT;
+      }
+      else if (errno == EINTR) {
+        result = XD_SH_EXIT_CODE_SIGINTR;
+      }
+      else {
+        fprintf(stderr, "xd-shell: wait: %s\n", strerror(errno));
+        result = EXIT_FAILURE;
+      }
+      break;
+    }
+
+    xd_job_t *job = jobs[idx];
+    xd_command_t *command = commands[idx];
+    int wait_status = (command != NULL && !xd_job_is_stopped(job))
+                          ? command->wait_status
+                          : job->wait_status;
+    int job_exit_code = xd_jobs_exit_code(wait_status);
+    if (!xd_job_is_alive(job)) {
+      job->notify = 0;  // the status is reported by `wait` itself
+      job->is_waited = 1;
+    }
+
+    if (wait_next) {
+      result = job_exit_code;
+      break;
+    }
+    if (idx == remaining - 1) {
+      last_exit_code = job_exit_code;  // the last id is waited last
+    }
+
+    // drop the waited entry, keeping the order of the remaining ones
+    remaining--;
+    for (int i = idx; i < remaining; i++) {
+      jobs[i] = jobs[i + 1];
+      commands[i] = commands[i + 1];
+    }
+  }
+  free(jobs);
+  free(commands);
+
+  if (result != -1) {
+    return result;
+  }
+  if (operand_count == 0) {
+    return EXIT_SUCCESS;
+  }
+  if (!last_operand_valid) {
+    return exit_code;
+  }
+  return last_operand_finished ? finished_exit_code : last_exit_code;
+}  // xd_wait()
+
+/**
+ * @brief Resolves the passed operand of the `wait` builtin to the job or the
+ * process to wait for, printing an error message on failure.
+ *
+ * @param operand The operand, a job specification or a process ID.
+ * @param is_parent Whether the jobs in the table are children of this process.
+ * @param job Output pointer for the job to wait for.
+ * @param command Output pointer for the command whose process to wait for, or
+ * `NULL` to wait for the whole job.
+ * @param saved_status Output pointer for the saved wait status of the operand
+ * if it already finished and was removed from the jobs table (`*job` is then
+ * `NULL`), or `-1` otherwise.
+ *
+ * @return `0` on success, or the exit code of `wait` for the operand on
+ * failure.
+ */
+static int xd_wait_parse_operand(const char *operand, int is_parent,
+                                 xd_job_t **job, xd_command_t **command,
+                                 int *saved_status) {
+  *job = NULL;
+  *command = NULL;
+  *saved_status = -1;
+
+  if (*operand == '%') {
+    if (strcmp(operand, "%%") == 0 || strcmp(operand, "%+") == 0) {
+      *job = xd_jobs_get_current();
+    }
+    else if (strcmp(operand, "%-") == 0) {
+      *job = xd_jobs_get_previous();
+    }
+    else {
+      long job_id = -1;
+      xd_utils_strtol(operand + 1, &job_id);
+      *job = xd_jobs_get_with_id((int)job_id);
+      if (*job == NULL && is_parent &&
+          xd_jobs_collect_job_status((int)job_id, saved_status) == 0) {
+        return EXIT_SUCCESS;
+      }
+    }
+
+    if (*job == NULL || !is_parent) {
+      fprintf(stderr, "xd-shell: wait: %s: no such job\n", operand);
+      return XD_SH_EXIT_CODE_NOT_FOUND;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  long pid = -1;
+  if (xd_utils_strtol(operand, &pid) == -1 || pid <= 0) {
+    fprintf(stderr, "xd-shell: wait: %s: not a pid or valid job spec\n",
+            operand);
+    return XD_SH_EXIT_CODE_NOT_FOUND;
+  }
+  if (is_parent) {
+    *command = xd_jobs_get_command_with_pid((pid_t)pid, job);
+    if (*command == NULL &&
+        xd_jobs_collect_pid_status((pid_t)pid, saved_status) == 0) {
+      return EXIT_SUCCESS;
+    }
+  }
+  if (*command == NULL) {
+    fprintf(stderr, "xd-shell: wait: pid %ld is not a child of this shell\n",
+            pid);
+    return XD_SH_EXIT_CODE_NOT_FOUND;
+  }
+  return EXIT_SUCCESS;
+}  // xd_wait_parse_operand()
+
+/**
+ * @brief Prints usage information for the `parallel` builtin.
+ */
+static void xd_parallel_usage() {
+  fprintf(stderr,
+          "parallel: usage: parallel [-ks] [-j jobs] command [arg ...] "
+          "[::: item ...]\n");
+}  // xd_parallel_usage()
+
+/**
+ * @brief Prints detailed help information for the `parallel` builtin.
+ */
+static void xd_parallel_help() {
+  printf(
+      "parallel: parallel [-ks] [-j jobs] command [arg ...] [::: item ...]\n"
+      "    Run a command for each item with bounded concurrency.\n"
+      "\n"
+      "    Runs command once for each item, with at most jobs instances\n"
+      "    running at the same time. The items are the arguments following\n"
+      "    `:::`, or the lines read from standard input if `:::` is not\n"
+      "    given. Each `{}` in the command and its arguments is replaced by\n"
+      "    the item, if none is present the item is appended as the last\n"
+      "    argument.\n"
+      "\n"
+      "    Options:\n"
+      "      -j jobs    run at most jobs commands at once, defaults to the\n"
+      "                 number of online CPUs\n"
+      "      -k         keep the output in the order of the items, the output\n"
+      "                 of each command is buffered until it's printed\n"
+      "      -s         print statistics to standard error when done\n"
+      "\n"
+      "    Exit Status:\n"
+      "    Returns the number of commands that failed (at most 101), 130 if\n"
+      "    interrupted, or 2 if invalid option is given.\n");
+}  // xd_parallel_help()
+
+/**
+ * @brief Executor of `parallel` builtin command.
+ */
+static int xd_parallel(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--help") == 0) {
+      xd_parallel_help();
+      return EXIT_SUCCESS;
+    }
+    if (strcmp(argv[i], ":::") == 0) {
+      break;
+    }
+  }
+
+  long max_jobs = sysconf(_SC_NPROCESSORS_ONLN);
+  int keep_order = 0;
+  int print_stats = 0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "+:j:ks")) != -1) {
+    switch (opt) {
+      case 'j':
+        if (xd_utils_strtol(optarg, &max_jobs) == -1 || max_jobs < 1 ||
+            max_jobs > INT_MAX) {
+          fprintf(stderr, "xd-shell: parallel: %s: invalid number of jobs\n",
+                  optarg);
+          xd_parallel_usage();
+          return XD_SH_EXIT_CODE_USAGE;
+        }
+        break;
+      case 'k':
+        keep_order = 1;
+        break;
+      case 's':
+        print_stats = 1;
+        break;
+      case ':':
+        fprintf(stderr,
+                "xd-shell: parallel: -%c: option requires an argument\n",
+                optopt);
+        xd_parallel_usage();
+        return XD_SH_EXIT_CODE_USAGE;
+      case '?':
+      default:
+        fprintf(stderr, "xd-shell: parallel: -%c: invalid option\n",
+                optopt != 0 ? optopt : '?');
+        xd_parallel_usage();
+        return XD_SH_EXIT_CODE_USAGE;
+    }
+  }
+  if (max_jobs < 1) {
+    max_jobs = 1;
+  }
+
+  // the command template ends at `:::`
+  char **template = argv + optind;
+  int template_count = 0;
+  while (optind + template_count < argc &&
+         strcmp(template[template_count], ":::") != 0) {
+    template_count++;
+  }
+  if (template_count == 0) {
+    fprintf(stderr, "xd-shell: parallel: missing command\n");
+    xd_parallel_usage();
+    return XD_SH_EXIT_CODE_USAGE;
+  }
+
+  int task_count = 0;
+  xd_parallel_task_t *tasks = xd_parallel_read_tasks(
+      argc - optind - template_count, template + template_count, &task_count);
+
+  struct timespec time_spec;
+  clock_gettime(CLOCK_MONOTONIC, &time_spec);
+  double start_time = (double)time_spec.tv_sec + (time_spec.tv_nsec / 1e9);
+
+  fflush(stdout);
+
+  if (max_jobs > task_count) {
+    max_jobs = task_count > 0 ? task_count : 1;
+  }
+  xd_job_t **running_jobs = (xd_job_t **)malloc(sizeof(xd_job_t *) * max_jobs);
+  int *running_tasks = (int *)malloc(sizeof(int) * max_jobs);
+  if (running_jobs == NULL || running_tasks == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  int running_count = 0;
+  int next_task = 0;
+  int next_output = 0;
+  int failed_count = 0;
+  int is_interrupted = 0;
+
+  while (running_count > 0 || (next_task < task_count && !is_interrupted)) {
+    // start jobs up to the limit
+    while (!is_interrupted && running_count < max_jobs &&
+           next_task < task_count) {
+      xd_parallel_task_t *task = &tasks[next_task];
+      if (keep_order) {
+        task->output_file = xd_parallel_create_output_file();
+      }
+      xd_job_t *job = xd_parallel_create_job(template, template_count, task);
+      if (xd_job_executor_launch(job) == -1) {
+        task->is_done = 1;
+        failed_count++;
+        next_task++;
+        continue;
+      }
+      task->job = job;
+      running_jobs[running_count] = job;
+      running_tasks[running_count] = next_task;
+      running_count++;
+      next_task++;
+    }
+    if (running_count == 0) {
+      continue;
+    }
+
+    int idx = xd_jobs_wait_any(running_jobs, NULL, running_count, -1);
+    if (idx == -1) {
+      if (errno != EINTR) {
+        fprintf(stderr, "xd-shell: parallel: %s\n", strerror(errno));
+        idx = 0;
+        xd_jobs_kill(running_jobs[idx], SIGKILL);
+        xd_jobs_wait(running_jobs[idx]);
+      }
+      else {
+        // forward the interrupt to the running jobs and collect them
+        is_interrupted = 1;
+        xd_sh_is_interrupted = 0;
+        for (int i = 0; i < running_count; i++) {
+          xd_jobs_kill(running_jobs[i], SIGINT);
+          xd_jobs_kill(running_jobs[i], SIGCONT);
+        }
+        continue;
+      }
+    }
+
+    xd_job_t *job = running_jobs[idx];
+    if (xd_job_is_alive(job)) {
+      // stopped, keep it running
+      xd_jobs_kill(job, SIGCONT);
+      xd_jobs_wait_non_blocking(job);
+      continue;
+    }
+
+    xd_parallel_task_t *task = &tasks[running_tasks[idx]];
+    if (xd_jobs_exit_code(job->wait_status) != EXIT_SUCCESS) {
+      failed_count++;
+    }
+    xd_job_destroy(job);
+    task->job = NULL;
+    task->is_done = 1;
+
+    running_count--;
+    running_jobs[idx] = running_jobs[running_count];
+    running_tasks[idx] = running_tasks[running_count];
+
+    // print the buffered outputs that are next in order
+    while (next_output < next_task && tasks[next_output].is_done) {
+      xd_parallel_print_output(&tasks[next_output]);
+      next_output++;
+    }
+  }
+
+  // outputs of the jobs that failed to start after the last finished job
+  while (next_output < next_task && tasks[next_output].is_done) {
+    xd_parallel_print_output(&tasks[next_output]);
+    next_output++;
+  }
+
+  if (print_stats) {
+    clock_gettime(CLOCK_MONOTONIC, &time_spec);
+    double elapsed =
+        (double)time_spec.tv_sec + (time_spec.tv_nsec / 1e9) - start_time;
+    fprintf(stderr,
+            "parallel: %d jobs, %d failed, %.3fs elapsed, %.2f jobs/s, "
+            "up to %ld at once\n",
+            next_task, failed_count, elapsed,
+            elapsed > 0 ? next_task / elapsed : 0.0, max_jobs);
+  }
+
+  for (int i = 0; i < task_count; i++) {
+    free(tasks[i].item);
+    free(tasks[i].output_file);
+  }
+  free(tasks);
+  free((void *)running_jobs);
+  free(running_tasks);
+
+  if (is_interrupted) {
+    xd_sh_is_interrupted = 1;
+    return XD_SH_EXIT_CODE_SIGINTR;
+  }
+  return failed_count < XD_PARALLEL_EXIT_CODE_MAX ? failed_count
+                                                  : XD_PARALLEL_EXIT_CODE_MAX;
+}  // xd_parallel()
+
+/**
+ * @brief Creates the work items of the `parallel` builtin from the passed
+ * arguments, or from the lines of `stdin` if no arguments are passed.
+ *
+ * @param argc The number of arguments, starting with `:::` if not zero.
+ * @param argv The arguments.
+ * @param task_count Output pointer for the number of created items.
+ *
+ * @return A newly allocated array of the work items.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static xd_parallel_task_t *xd_parallel_read_tasks(int argc, char **argv,
+                                                  int *task_count) {
+  int count = 0;
+  int capacity = argc > 1 ? argc - 1 : 1;
+  xd_parallel_task_t *tasks =
+      (xd_parallel_task_t *)malloc(sizeof(xd_parallel_task_t) * capacity);
+  if (tasks == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  char *line = NULL;
+  size_t line_size = 0;
+  ssize_t line_length = 0;
+  int arg_idx = 1;
+  while (1) {
+    char *item = NULL;
+    if (argc > 0) {
+      if (arg_idx == argc) {
+        break;
+      }
+      item = xd_utils_strdup(argv[arg_idx++]);
+    }
+    else {
+      line_length = getline(&line, &line_size, stdin);
+      if (line_length == -1) {
+        break;
+      }
+      if (line_length > 0 && line[line_length - 1] == '\n') {
+        line[line_length - 1] = '\0';
+      }
+      item = xd_utils_strdup(line);
+    }
+
+    if (count == capacity) {
+      capacity *= 2;
+      xd_parallel_task_t *ptr = (xd_parallel_task_t *)realloc(
+          tasks, sizeof(xd_parallel_task_t) * capacity);
+      if (ptr == NULL) {
+        fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+                strerror(errno));
+        exit(EXIT_FAILURE);
+      }
+      tasks = ptr;
+    }
+    tasks[count].item = item;
+    tasks[count].job = NULL;
+    tasks[count].output_file = NULL;
+    tasks[count].is_done = 0;
+    count++;
+  }
+  free(line);
+
+  *task_count = count;
+  return tasks;
+}  // xd_parallel_read_tasks()
+
+/**
+ * @brief Creates the job running the command template of the `parallel`
+ * builtin for the passed work item.
+ *
+ * @param template The command and its arguments.
+ * @param template_count The number of strings in `template`.
+ * @param task The work item.
+ *
+ * @return A pointer to the newly created job.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static xd_job_t *xd_parallel_create_job(char **template, int template_count,
+                                        const xd_parallel_task_t *task) {
+  xd_command_t *command = xd_command_create();
+  xd_string_t *arg = xd_string_create();
+  int has_placeholder = 0;
+  for (int i = 0; i < template_count; i++) {
+    xd_string_clear(arg);
+    const char *chr = template[i];
+    while (*chr != '\0') {
+      if (chr[0] == '{' && chr[1] == '}') {
+        xd_string_append_str(arg, task->item);
+        has_placeholder = 1;
+        chr += 2;
+        continue;
+      }
+      xd_string_append_chr(arg, *chr);
+      chr++;
+    }
+    xd_command_add_arg(command, arg->str);
+  }
+  if (!has_placeholder) {
+    xd_command_add_arg(command, task->item);
+  }
+  xd_string_destroy(arg);
+
+  // the items may come from `stdin`, don't let the commands read it
+  command->input_file = xd_utils_strdup("/dev/null");
+  if (task->output_file != NULL) {
+    command->output_file = xd_utils_strdup(task->output_file);
+  }
+
+  xd_job_t *job = xd_job_create();
+  xd_job_add_command(job, command);
+  return job;
+}  // xd_parallel_create_job()
+
+/**
+ * @brief Creates an empty temporary file to buffer the output of a job of the
+ * `parallel` builtin.
+ *
+ * @return A newly allocated string containing the path of the created file,
+ * or `NULL` on failure (the output isn't buffered then).
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static char *xd_parallel_create_output_file() {
+  const char *tmpdir = xd_vars_get("TMPDIR");
+  if (tmpdir == NULL || *tmpdir == '\0') {
+    tmpdir = XD_PARALLEL_DEF_TMPDIR;
+  }
+
+  xd_string_t *path = xd_string_create();
+  xd_string_append_str(path, tmpdir);
+  xd_string_append_str(path, XD_PARALLEL_TMP_TEMPLATE);
+  int output_fd = mkstemp(path->str);
+  if (output_fd == -1) {
+    fprintf(stderr, "xd-shell: parallel: %s: %s\n", path->str,
+            strerror(errno));
+    xd_string_destroy(path);
+    return NULL;
+  }
+  close(output_fd);
+
+  char *output_file = xd_string_release(path);
+  xd_string_destroy(path);
+  return output_file;
+}  // xd_parallel_create_output_file()
+
+/**
+ * @brief Writes the buffered output of the passed work item of the `parallel`
+ * builtin to `stdout`, and removes its temporary file.
+ *
+ * @param task The finished work item.
+ */
+static void xd_parallel_print_output(xd_parallel_task_t *task) {
+  if (task->output_file == NULL) {
+    return;
+  }
+
+  int output_fd = open(task->output_file, O_RDONLY);
+  if (output_fd != -1) {
+    char buffer[BUFSIZ];
+    ssize_t length;
+    while ((length = read(output_fd, buffer, sizeof(buffer))) != 0) {
+      if (length == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      for (ssize_t written = 0; written < length;) {
+        ssize_t ret =
+            write(STDOUT_FILENO, buffer + written, (size_t)(length - written));
+        if (ret == -1) {
+          if (errno == EINTR) {
+            continue;
+          }
+          length = 0;
+          break;
+        }
+        written += ret;
+      }
+    }
+    close(output_fd);
+  }
+  unlink(task->output_file);
+}  // xd_parallel_print_output()
+
 /**
  * @brief Prints usage information for the `alias` builtin.
  */
@@ -831,7 +1630,8 @@ static int xd_unalias(int argc, char **argv) {
  * @brief Prints usage information for the `set` builtin.
  */
 static void xd_set_usage() {
-  fprintf(stderr, "set: usage: set [name[=value] ... ]\n");
+  fprintf(stderr,
+          "set: usage: set [-bx] [-o option-name] [--] [name[=value] ... ]\n");
 }  // xd_set_usage()
 
 /**
@@ -839,8 +1639,25 @@ static void xd_set_usage() {
  */
 static void xd_set_help() {
   printf(
-      "set: set [name[=value] ... ]\n"
-      "    Define or display variables.\n"
+      "set: set [-bx] [-o option-name] [--] [name[=value] ... ]\n"
+      "    Set shell options or define or display variables.\n"
+      "\n"
+      "    Options:\n"
+      "      -b    report the status of terminated or stopped background\n"
+      "            jobs immediately, not before the next prompt\n"
+      "      -x    print commands and their arguments as they are executed\n"
+      "      -o option-name\n"
+      "            turn on the option with the given name:\n"
+      "              notify    same as -b\n"
+      "              profile   profile the time spent on each source line\n"
+      "              xtrace    same as -x\n"
+      "              xtracetime\n"
+      "                        prefix each traced command with the time and\n"
+      "                        the nanoseconds since the previous one\n"
+      "\n"
+      "    Using + rather than - causes these options to be turned off.\n"
+      "    Without an option-name, `-o` prints the current options in the\n"
+      "    reusable form `set -o name` or `set +o name`.\n"
       "\n"
       "    Without arguments, it prints the list of variables in the reusable\n"
       "    form `set name=value` to standard output\n"
@@ -862,15 +1679,46 @@ static int xd_set(int argc, char **argv) {
     }
   }
 
-  int opt;
-  while ((opt = getopt(argc, argv, "")) != -1) {
-    switch (opt) {
-      case '?':
-      default:
-        fprintf(stderr, "xd-shell: set: -%c: invalid option\n",
-                optopt != 0 ? optopt : '?');
-        xd_set_usage();
-        return XD_SH_EXIT_CODE_USAGE;
+  // parse options manually, `getopt()` doesn't support `+` options
+  int idx = 1;
+  for (; idx < argc; idx++) {
+    char *arg = argv[idx];
+    if (strcmp(arg, "--") == 0) {
+      idx++;
+      break;
+    }
+    if ((arg[0] != '-' && arg[0] != '+') || arg[1] == '\0') {
+      break;
+    }
+
+    int value = (arg[0] == '-');
+    for (char *chr = arg + 1; *chr != '\0'; chr++) {
+      const xd_set_option_t *option = NULL;
+      if (*chr == 'o') {
+        if (idx + 1 == argc) {
+          xd_set_options_print();
+          continue;
+        }
+        idx++;
+        option = xd_set_option_find('\0', argv[idx]);
+        if (option == NULL) {
+          fprintf(stderr, "xd-shell: set: %s: invalid option name\n",
+                  argv[idx]);
+          xd_set_usage();
+          return XD_SH_EXIT_CODE_USAGE;
+        }
+      }
+      else {
+        option = xd_set_option_find(*chr, NULL);
+        if (option == NULL) {
+          fprintf(stderr, "xd-shell: set: %c%c: invalid option\n", arg[0],
+                  *chr);
+          xd_set_usage();
+          return XD_SH_EXIT_CODE_USAGE;
+        }
+      }
+      *option->flag = value;
+      xd_snapshot_track_option(option->name);
     }
   }
 
@@ -880,7 +1728,7 @@ static int xd_set(int argc, char **argv) {
   }
 
   int success_count = 0;
-  for (int i = 1; i < argc; i++) {
+  for (int i = idx; i < argc; i++) {
     char *name = argv[i];
     char *value = NULL;
     char *equal = strchr(name, '=');
@@ -908,9 +1756,40 @@ static int xd_set(int argc, char **argv) {
     success_count++;
   }
 
-  return success_count == argc - 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+  return success_count == argc - idx ? EXIT_SUCCESS : EXIT_FAILURE;
 }  // xd_set()
 
+/**
+ * @brief Finds the shell option with the passed letter or name.
+ *
+ * @param letter The letter of the option, used if `name` is `NULL`.
+ * @param name The long name of the option.
+ *
+ * @return A pointer to the matched option, or `NULL` if not found.
+ */
+static const xd_set_option_t *xd_set_option_find(char letter,
+                                                 const char *name) {
+  for (int i = 0; i < xd_set_options_count; i++) {
+    const xd_set_option_t *option = &xd_set_options[i];
+    if ((name == NULL && option->letter == letter) ||
+        (name != NULL && strcmp(option->name, name) == 0)) {
+      return option;
+    }
+  }
+  return NULL;
+}  // xd_set_option_find()
+
+/**
+ * @brief Prints the state of all shell options in the reusable form
+ * `set -o name` or `set +o name`.
+ */
+static void xd_set_options_print() {
+  for (int i = 0; i < xd_set_options_count; i++) {
+    printf("set %co %s\n", *xd_set_options[i].flag ? '-' : '+',
+           xd_set_options[i].name);
+  }
+}  // xd_set_options_print()
+
 /**
  * @brief Prints usage information for the `unset` builtin.
  */
@@ -1236,6 +2115,7 @@ static int xd_cd(int argc, char **argv) {
   else {
     xd_vars_put("PWD", target, 1);
   }
+  xd_prompt_set_cwd(xd_vars_get("PWD"));
 
   if (argc > 1 && strcmp(argv[1], "-") == 0) {
     char *new_pwd = xd_vars_get("PWD");
@@ -1642,10 +2522,71 @@ static int xd_source(int argc, char **argv) {
     return EXIT_FAILURE;
   }
 
-  yylex_scan_file(file);
+  if (yylex_scan_file(file, file_path) == -1) {
+    fclose(file);
+    return EXIT_FAILURE;
+  }
+  xd_snapshot_track_file(file_path);
   return EXIT_SUCCESS;
 }  // xd_source()
 
+/**
+ * @brief Prints usage information for the `memstats` builtin.
+ */
+static void xd_memstats_usage() {
+  fprintf(stderr, "memstats: usage: memstats\n");
+}  // xd_memstats_usage()
+
+/**
+ * @brief Prints detailed help information for the `memstats` builtin.
+ */
+static void xd_memstats_help() {
+  printf(
+      "memstats: memstats\n"
+      "    Display the memory allocated by each subsystem of the shell.\n"
+      "\n"
+      "    For each subsystem, prints the bytes currently allocated, the\n"
+      "    highest number of bytes allocated at once, and the number of\n"
+      "    blocks allocated and freed so far, followed by their total.\n"
+      "\n"
+      "    Exit Status:\n"
+      "    Returns success unless invalid option is given.\n");
+}  // xd_memstats_help()
+
+/**
+ * @brief Executor of `memstats` builtin command.
+ */
+static int xd_memstats(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--help") == 0) {
+      xd_memstats_help();
+      return EXIT_SUCCESS;
+    }
+  }
+
+  int opt;
+  while ((opt = getopt(argc, argv, "")) != -1) {
+    switch (opt) {
+      case '?':
+      default:
+        fprintf(stderr, "xd-shell: memstats: -%c: invalid option\n",
+                optopt != 0 ? optopt : '?');
+        xd_memstats_usage();
+        return XD_SH_EXIT_CODE_USAGE;
+    }
+  }
+
+  if (argc > 1) {
+    fprintf(stderr, "xd-shell: memstats: too many arguments\n");
+    xd_memstats_usage();
+    return XD_SH_EXIT_CODE_USAGE;
+  }
+
+  xd_alloc_print_stats(stdout);
+
+  return EXIT_SUCCESS;
+}  // xd_memstats()
+
 /**
  * @brief Prints usage information for the `exit` builtin.
  */
@@ -1772,20 +2713,47 @@ static int xd_logout(int argc, char **argv) {
   exit(exit_code);
 }  // xd_logout()
 
-// ========================
-// Public Functions
-// ========================
-
-int xd_builtins_is_builtin(const char *str) {
+/**
+ * @brief Finds the builtin with the passed name.
+ *
+ * The name is looked up in the intern table once, then compared against the
+ * interned builtin names by pointer, so names that were never interned (most
+ * external commands) are rejected without any string comparison.
+ *
+ * @param str The name to look for.
+ *
+ * @return Index of the builtin in `xd_builtins`, or `-1` if there is none.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static int xd_builtins_find(const char *str) {
   if (str == NULL) {
-    return 0;
+    return -1;
+  }
+  if (xd_builtins_symbols[0] == NULL) {
+    for (int i = 0; i < xd_builtins_count; i++) {
+      xd_builtins_symbols[i] = xd_intern(xd_builtins[i].name);
+    }
+  }
+
+  const char *symbol = xd_intern_lookup(str);
+  if (symbol == NULL) {
+    return -1;
   }
   for (int i = 0; i < xd_builtins_count; i++) {
-    if (strcmp(str, xd_builtins[i].name) == 0) {
-      return 1;
+    if (xd_builtins_symbols[i] == symbol) {
+      return i;
     }
   }
-  return 0;
+  return -1;
+}  // xd_builtins_find()
+
+// ========================
+// Public Functions
+// ========================
+
+int xd_builtins_is_builtin(const char *str) {
+  return xd_builtins_find(str) != -1;
 }  // xd_builtins_is_builtin()
 
 int xd_builtins_execute(int argc, char **argv) {
@@ -1795,21 +2763,25 @@ int xd_builtins_execute(int argc, char **argv) {
   }
   opterr = 0;  // disable getopt() errors
   optind = 0;  // reset getopt()
-  for (int i = 0; i < xd_builtins_count; i++) {
-    if (strcmp(argv[0], xd_builtins[i].name) == 0) {
-      return xd_builtins[i].func(argc, argv);
-    }
+  int idx = xd_builtins_find(argv[0]);
+  if (idx != -1) {
+    return xd_builtins[idx].func(argc, argv);
   }
   fprintf(stderr, "xd-shell: builtins: not a builtin!\n");
   return 3;
 }  // xd_builtins_execute()
 
-xd_list_t *xd_builtins_names_list() {
-  xd_list_t *list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+int *xd_builtins_option_flag(const char *name) {
+  const xd_set_option_t *option = xd_set_option_find('\0', name);
+  return (option == NULL) ? NULL : option->flag;
+}  // xd_builtins_option_flag()
+
+xd_vec_t *xd_builtins_names_list() {
+  xd_vec_t *list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
   for (int i = 0; i < xd_builtins_count; i++) {
-    xd_list_add_last(list, (void *)xd_builtins[i].name);
+    xd_vec_push(list, (void *)xd_builtins[i].name);
   }
   return list;
 }  // xd_builtins_names_list()
@@ -15,25 +15,58 @@
 
 #include "xd_command.h"
 
-#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#include "xd_alloc.h"
+#include "xd_vec.h"
+
+// ========================
+// Function Declarations
+// ========================
+
+static void *xd_command_arg_copy_func(void *data);
+static void xd_command_arg_destroy_func(void *data);
+static int xd_command_arg_comp_func(const void *data1, const void *data2);
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Copies the passed argument into the arguments of a command.
+ */
+static void *xd_command_arg_copy_func(void *data) {
+  return xd_alloc_strdup(XD_ALLOC_COMMAND, data);
+}  // xd_command_arg_copy_func()
+
+/**
+ * @brief Frees an argument copied by `xd_command_arg_copy_func()`.
+ */
+static void xd_command_arg_destroy_func(void *data) {
+  xd_alloc_free(XD_ALLOC_COMMAND, data);
+}  // xd_command_arg_destroy_func()
+
+/**
+ * @brief Compares two arguments lexicographically.
+ */
+static int xd_command_arg_comp_func(const void *data1, const void *data2) {
+  return strcmp(data1, data2);
+}  // xd_command_arg_comp_func()
 
 // ========================
 // Public Functions
 // ========================
 
 xd_command_t *xd_command_create() {
-  xd_command_t *command = (xd_command_t *)malloc(sizeof(xd_command_t));
-  if (command == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_command_t *command =
+      (xd_command_t *)xd_alloc_malloc(XD_ALLOC_COMMAND, sizeof(xd_command_t));
 
   command->argc = 0;
   command->argv = NULL;
+  command->args = NULL;
 
   command->input_file = NULL;
   command->output_file = NULL;
@@ -41,8 +74,12 @@ xd_command_t *xd_command_create() {
   command->append_output = 0;
   command->append_error = 0;
   command->pid = 0;
+  command->pidfd = -1;
   command->wait_status = -1;
   command->str = NULL;
+  memset(&command->rusage, 0, sizeof(command->rusage));
+  command->start_time = 0;
+  command->end_time = 0;
 
   return command;
 }  // xd_command_create()
@@ -54,12 +91,12 @@ void xd_command_destroy(xd_command_t *command) {
   free(command->input_file);
   free(command->output_file);
   free(command->error_file);
-  for (int i = 0; i < command->argc; i++) {
-    free(command->argv[i]);
-  }
-  free((void *)command->argv);
+  xd_vec_destroy(command->args);
   free(command->str);
-  free(command);
+  if (command->pidfd != -1) {
+    close(command->pidfd);
+  }
+  xd_alloc_free(XD_ALLOC_COMMAND, command);
 }  // xd_command_destroy()
 
 int xd_command_add_arg(xd_command_t *command, const char *arg) {
@@ -67,27 +104,16 @@ int xd_command_add_arg(xd_command_t *command, const char *arg) {
     return -1;
   }
 
-  char *argument = strdup(arg);
-  if (argument == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
+  if (command->args == NULL) {
+    command->args =
+        xd_vec_create(xd_command_arg_copy_func, xd_command_arg_destroy_func,
+                      xd_command_arg_comp_func);
   }
+  xd_vec_push(command->args, (void *)arg);
 
-  int new_argc = command->argc + 1;
-  char **new_argv =
-      (char **)realloc((void *)command->argv, sizeof(char *) * (new_argc + 1));
-  if (new_argv == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
-
-  new_argv[new_argc - 1] = argument;
-  new_argv[new_argc] = NULL;
-
-  command->argc = new_argc;
-  command->argv = new_argv;
+  // the buffer moves when the array grows
+  command->argc = command->args->length;
+  command->argv = (char **)command->args->data;
 
   return 0;  // success
 }  // xd_command_add_arg()
@@ -29,11 +29,11 @@
 
 #include "xd_aliases.h"
 #include "xd_builtins.h"
-#include "xd_list.h"
 #include "xd_readline.h"
 #include "xd_shell.h"
 #include "xd_utils.h"
 #include "xd_vars.h"
+#include "xd_vec.h"
 
 // ========================
 // Macros
@@ -43,23 +43,21 @@
 // Function Declarations
 // ========================
 
-static int xd_str_cmp(const void *first, const void *second);
+static xd_vec_t *xd_username_completions_generator(const char *partial_text);
+static xd_vec_t *xd_home_path_completions_generator(const char *partial_text);
+static xd_vec_t *xd_tilde_completions_generator(const char *partial_text);
+static xd_vec_t *xd_var_completions_generator(const char *partial_text);
+static xd_vec_t *xd_param_completions_generator(const char *partial_text);
 
-static xd_list_t *xd_username_completions_generator(const char *partial_text);
-static xd_list_t *xd_home_path_completions_generator(const char *partial_text);
-static xd_list_t *xd_tilde_completions_generator(const char *partial_text);
-static xd_list_t *xd_var_completions_generator(const char *partial_text);
-static xd_list_t *xd_param_completions_generator(const char *partial_text);
-
-static xd_list_t *xd_alias_completions_generator(const char *partial_text);
-static xd_list_t *xd_builtin_completions_generator(const char *partial_text);
-static xd_list_t *xd_executable_path_completions_generator(
+static xd_vec_t *xd_alias_completions_generator(const char *partial_text);
+static xd_vec_t *xd_builtin_completions_generator(const char *partial_text);
+static xd_vec_t *xd_executable_path_completions_generator(
     const char *partial_text);
-static xd_list_t *xd_path_command_completions_generator(
+static xd_vec_t *xd_path_command_completions_generator(
     const char *partial_text);
-static xd_list_t *xd_command_completions_generator(const char *partial_text);
+static xd_vec_t *xd_command_completions_generator(const char *partial_text);
 
-static xd_list_t *xd_arg_path_completions_generator(const char *partial_text);
+static xd_vec_t *xd_arg_path_completions_generator(const char *partial_text);
 
 // ========================
 // Variables
@@ -69,43 +67,28 @@ static xd_list_t *xd_arg_path_completions_generator(const char *partial_text);
 // Function Definitions
 // ========================
 
-/**
- * @brief Comparison function for sorting strings.
- *
- * @param first Pointer to the first element being compared.
- * @param second Pointer to the second element being compared.
- *
- * @return A negative value if first should come before second, a positive
- * value if second should come before first, zero if both are equal.
- */
-static int xd_str_cmp(const void *first, const void *second) {
-  const char *str1 = *(const char **)first;
-  const char *str2 = *(const char **)second;
-  return strcmp(str1, str2);
-}  // xd_str_cmp()
-
 /**
  * @brief Generates a list of all possible tilde username completions for the
  * passed text.
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_username_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_username_completions_generator(const char *partial_text) {
   partial_text = partial_text + 1;  // skip `~`
 
   int partial_text_len = (int)strlen(partial_text);
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   struct passwd *pwd_entry = NULL;
   struct stat file_stat;
@@ -125,7 +108,7 @@ static xd_list_t *xd_username_completions_generator(const char *partial_text) {
     }
 
     snprintf(temp, LINE_MAX, "~%s%s", pwd_entry->pw_name, (is_dir ? "/" : ""));
-    xd_list_add_last(comp_list, temp);
+    xd_vec_push(comp_list, temp);
   }
   endpwent();
 
@@ -138,15 +121,15 @@ static xd_list_t *xd_username_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_home_path_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_home_path_completions_generator(const char *partial_text) {
   partial_text = partial_text + 1;  // skip `~`
 
   char *first_slash = strchr(partial_text, '/');
@@ -200,13 +183,13 @@ static xd_list_t *xd_home_path_completions_generator(const char *partial_text) {
 
   int comp_count = (int)glob_result.gl_pathc;
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
   for (int i = 0; i < comp_count; i++) {
     snprintf(path, PATH_MAX, "~%s%s", prefix,
              glob_result.gl_pathv[i] + home_path_len);
-    xd_list_add_last(comp_list, path);
+    xd_vec_push(comp_list, path);
   }
   globfree(&glob_result);
 
@@ -219,15 +202,15 @@ static xd_list_t *xd_home_path_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_tilde_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_tilde_completions_generator(const char *partial_text) {
   if (strchr(partial_text, '/') == NULL) {
     // username completion
     return xd_username_completions_generator(partial_text);
@@ -242,36 +225,35 @@ static xd_list_t *xd_tilde_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_var_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_var_completions_generator(const char *partial_text) {
   partial_text = partial_text + 1;  // skip `$`
   int partial_text_len = (int)strlen(partial_text);
 
-  xd_list_t *var_names = xd_vars_names_list();
+  xd_vec_t *var_names = xd_vars_names_list();
   if (var_names == NULL) {
     return NULL;
   }
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
   char temp[LINE_MAX];
-  for (xd_list_node_t *node = var_names->head; node != NULL;
-       node = node->next) {
-    if (strncmp(node->data, partial_text, partial_text_len) == 0) {
-      snprintf(temp, LINE_MAX, "$%s", (char *)node->data);
-      xd_list_add_last(comp_list, temp);
+  for (int i = 0; i < var_names->length; i++) {
+    if (strncmp(var_names->data[i], partial_text, partial_text_len) == 0) {
+      snprintf(temp, LINE_MAX, "$%s", (char *)var_names->data[i]);
+      xd_vec_push(comp_list, temp);
     }
   }
 
-  xd_list_destroy(var_names);
+  xd_vec_destroy(var_names);
   return comp_list;
 }  // xd_var_completions_generator()
 
@@ -281,36 +263,35 @@ static xd_list_t *xd_var_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_param_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_param_completions_generator(const char *partial_text) {
   partial_text = partial_text + 1;  // skip `{`
   int partial_text_len = (int)strlen(partial_text);
 
-  xd_list_t *var_names = xd_vars_names_list();
+  xd_vec_t *var_names = xd_vars_names_list();
   if (var_names == NULL) {
     return NULL;
   }
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
   char temp[LINE_MAX];
-  for (xd_list_node_t *node = var_names->head; node != NULL;
-       node = node->next) {
-    if (strncmp(node->data, partial_text, partial_text_len) == 0) {
-      snprintf(temp, LINE_MAX, "{%s}", (char *)node->data);
-      xd_list_add_last(comp_list, temp);
+  for (int i = 0; i < var_names->length; i++) {
+    if (strncmp(var_names->data[i], partial_text, partial_text_len) == 0) {
+      snprintf(temp, LINE_MAX, "{%s}", (char *)var_names->data[i]);
+      xd_vec_push(comp_list, temp);
     }
   }
 
-  xd_list_destroy(var_names);
+  xd_vec_destroy(var_names);
   return comp_list;
 }
 
@@ -320,15 +301,15 @@ static xd_list_t *xd_param_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_alias_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_alias_completions_generator(const char *partial_text) {
   char delimiter_char = partial_text[0];
   char prefix[2] = "";
   if (strchr(XD_RL_TAB_COMP_DELIMITERS, delimiter_char) != NULL) {
@@ -342,24 +323,23 @@ static xd_list_t *xd_alias_completions_generator(const char *partial_text) {
     return NULL;
   }
 
-  xd_list_t *alias_names = xd_aliases_names_list();
+  xd_vec_t *alias_names = xd_aliases_names_list();
   if (alias_names == NULL) {
     return NULL;
   }
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
   char temp[LINE_MAX];
-  for (xd_list_node_t *node = alias_names->head; node != NULL;
-       node = node->next) {
-    if (strncmp(node->data, partial_text, partial_text_len) == 0) {
-      snprintf(temp, LINE_MAX, "%s%s", prefix, (char *)node->data);
-      xd_list_add_last(comp_list, temp);
+  for (int i = 0; i < alias_names->length; i++) {
+    if (strncmp(alias_names->data[i], partial_text, partial_text_len) == 0) {
+      snprintf(temp, LINE_MAX, "%s%s", prefix, (char *)alias_names->data[i]);
+      xd_vec_push(comp_list, temp);
     }
   }
 
-  xd_list_destroy(alias_names);
+  xd_vec_destroy(alias_names);
   return comp_list;
 }  // xd_alias_completions_generator()
 
@@ -369,15 +349,15 @@ static xd_list_t *xd_alias_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_builtin_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_builtin_completions_generator(const char *partial_text) {
   char delimiter_char = partial_text[0];
   char prefix[2] = "";
   if (strchr(XD_RL_TAB_COMP_DELIMITERS, delimiter_char) != NULL) {
@@ -390,24 +370,23 @@ static xd_list_t *xd_builtin_completions_generator(const char *partial_text) {
     return NULL;
   }
 
-  xd_list_t *builtin_names = xd_builtins_names_list();
+  xd_vec_t *builtin_names = xd_builtins_names_list();
   if (builtin_names == NULL) {
     return NULL;
   }
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
   char temp[LINE_MAX];
-  for (xd_list_node_t *node = builtin_names->head; node != NULL;
-       node = node->next) {
-    if (strncmp(node->data, partial_text, partial_text_len) == 0) {
-      snprintf(temp, LINE_MAX, "%s%s", prefix, (char *)node->data);
-      xd_list_add_last(comp_list, temp);
+  for (int i = 0; i < builtin_names->length; i++) {
+    if (strncmp(builtin_names->data[i], partial_text, partial_text_len) == 0) {
+      snprintf(temp, LINE_MAX, "%s%s", prefix, (char *)builtin_names->data[i]);
+      xd_vec_push(comp_list, temp);
     }
   }
 
-  xd_list_destroy(builtin_names);
+  xd_vec_destroy(builtin_names);
   return comp_list;
 }  // xd_builtin_completions_generator()
 
@@ -416,15 +395,15 @@ static xd_list_t *xd_builtin_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_executable_path_completions_generator(
+static xd_vec_t *xd_executable_path_completions_generator(
     const char *partial_text) {
   char delimiter_char = partial_text[0];
   char prefix[2] = "";
@@ -444,13 +423,13 @@ static xd_list_t *xd_executable_path_completions_generator(
 
   char temp[PATH_MAX] = {0};
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   if (strcmp(partial_text, ".") == 0 || strcmp(partial_text, "..") == 0) {
     snprintf(temp, PATH_MAX, "%s%s/", prefix, partial_text);
-    xd_list_add_last(comp_list, temp);
+    xd_vec_push(comp_list, temp);
     return comp_list;
   }
 
@@ -461,7 +440,7 @@ static xd_list_t *xd_executable_path_completions_generator(
   glob_t glob_result;
   int glob_flags = GLOB_MARK | GLOB_NOSORT;
   if (glob(temp, glob_flags, NULL, &glob_result) != 0) {
-    xd_list_destroy(comp_list);
+    xd_vec_destroy(comp_list);
     return NULL;
   }
 
@@ -480,7 +459,7 @@ static xd_list_t *xd_executable_path_completions_generator(
     }
 
     snprintf(temp, PATH_MAX, "%s%s", prefix, path);
-    xd_list_add_last(comp_list, temp);
+    xd_vec_push(comp_list, temp);
   }
   globfree(&glob_result);
 
@@ -493,15 +472,15 @@ static xd_list_t *xd_executable_path_completions_generator(
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_path_command_completions_generator(
+static xd_vec_t *xd_path_command_completions_generator(
     const char *partial_text) {
   char delimiter_char = partial_text[0];
   char prefix[2] = "";
@@ -522,9 +501,9 @@ static xd_list_t *xd_path_command_completions_generator(
   const char *cursor = PATH;
   char path_buffer[PATH_MAX];
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   while (1) {
     const char *colon = strchr(cursor, ':');
@@ -588,7 +567,7 @@ static xd_list_t *xd_path_command_completions_generator(
             if (stat(full_path, &file_stat) == 0 &&
                 S_ISREG(file_stat.st_mode)) {
               snprintf(full_path, PATH_MAX, "%s%s", prefix, name);
-              xd_list_add_last(comp_list, (void *)full_path);
+              xd_vec_push(comp_list, (void *)full_path);
             }
           }
         }
@@ -611,55 +590,51 @@ static xd_list_t *xd_path_command_completions_generator(
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_command_completions_generator(const char *partial_text) {
-  xd_list_t *alias_comp_list = xd_alias_completions_generator(partial_text);
-  xd_list_t *builtin_comp_list = xd_builtin_completions_generator(partial_text);
-  xd_list_t *path_comp_list =
+static xd_vec_t *xd_command_completions_generator(const char *partial_text) {
+  xd_vec_t *alias_comp_list = xd_alias_completions_generator(partial_text);
+  xd_vec_t *builtin_comp_list = xd_builtin_completions_generator(partial_text);
+  xd_vec_t *path_comp_list =
       xd_executable_path_completions_generator(partial_text);
-  xd_list_t *cmd_comp_list =
+  xd_vec_t *cmd_comp_list =
       xd_path_command_completions_generator(partial_text);
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   if (alias_comp_list != NULL) {
-    for (xd_list_node_t *node = alias_comp_list->head; node != NULL;
-         node = node->next) {
-      xd_list_add_last(comp_list, node->data);
+    for (int i = 0; i < alias_comp_list->length; i++) {
+      xd_vec_push(comp_list, alias_comp_list->data[i]);
     }
   }
   if (builtin_comp_list != NULL) {
-    for (xd_list_node_t *node = builtin_comp_list->head; node != NULL;
-         node = node->next) {
-      xd_list_add_last(comp_list, node->data);
+    for (int i = 0; i < builtin_comp_list->length; i++) {
+      xd_vec_push(comp_list, builtin_comp_list->data[i]);
     }
   }
   if (path_comp_list != NULL) {
-    for (xd_list_node_t *node = path_comp_list->head; node != NULL;
-         node = node->next) {
-      xd_list_add_last(comp_list, node->data);
+    for (int i = 0; i < path_comp_list->length; i++) {
+      xd_vec_push(comp_list, path_comp_list->data[i]);
     }
   }
   if (cmd_comp_list != NULL) {
-    for (xd_list_node_t *node = cmd_comp_list->head; node != NULL;
-         node = node->next) {
-      xd_list_add_last(comp_list, node->data);
+    for (int i = 0; i < cmd_comp_list->length; i++) {
+      xd_vec_push(comp_list, cmd_comp_list->data[i]);
     }
   }
 
-  xd_list_destroy(alias_comp_list);
-  xd_list_destroy(builtin_comp_list);
-  xd_list_destroy(path_comp_list);
-  xd_list_destroy(cmd_comp_list);
+  xd_vec_destroy(alias_comp_list);
+  xd_vec_destroy(builtin_comp_list);
+  xd_vec_destroy(path_comp_list);
+  xd_vec_destroy(cmd_comp_list);
 
   return comp_list;
 }  // xd_command_completions_generator()
@@ -670,15 +645,15 @@ static xd_list_t *xd_command_completions_generator(const char *partial_text) {
  *
  * @param partial_text The partial text to be completed.
  *
- * @return Pointer to a newly allocated `xd_list_t` containing all possible
+ * @return Pointer to a newly allocated `xd_vec_t` containing all possible
  * completions or `NULL` on failure.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  *
  * @note The caller is responsible for freeing the allocated memory by calling
- * `xd_list_destroy()` and passing it the returned pointer.
+ * `xd_vec_destroy()` and passing it the returned pointer.
  */
-static xd_list_t *xd_arg_path_completions_generator(const char *partial_text) {
+static xd_vec_t *xd_arg_path_completions_generator(const char *partial_text) {
   char delimiter_char = partial_text[0];
   char prefix[2] = "";
   if (strchr(XD_RL_TAB_COMP_DELIMITERS, delimiter_char) != NULL) {
@@ -693,13 +668,13 @@ static xd_list_t *xd_arg_path_completions_generator(const char *partial_text) {
 
   char temp[PATH_MAX] = {0};
 
-  xd_list_t *comp_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *comp_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   if (strcmp(partial_text, "..") == 0) {
     snprintf(temp, PATH_MAX, "%s%s/", prefix, partial_text);
-    xd_list_add_last(comp_list, temp);
+    xd_vec_push(comp_list, temp);
     return comp_list;
   }
 
@@ -710,7 +685,7 @@ static xd_list_t *xd_arg_path_completions_generator(const char *partial_text) {
   glob_t glob_result;
   int glob_flags = GLOB_MARK | GLOB_NOSORT;
   if (glob(temp, glob_flags, NULL, &glob_result) != 0) {
-    xd_list_destroy(comp_list);
+    xd_vec_destroy(comp_list);
     return NULL;
   }
 
@@ -719,7 +694,7 @@ static xd_list_t *xd_arg_path_completions_generator(const char *partial_text) {
   for (int i = 0; i < comp_count; i++) {
     char *path = glob_result.gl_pathv[i];
     snprintf(temp, PATH_MAX, "%s%s", prefix, path);
-    xd_list_add_last(comp_list, temp);
+    xd_vec_push(comp_list, temp);
   }
   globfree(&glob_result);
 
@@ -735,7 +710,7 @@ char **xd_completions_generator(const char *line, int start, int end) {
     return NULL;
   }
 
-  xd_list_t *comp_list = NULL;
+  xd_vec_t *comp_list = NULL;
   char chr = line[start];
   char prev_chr = ' ';
   if (start > 0) {
@@ -783,40 +758,15 @@ char **xd_completions_generator(const char *line, int start, int end) {
 
   free(partial_text);
   if (comp_list == NULL || comp_list->length == 0) {
-    xd_list_destroy(comp_list);
+    xd_vec_destroy(comp_list);
     return NULL;
   }
 
-  // get array of sorted completions
-  int comp_count = comp_list->length;
-  char **comp_arr = (char **)malloc(sizeof(char *) * (comp_count + 1));
-  xd_list_node_t *node = comp_list->head;
-  for (int i = 0; i < comp_count; i++) {
-    comp_arr[i] = xd_utils_strdup(node->data);
-    node = node->next;
-  }
-  qsort((void *)comp_arr, comp_count, sizeof(char *), xd_str_cmp);
-
-  // remove duplicates
-  xd_list_clear(comp_list);
-  xd_list_add_last(comp_list, comp_arr[0]);
-  for (int i = 0; i < comp_count; i++) {
-    if (strcmp(comp_list->tail->data, comp_arr[i]) != 0) {
-      xd_list_add_last(comp_list, comp_arr[i]);
-    }
-    free(comp_arr[i]);
-  }
-  free((void *)comp_arr);
-
-  comp_count = comp_list->length;
-  comp_arr = (char **)malloc(sizeof(char *) * (comp_count + 1));
-  node = comp_list->head;
-  for (int i = 0; i < comp_count; i++) {
-    comp_arr[i] = xd_utils_strdup(node->data);
-    node = node->next;
-  }
-  comp_arr[comp_count] = NULL;
-  xd_list_destroy(comp_list);
+  // sort, remove duplicates then hand off the array of completions
+  xd_vec_sort(comp_list);
+  xd_vec_dedupe(comp_list);
+  char **comp_arr = (char **)xd_vec_release(comp_list);
+  xd_vec_destroy(comp_list);
 
   return comp_arr;
 }  // xd_completions_generator()
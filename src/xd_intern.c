@@ -0,0 +1,219 @@
+/*
+ * ==============================================================================
+ * File: xd_intern.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_intern.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xd_alloc.h"
+#include "xd_utils.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Initial number of slots in the intern table, must be a power of two.
+ */
+#define XD_INTERN_MIN_CAPACITY (256)
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Represents an interned symbol, the symbol handed out to callers is
+ * the `str` member.
+ */
+typedef struct xd_symbol_t {
+  unsigned int hash;  // Hash of the string
+  int length;         // Length of the string excluding '\0'
+  char str[];         // The null-terminated string
+} xd_symbol_t;
+
+// ========================
+// Function Declarations
+// ========================
+
+static xd_symbol_t *xd_symbol_of(const char *symbol);
+static int xd_intern_find_slot(const char *str, int length, unsigned int hash);
+static void xd_intern_grow();
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief Open-addressing table of the interned symbols.
+ */
+static xd_symbol_t **xd_intern_table = NULL;
+
+/**
+ * @brief Number of slots in `xd_intern_table`.
+ */
+static int xd_intern_capacity = 0;
+
+/**
+ * @brief Number of interned symbols.
+ */
+static int xd_intern_symbol_count = 0;
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Returns the `xd_symbol_t` that holds the passed symbol.
+ */
+static xd_symbol_t *xd_symbol_of(const char *symbol) {
+  return (xd_symbol_t *)(symbol - offsetof(xd_symbol_t, str));
+}  // xd_symbol_of()
+
+/**
+ * @brief Finds the slot of the passed string in the intern table using linear
+ * probing.
+ *
+ * @param str Pointer to the string to find.
+ * @param length Length of the string.
+ * @param hash Hash of the string.
+ *
+ * @return Index of the slot holding the string, or of the empty slot where it
+ * belongs if it isn't interned.
+ */
+static int xd_intern_find_slot(const char *str, int length,
+                               unsigned int hash) {
+  int mask = xd_intern_capacity - 1;
+  int idx = (int)(hash & (unsigned int)mask);
+  while (xd_intern_table[idx] != NULL) {
+    const xd_symbol_t *symbol = xd_intern_table[idx];
+    if (symbol->hash == hash && symbol->length == length &&
+        memcmp(symbol->str, str, length) == 0) {
+      break;
+    }
+    idx = (idx + 1) & mask;
+  }
+  return idx;
+}  // xd_intern_find_slot()
+
+/**
+ * @brief Doubles the number of slots in the intern table (or creates it) and
+ * re-inserts the interned symbols.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static void xd_intern_grow() {
+  xd_symbol_t **old_table = xd_intern_table;
+  int old_capacity = xd_intern_capacity;
+
+  xd_intern_capacity =
+      (old_capacity == 0) ? XD_INTERN_MIN_CAPACITY : old_capacity * 2;
+  xd_intern_table = (xd_symbol_t **)xd_alloc_malloc(
+      XD_ALLOC_INTERN, sizeof(xd_symbol_t *) * xd_intern_capacity);
+  memset((void *)xd_intern_table, 0,
+         sizeof(xd_symbol_t *) * xd_intern_capacity);
+
+  for (int i = 0; i < old_capacity; i++) {
+    xd_symbol_t *symbol = old_table[i];
+    if (symbol != NULL) {
+      int idx = xd_intern_find_slot(symbol->str, symbol->length, symbol->hash);
+      xd_intern_table[idx] = symbol;
+    }
+  }
+  xd_alloc_free(XD_ALLOC_INTERN, (void *)old_table);
+}  // xd_intern_grow()
+
+// ========================
+// Public Functions
+// ========================
+
+const char *xd_intern(const char *str) {
+  if (str == NULL) {
+    return NULL;
+  }
+
+  // keep the load factor at most 1/2 so probe sequences stay short
+  if (2 * (xd_intern_symbol_count + 1) > xd_intern_capacity) {
+    xd_intern_grow();
+  }
+
+  int length = (int)strlen(str);
+  unsigned int hash = xd_utils_hash(str, length);
+  int idx = xd_intern_find_slot(str, length, hash);
+  if (xd_intern_table[idx] != NULL) {
+    return xd_intern_table[idx]->str;
+  }
+
+  xd_symbol_t *symbol = (xd_symbol_t *)xd_alloc_malloc(
+      XD_ALLOC_INTERN, sizeof(xd_symbol_t) + length + 1);
+  symbol->hash = hash;
+  symbol->length = length;
+  memcpy(symbol->str, str, length + 1);
+  xd_intern_table[idx] = symbol;
+  xd_intern_symbol_count++;
+  return symbol->str;
+}  // xd_intern()
+
+const char *xd_intern_lookup(const char *str) {
+  if (str == NULL || xd_intern_table == NULL) {
+    return NULL;
+  }
+  int length = (int)strlen(str);
+  unsigned int hash = xd_utils_hash(str, length);
+  xd_symbol_t *symbol =
+      xd_intern_table[xd_intern_find_slot(str, length, hash)];
+  return symbol == NULL ? NULL : symbol->str;
+}  // xd_intern_lookup()
+
+unsigned int xd_intern_hash(const char *symbol) {
+  if (symbol == NULL) {
+    return 0;
+  }
+  return xd_symbol_of(symbol)->hash;
+}  // xd_intern_hash()
+
+int xd_intern_count() {
+  return xd_intern_symbol_count;
+}  // xd_intern_count()
+
+void xd_intern_destroy() {
+  for (int i = 0; i < xd_intern_capacity; i++) {
+    xd_alloc_free(XD_ALLOC_INTERN, xd_intern_table[i]);
+  }
+  xd_alloc_free(XD_ALLOC_INTERN, (void *)xd_intern_table);
+  xd_intern_table = NULL;
+  xd_intern_capacity = 0;
+  xd_intern_symbol_count = 0;
+}  // xd_intern_destroy()
+
+void *xd_intern_copy_func(void *data) {
+  return (void *)xd_intern(data);
+}  // xd_intern_copy_func()
+
+void xd_intern_destroy_func(void *data) {
+  (void)data;
+}  // xd_intern_destroy_func()
+
+int xd_intern_comp_func(const void *data1, const void *data2) {
+  uintptr_t addr1 = (uintptr_t)data1;
+  uintptr_t addr2 = (uintptr_t)data2;
+  return (addr1 > addr2) - (addr1 < addr2);
+}  // xd_intern_comp_func()
+
+unsigned int xd_intern_hash_func(void *data) {
+  return xd_intern_hash(data);
+}  // xd_intern_hash_func()
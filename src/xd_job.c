@@ -15,13 +15,15 @@
 
 #include "xd_job.h"
 
-#include <errno.h>
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <unistd.h>
 
+#include "xd_alloc.h"
 #include "xd_command.h"
 #include "xd_job_executor.h"
 
@@ -35,11 +37,31 @@
  */
 #define XD_JOBS_STATUS_BUFFER_SIZE (42)
 
+/**
+ * @brief Default number of fractional digits printed for a time in the
+ * `xd_job_print_times()` report, also the maximum allowed.
+ */
+#define XD_JOB_TIME_PRECISION (3)
+
+/**
+ * @brief Number of nanoseconds in one second.
+ */
+#define XD_JOB_NANOSECONDS_PER_SECOND (1000000000.0)
+
+/**
+ * @brief Size of the buffer used to build `/proc` paths and read their lines.
+ */
+#define XD_JOB_PROC_BUFFER_SIZE (256)
+
 // ========================
 // Function Declarations
 // ========================
 
 static void xd_print_status_detailed(xd_job_t *job, char marker, int print_pid);
+static double xd_timeval_to_seconds(const struct timeval *tv);
+static void xd_print_time(double seconds, int precision, int is_long,
+                          FILE *stream);
+static void xd_read_proc_usage(pid_t pid, struct rusage *rusage);
 
 // ========================
 // Function Definitions
@@ -105,17 +127,88 @@ static void xd_print_status_detailed(xd_job_t *job, char marker,
   }
 }  // xd_print_status_detailed()
 
+/**
+ * @brief Converts the passed `timeval` to seconds.
+ *
+ * @param tv A pointer to the `timeval` to be converted.
+ *
+ * @return The number of seconds in the passed `timeval`.
+ */
+static double xd_timeval_to_seconds(const struct timeval *tv) {
+  return (double)tv->tv_sec + ((double)tv->tv_usec / 1000000.0);
+}  // xd_timeval_to_seconds()
+
+/**
+ * @brief Prints the passed time to the passed stream.
+ *
+ * @param seconds The time in seconds.
+ * @param precision The number of fractional digits to print.
+ * @param is_long Whether to print in the `MMmSS.FFs` form.
+ * @param stream The stream to print to.
+ */
+static void xd_print_time(double seconds, int precision, int is_long,
+                          FILE *stream) {
+  if (!is_long) {
+    fprintf(stream, "%.*f", precision, seconds);
+    return;
+  }
+  long minutes = (long)(seconds / 60);
+  fprintf(stream, "%ldm%.*fs", minutes, precision, seconds - (minutes * 60.0));
+}  // xd_print_time()
+
+/**
+ * @brief Reads the CPU times and the peak resident set size of the running
+ * process with the passed PID from `/proc`.
+ *
+ * @param pid The PID of the process.
+ * @param rusage The structure to store the usage in, fields that can't be read
+ * are left unchanged.
+ */
+static void xd_read_proc_usage(pid_t pid, struct rusage *rusage) {
+  char buf[XD_JOB_PROC_BUFFER_SIZE];
+
+  snprintf(buf, sizeof(buf), "/proc/%d/stat", (int)pid);
+  FILE *file = fopen(buf, "r");
+  if (file != NULL) {
+    if (fgets(buf, sizeof(buf), file) != NULL) {
+      // skip the command name, it's in parentheses and may contain spaces
+      char *fields = strrchr(buf, ')');
+      unsigned long utime;
+      unsigned long stime;
+      long ticks = sysconf(_SC_CLK_TCK);
+      if (fields != NULL && ticks > 0 &&
+          sscanf(fields + 1,
+                 " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime,
+                 &stime) == 2) {
+        rusage->ru_utime.tv_sec = (time_t)(utime / ticks);
+        rusage->ru_utime.tv_usec =
+            (suseconds_t)((utime % ticks) * 1000000 / ticks);
+        rusage->ru_stime.tv_sec = (time_t)(stime / ticks);
+        rusage->ru_stime.tv_usec =
+            (suseconds_t)((stime % ticks) * 1000000 / ticks);
+      }
+    }
+    fclose(file);
+  }
+
+  snprintf(buf, sizeof(buf), "/proc/%d/status", (int)pid);
+  file = fopen(buf, "r");
+  if (file != NULL) {
+    while (fgets(buf, sizeof(buf), file) != NULL) {
+      if (sscanf(buf, "VmHWM: %ld", &rusage->ru_maxrss) == 1) {
+        break;
+      }
+    }
+    fclose(file);
+  }
+}  // xd_read_proc_usage()
+
 // ========================
 // Public Functions
 // ========================
 
 xd_job_t *xd_job_create() {
-  xd_job_t *job = (xd_job_t *)malloc(sizeof(xd_job_t));
-  if (job == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_job_t *job = (xd_job_t *)xd_alloc_malloc(XD_ALLOC_JOB, sizeof(xd_job_t));
 
   job->commands = NULL;
   job->command_count = 0;
@@ -126,7 +219,16 @@ xd_job_t *xd_job_create() {
   job->wait_status = -1;
   job->job_id = -1;
   job->notify = 0;
+  job->is_waited = 0;
   job->has_tty_modes = 0;
+  job->time_mode = XD_JOB_TIME_NONE;
+  job->start_time = 0;
+  job->end_time = 0;
+  job->expansion_time = 0;
+  job->spawn_time = 0;
+  job->wait_time = 0;
+  job->parse_time = 0;
+  job->location = NULL;
 
   return job;
 }  // xd_job_create()
@@ -138,8 +240,9 @@ void xd_job_destroy(xd_job_t *job) {
   for (int i = 0; i < job->command_count; i++) {
     xd_command_destroy(job->commands[i]);
   }
-  free((void *)job->commands);
-  free(job);
+  xd_alloc_free(XD_ALLOC_JOB, (void *)job->commands);
+  free(job->location);
+  xd_alloc_free(XD_ALLOC_JOB, job);
 }  // xd_job_destroy()
 
 int xd_job_add_command(xd_job_t *job, xd_command_t *command) {
@@ -148,13 +251,9 @@ int xd_job_add_command(xd_job_t *job, xd_command_t *command) {
   }
 
   int new_command_count = job->command_count + 1;
-  xd_command_t **new_commands = (xd_command_t **)realloc(
-      (void *)job->commands, sizeof(xd_command_t *) * new_command_count);
-  if (new_commands == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_command_t **new_commands = (xd_command_t **)xd_alloc_realloc(
+      XD_ALLOC_JOB, (void *)job->commands,
+      sizeof(xd_command_t *) * new_command_count);
   new_commands[new_command_count - 1] = command;
 
   job->command_count = new_command_count;
@@ -254,6 +353,113 @@ void xd_job_print_status(xd_job_t *job, char marker, int detailed,
   xd_job_print_string(job);
 }  // xd_job_print_status()
 
+void xd_job_print_times(const xd_job_t *job, const char *format,
+                        FILE *stream) {
+  if (job == NULL || format == NULL || *format == '\0') {
+    return;
+  }
+
+  double real = 0;
+  if (job->end_time > job->start_time) {
+    real = (double)(job->end_time - job->start_time) /
+           XD_JOB_NANOSECONDS_PER_SECOND;
+  }
+  double user = 0;
+  double sys = 0;
+  long maxrss = 0;
+  for (int i = 0; i < job->command_count; i++) {
+    const struct rusage *rusage = &job->commands[i]->rusage;
+    user += xd_timeval_to_seconds(&rusage->ru_utime);
+    sys += xd_timeval_to_seconds(&rusage->ru_stime);
+    if (rusage->ru_maxrss > maxrss) {
+      maxrss = rusage->ru_maxrss;
+    }
+  }
+
+  for (const char *ptr = format; *ptr != '\0'; ptr++) {
+    if (*ptr != '%') {
+      fputc(*ptr, stream);
+      continue;
+    }
+
+    const char *spec = ptr++;
+    if (*ptr == '%') {
+      fputc('%', stream);
+      continue;
+    }
+
+    int precision = XD_JOB_TIME_PRECISION;
+    int is_long = 0;
+    if (isdigit((unsigned char)*ptr)) {
+      precision = *ptr - '0';
+      if (precision > XD_JOB_TIME_PRECISION) {
+        precision = XD_JOB_TIME_PRECISION;
+      }
+      ptr++;
+    }
+    if (*ptr == 'l') {
+      is_long = 1;
+      ptr++;
+    }
+
+    switch (*ptr) {
+      case 'R':
+        xd_print_time(real, precision, is_long, stream);
+        break;
+      case 'U':
+        xd_print_time(user, precision, is_long, stream);
+        break;
+      case 'S':
+        xd_print_time(sys, precision, is_long, stream);
+        break;
+      case 'P':
+        fprintf(stream, "%.2f", real > 0 ? ((user + sys) / real) * 100 : 0);
+        break;
+      case 'M':
+        fprintf(stream, "%ld", maxrss);
+        break;
+      case '\0':
+        fputs(spec, stream);
+        ptr--;
+        break;
+      default:
+        fwrite(spec, 1, (size_t)(ptr - spec + 1), stream);
+        break;
+    }
+  }
+  fputc('\n', stream);
+}  // xd_job_print_times()
+
+void xd_job_print_usage(const xd_job_t *job, uint64_t now, FILE *stream) {
+  if (job == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < job->command_count; i++) {
+    const xd_command_t *command = job->commands[i];
+    struct rusage rusage = command->rusage;
+    uint64_t end_time = command->end_time;
+    if (end_time == 0) {
+      xd_read_proc_usage(command->pid, &rusage);
+      end_time = now;
+    }
+
+    double real = 0;
+    if (command->start_time != 0 && end_time > command->start_time) {
+      real = (double)(end_time - command->start_time) /
+             XD_JOB_NANOSECONDS_PER_SECOND;
+    }
+    double cpu = xd_timeval_to_seconds(&rusage.ru_utime) +
+                 xd_timeval_to_seconds(&rusage.ru_stime);
+
+    fprintf(stream, "      %-7d real ", (int)command->pid);
+    xd_print_time(real, XD_JOB_TIME_PRECISION, 1, stream);
+    fprintf(stream, "  cpu ");
+    xd_print_time(cpu, XD_JOB_TIME_PRECISION, 1, stream);
+    fprintf(stream, "  maxrss %ldK  %s\n", rusage.ru_maxrss, command->str);
+  }
+}  // xd_job_print_usage()
+
 void xd_job_execute(xd_job_t *job) {
   (void)job;
 #ifndef XD_TESTING_MODE
@@ -18,10 +18,13 @@
 #include <limits.h>
 #include <signal.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <termios.h>
 #include <time.h>
 #include <unistd.h>
@@ -30,8 +33,13 @@
 #include "xd_command.h"
 #include "xd_job.h"
 #include "xd_jobs.h"
+#include "xd_profile.h"
+#include "xd_readline.h"
 #include "xd_shell.h"
+#include "xd_telemetry.h"
+#include "xd_utils.h"
 #include "xd_vars.h"
+#include "xd_xtrace.h"
 
 // ========================
 // Macros
@@ -42,10 +50,34 @@
  */
 #define XD_FILE_ACCESS_MODE (0664)
 
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Represents a snapshot of the executor's state, used to make the
+ * executor re-entrant for builtins that execute jobs themselves.
+ */
+typedef struct xd_executor_state_t {
+  xd_job_t *job;           // The job being executed
+  xd_command_t *command;   // The command being executed
+  int original_input_fd;   // Original `stdin` fd before redirection
+  int original_output_fd;  // Original `stdout` fd before redirection
+  int original_error_fd;   // Original `stderr` fd before redirection
+  int pipe_read_fd;        // The fd of the current pipe's read end
+  int pipe_write_fd;       // The fd of the current pipe's write end
+  int prev_pipe_read_fd;   // The fd of the previous pipe's read end
+  int is_first_command;    // Whether the command is the first in the job
+  int is_last_command;     // Whether the command is the last in the job
+} xd_executor_state_t;
+
 // ========================
 // Function Declarations
 // ========================
 
+static void xd_executor_state_save(xd_executor_state_t *state);
+static void xd_executor_state_restore(const xd_executor_state_t *state);
+
 static int xd_reset_signal_handlers();
 
 static int xd_backup_fds();
@@ -60,6 +92,9 @@ static void xd_execute_builtin_no_fork();
 
 static void xd_failure_cleanup();
 
+static int xd_spawn_job(int join_pgrp);
+static void xd_execute_job(xd_job_t *job);
+
 // ========================
 // Variables
 // ========================
@@ -120,6 +155,42 @@ static int xd_is_last_command = 0;
 // Function Definitions
 // ========================
 
+/**
+ * @brief Saves the executor's state in the passed snapshot.
+ *
+ * @param state The snapshot to fill.
+ */
+static void xd_executor_state_save(xd_executor_state_t *state) {
+  state->job = xd_job;
+  state->command = xd_command;
+  state->original_input_fd = xd_original_input_fd;
+  state->original_output_fd = xd_original_output_fd;
+  state->original_error_fd = xd_original_error_fd;
+  state->pipe_read_fd = xd_pipe_read_fd;
+  state->pipe_write_fd = xd_pipe_write_fd;
+  state->prev_pipe_read_fd = xd_prev_pipe_read_fd;
+  state->is_first_command = xd_is_first_command;
+  state->is_last_command = xd_is_last_command;
+}  // xd_executor_state_save()
+
+/**
+ * @brief Restores the executor's state from the passed snapshot.
+ *
+ * @param state The snapshot taken by `xd_executor_state_save()`.
+ */
+static void xd_executor_state_restore(const xd_executor_state_t *state) {
+  xd_job = state->job;
+  xd_command = state->command;
+  xd_original_input_fd = state->original_input_fd;
+  xd_original_output_fd = state->original_output_fd;
+  xd_original_error_fd = state->original_error_fd;
+  xd_pipe_read_fd = state->pipe_read_fd;
+  xd_pipe_write_fd = state->pipe_write_fd;
+  xd_prev_pipe_read_fd = state->prev_pipe_read_fd;
+  xd_is_first_command = state->is_first_command;
+  xd_is_last_command = state->is_last_command;
+}  // xd_executor_state_restore()
+
 /**
  * @brief Resets the signal handlers changed by `xd-shell`'s main process to
  * the default action (`SIG_DFL`).
@@ -145,9 +216,8 @@ static int xd_reset_signal_handlers() {
   if (signal(SIGINT, SIG_DFL) == SIG_ERR) {
     return -1;
   }
-  if (signal(SIGCHLD, SIG_DFL) == SIG_ERR) {
-    return -1;
-  }
+  // the `SIGCHLD` handler is kept for the builtins that wait for children of
+  // their own (e.g. `parallel`), `execve()` resets it to the default action
   return 0;
 }  // xd_reset_signal_handlers()
 
@@ -446,6 +516,7 @@ static void xd_execute_command() {
   char *executable = xd_command->argv[0];
 
   if (xd_builtins_is_builtin(executable)) {
+    xd_jobs_sigchld_reopen();
     int builtin_exit_code =
         xd_builtins_execute(xd_command->argc, xd_command->argv);
     exit(builtin_exit_code);
@@ -523,7 +594,8 @@ static void xd_execute_command() {
  * without fork.
  *
  * This function is used when the job is foreground (no &), and contains a
- * signal command which is a builtin command.
+ * signal command which is a builtin command. The resource usage of the shell
+ * while running the builtin is charged to the command.
  *
  * @warning This function calls `exit(EXIT_FAILURE)` if restoring original fds
  * failed after redirection.
@@ -538,6 +610,11 @@ static void xd_execute_builtin_no_fork() {
   xd_original_output_fd = -1;
   xd_original_error_fd = -1;
 
+  struct rusage usage_before;
+  getrusage(RUSAGE_SELF, &usage_before);
+  xd_job->start_time = xd_utils_now();
+  xd_command->start_time = xd_job->start_time;
+
   if (xd_backup_fds() == -1) {
     xd_sh_last_exit_code = EXIT_FAILURE;
     return;
@@ -555,6 +632,20 @@ static void xd_execute_builtin_no_fork() {
   fflush(stdout);
   fflush(stderr);
   xd_restore_fds();
+
+  struct rusage usage_after;
+  getrusage(RUSAGE_SELF, &usage_after);
+  xd_job->end_time = xd_utils_now();
+  xd_command->end_time = xd_job->end_time;
+  timersub(&usage_after.ru_utime, &usage_before.ru_utime,
+           &xd_command->rusage.ru_utime);
+  timersub(&usage_after.ru_stime, &usage_before.ru_stime,
+           &xd_command->rusage.ru_stime);
+  xd_command->rusage.ru_maxrss = usage_after.ru_maxrss;
+
+  xd_jobs_report_times(xd_job);
+  xd_telemetry_record(xd_job, xd_sh_last_exit_code);
+  xd_profile_record(xd_job);
 }  // xd_execute_builtin_no_fork()
 
 /**
@@ -587,35 +678,25 @@ static void xd_failure_cleanup() {
   xd_sh_last_exit_code = EXIT_FAILURE;
 }  // xd_failure_cleanup()
 
-// ========================
-// Public Functions
-// ========================
-
-void xd_job_executor(xd_job_t *job) {
-  struct termios saved_tty_modes;
-  int saved_tty_modes_valid = 0;
-
-  if (isatty(STDIN_FILENO)) {
-    if (tcgetattr(STDIN_FILENO, &xd_sh_tty_modes) == 0) {
-      saved_tty_modes = xd_sh_tty_modes;
-      saved_tty_modes_valid = 1;
-    }
-  }
-
-  xd_job = job;
-
-  if (xd_job->command_count == 1 && !xd_job->is_background &&
-      xd_job->commands[0]->argc > 0 &&
-      xd_builtins_is_builtin(xd_job->commands[0]->argv[0])) {
-    xd_execute_builtin_no_fork();
-    xd_job_destroy(xd_job);
-    return;
-  }
-
-  xd_job->pgid = 0;
+/**
+ * @brief Forks the processes of the current job (`xd_job`), connecting them
+ * with pipes.
+ *
+ * @param join_pgrp Whether to keep the processes in the process group of the
+ * caller instead of giving the job its own group.
+ *
+ * @return `0` on success, or `-1` on failure (the job is destroyed).
+ */
+static int xd_spawn_job(int join_pgrp) {
+  xd_job->pgid = join_pgrp ? getpgrp() : 0;
   xd_pipe_read_fd = -1;
   xd_pipe_write_fd = -1;
   int pipe_fd[2] = {-1, -1};
+  xd_job->start_time = xd_utils_now();
+
+  // built once by the shell and inherited by the children, it's kept until an
+  // exported variable changes
+  xd_vars_destroy_envp(xd_vars_create_envp());
 
   for (int i = 0; i < xd_job->command_count; i++) {
     xd_command = xd_job->commands[i];
@@ -629,7 +710,7 @@ void xd_job_executor(xd_job_t *job) {
       if (pipe(pipe_fd) == -1) {
         fprintf(stderr, "xd-shell: pipe: %s\n", strerror(errno));
         xd_failure_cleanup();
-        return;
+        return -1;
       }
       xd_pipe_read_fd = pipe_fd[0];
       xd_pipe_write_fd = pipe_fd[1];
@@ -640,7 +721,7 @@ void xd_job_executor(xd_job_t *job) {
     if (child_pid == -1) {
       fprintf(stderr, "xd-shell: fork: %s\n", strerror(errno));
       xd_failure_cleanup();
-      return;
+      return -1;
     }
 
     if (child_pid == 0) {
@@ -648,15 +729,17 @@ void xd_job_executor(xd_job_t *job) {
     }
 
     xd_command->pid = child_pid;
+    xd_command->pidfd = xd_utils_pidfd_open(child_pid);
+    xd_command->start_time = xd_utils_now();
     xd_job->unreaped_count++;
 
-    if (xd_sh_is_interactive) {
+    if (xd_sh_is_interactive && !join_pgrp) {
       if (xd_job->pgid == 0) {
         xd_job->pgid = child_pid;
       }
       setpgid(xd_command->pid, xd_job->pgid);
     }
-    else {
+    else if (!join_pgrp) {
       xd_job->pgid = xd_sh_pgid;
     }
 
@@ -668,12 +751,43 @@ void xd_job_executor(xd_job_t *job) {
     }
   }  // for()
 
-  struct timespec time_spec;
-  clock_gettime(CLOCK_MONOTONIC, &time_spec);
-  job->last_active = (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
-                     (uint64_t)time_spec.tv_nsec;
+  xd_job->last_active = xd_utils_now();
+  xd_job->spawn_time = xd_job->last_active - xd_job->start_time;
+  return 0;
+}  // xd_spawn_job()
+
+/**
+ * @brief Executes the passed job, see `xd_job_executor()`.
+ *
+ * @param job The job to be executed.
+ */
+static void xd_execute_job(xd_job_t *job) {
+  struct termios saved_tty_modes;
+  int saved_tty_modes_valid = 0;
+
+  if (isatty(STDIN_FILENO)) {
+    if (tcgetattr(STDIN_FILENO, &xd_sh_tty_modes) == 0) {
+      saved_tty_modes = xd_sh_tty_modes;
+      saved_tty_modes_valid = 1;
+    }
+  }
+
+  xd_job = job;
+
+  if (xd_job->command_count == 1 && !xd_job->is_background &&
+      xd_job->commands[0]->argc > 0 &&
+      xd_builtins_is_builtin(xd_job->commands[0]->argv[0])) {
+    xd_execute_builtin_no_fork();
+    xd_job_destroy(xd_job);
+    return;
+  }
+
+  if (xd_spawn_job(0) == -1) {
+    return;
+  }
 
   if (!xd_job->is_background) {
+    uint64_t wait_start = xd_utils_now();
     if (xd_sh_is_interactive) {
       xd_jobs_put_in_foreground(xd_job->pgid);
       xd_sh_last_exit_code = xd_jobs_wait(xd_job);
@@ -682,8 +796,12 @@ void xd_job_executor(xd_job_t *job) {
     else {
       xd_sh_last_exit_code = xd_jobs_wait(xd_job);
     }
+    xd_job->wait_time += xd_utils_now() - wait_start;
 
     if (!xd_job_is_alive(xd_job)) {
+      xd_jobs_report_times(xd_job);
+      xd_telemetry_record(xd_job, xd_sh_last_exit_code);
+      xd_profile_record(xd_job);
       xd_job_destroy(xd_job);
     }
     else {
@@ -728,4 +846,34 @@ void xd_job_executor(xd_job_t *job) {
     }
     xd_sh_last_exit_code = EXIT_SUCCESS;
   }
+}  // xd_execute_job()
+
+// ========================
+// Public Functions
+// ========================
+
+void xd_job_executor(xd_job_t *job) {
+  xd_executor_state_t state;
+  xd_executor_state_save(&state);
+  if (xd_sh_is_interactive) {
+    // the output of the job may end in the middle of a line
+    xd_readline_cursor_unknown();
+  }
+  if (xd_sh_xtrace) {
+    xd_xtrace_job(job);
+  }
+  xd_execute_job(job);
+  xd_executor_state_restore(&state);
 }  // xd_job_executor()
+
+int xd_job_executor_launch(xd_job_t *job) {
+  xd_executor_state_t state;
+  xd_executor_state_save(&state);
+  xd_job = job;
+  xd_job->is_background = 1;
+  // a forked child (e.g. `parallel` in a pipeline) keeps the processes in its
+  // own process group, so they get the signals sent from the terminal to it
+  int ret = xd_spawn_job(getpid() != xd_sh_pid);
+  xd_executor_state_restore(&state);
+  return ret;
+}  // xd_job_executor_launch()
@@ -16,10 +16,14 @@
 #include "xd_jobs.h"
 
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <time.h>
@@ -27,21 +31,121 @@
 
 #include "xd_command.h"
 #include "xd_job.h"
-#include "xd_list.h"
+#include "xd_map.h"
+#include "xd_profile.h"
 #include "xd_shell.h"
+#include "xd_telemetry.h"
+#include "xd_vars.h"
 
 // ========================
 // Macros
 // ========================
 
+/**
+ * @brief Maximum number of pidfds polled at once by `xd_jobs_poll()`, state
+ * changes of the processes beyond that are still caught through the `SIGCHLD`
+ * self-pipe.
+ */
+#define XD_JOBS_POLL_FDS_MAX (64)
+
+/**
+ * @brief Default capacity of the jobs table.
+ */
+#define XD_JOBS_DEF_CAP (16)
+
+/**
+ * @brief Number of nanoseconds in one millisecond.
+ */
+#define XD_JOBS_NANOSECONDS_PER_MILLISECOND (1000000ULL)
+
+/**
+ * @brief Maximum number of saved statuses of finished background processes,
+ * the oldest status is dropped when a new one doesn't fit.
+ */
+#define XD_JOBS_SAVED_STATUSES_MAX (64)
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Represents an entry in the PID index, maps a child process to the job
+ * and the command it is executing.
+ */
+typedef struct xd_pid_entry_t {
+  xd_job_t *job;          // Job owning the child process
+  xd_command_t *command;  // Command executed by the child process
+} xd_pid_entry_t;
+
+/**
+ * @brief Represents the recency lists used to track the current (`+`) and
+ * previous (`-`) jobs.
+ */
+typedef enum xd_recency_list_t {
+  XD_RECENCY_NONE,     // not linked (finished or not in the table)
+  XD_RECENCY_RUNNING,  // running jobs, most recently active first
+  XD_RECENCY_STOPPED,  // stopped jobs, most recently active first
+} xd_recency_list_t;
+
+/**
+ * @brief Represents a slot in the jobs table, the slot at index `i` holds the
+ * job with id `i + 1`.
+ */
+typedef struct xd_job_slot_t {
+  xd_job_t *job;           // The job, or `NULL` if the slot is free
+  xd_recency_list_t list;  // The recency list the job is linked in
+  int prev;                // Id of the next more recent job in `list` or `0`
+  int next;                // Id of the next less recent job in `list` or `0`
+  int is_dirty;            // Whether the job is in the dirty queue
+  int dirty_next;          // Id of the next job in the dirty queue or `0`
+} xd_job_slot_t;
+
+/**
+ * @brief Represents the saved status of a process of a finished background
+ * job, kept after the job is removed from the jobs table until `wait` collects
+ * it.
+ */
+typedef struct xd_saved_status_t {
+  pid_t pid;            // PID of the process, or `0` if collected
+  int job_id;           // Id the job had, or `0` if collected
+  unsigned int serial;  // Serial of the job, shared by its processes
+  int wait_status;      // Wait status of the process
+  int job_wait_status;  // Wait status of the job
+} xd_saved_status_t;
+
 // ========================
 // Function Declarations
 // ========================
 
-static void *xd_job_copy_func(void *data);
-static void xd_job_destroy_func(void *data);
-static int xd_job_comp_func(const void *data1, const void *data2);
-static int xd_job_is_newer(const xd_job_t *job1, const xd_job_t *job2);
+static void xd_free_ids_push(int job_id);
+static int xd_free_ids_pop();
+
+static int xd_is_in_table(const xd_job_t *job);
+static void xd_recency_unlink(int job_id);
+static void xd_recency_touch(xd_job_t *job);
+
+static void xd_dirty_push(int job_id);
+
+static void *xd_pid_key_copy_func(void *data);
+static void xd_pid_key_destroy_func(void *data);
+static int xd_pid_key_comp_func(const void *data1, const void *data2);
+static unsigned int xd_pid_key_hash_func(void *data);
+static void *xd_pid_entry_copy_func(void *data);
+static void xd_pid_entry_destroy_func(void *data);
+static int xd_pid_entry_comp_func(const void *data1, const void *data2);
+
+static void xd_pid_index_add_job(xd_job_t *job);
+static void xd_pid_index_remove_job(xd_job_t *job);
+
+static int xd_is_reaped(const xd_command_t *command);
+static void xd_update_status(xd_job_t *job, xd_command_t *command, int status,
+                             const struct rusage *rusage);
+static int xd_update_job(xd_job_t *job);
+
+static void xd_sigchld_pipe_open();
+
+static void xd_save_statuses(const xd_job_t *job);
+static xd_saved_status_t *xd_saved_status_find(pid_t pid, int job_id);
 
 static void xd_notify_status_change();
 static void xd_remove_finished();
@@ -52,14 +156,75 @@ static void xd_update_current_job();
 // ========================
 
 /**
- * @brief Tracks the nesting depth of `SIGCHLD` blocking.
+ * @brief Self-pipe written by the `SIGCHLD` handler to wake up the main loop,
+ * the read-end is watched while waiting for input.
+ */
+static int xd_sigchld_pipe[2] = {-1, -1};
+
+/**
+ * @brief Indicates whether a `SIGCHLD` was received and the children were not
+ * reaped yet.
+ */
+static volatile sig_atomic_t xd_sigchld_pending = 0;
+
+/**
+ * @brief Table of jobs indexed by job id, see `xd_job_slot_t`.
+ */
+static xd_job_slot_t *xd_jobs = NULL;
+
+/**
+ * @brief Capacity of `xd_jobs`.
+ */
+static int xd_jobs_capacity = 0;
+
+/**
+ * @brief Highest job id handed out, slots beyond it are not in use.
  */
-static int xd_sigchld_block_count = 0;
+static int xd_jobs_max_id = 0;
 
 /**
- * @brief List of jobs.
+ * @brief Number of jobs in `xd_jobs`.
  */
-static xd_list_t *xd_jobs = NULL;
+static int xd_jobs_count = 0;
+
+/**
+ * @brief Min-heap of the freed job ids, so the lowest free id is reused
+ * first.
+ */
+static int *xd_free_ids = NULL;
+
+/**
+ * @brief Number of ids in `xd_free_ids`.
+ */
+static int xd_free_ids_length = 0;
+
+/**
+ * @brief Capacity of `xd_free_ids`.
+ */
+static int xd_free_ids_capacity = 0;
+
+/**
+ * @brief Head (most recent job id) of each recency list, indexed by
+ * `xd_recency_list_t`.
+ */
+static int xd_recency_heads[XD_RECENCY_STOPPED + 1] = {0};
+
+/**
+ * @brief Head (first job id) of the queue of jobs that were active since the
+ * last refresh, `0` if the queue is empty.
+ */
+static int xd_dirty_head = 0;
+
+/**
+ * @brief Tail (last job id) of the dirty queue, `0` if the queue is empty.
+ */
+static int xd_dirty_tail = 0;
+
+/**
+ * @brief Index of the child processes of the jobs in the jobs table, maps a PID
+ * to its `xd_pid_entry_t`, used for constant time lookups when reaping.
+ */
+static xd_map_t *xd_pid_index = NULL;
 
 /**
  * @brief Current job (`+`).
@@ -71,88 +236,470 @@ static xd_job_t *xd_current_job = NULL;
  */
 static xd_job_t *xd_previous_job = NULL;
 
+/**
+ * @brief Ring of the saved statuses of finished background processes, see
+ * `xd_saved_status_t`.
+ */
+static xd_saved_status_t xd_saved_statuses[XD_JOBS_SAVED_STATUSES_MAX];
+
+/**
+ * @brief Index in `xd_saved_statuses` of the next status to save (the oldest
+ * saved status).
+ */
+static int xd_saved_statuses_next = 0;
+
+/**
+ * @brief Serial given to the last job whose statuses were saved.
+ */
+static unsigned int xd_saved_statuses_serial = 0;
+
 // ========================
 // Function Definitions
 // ========================
 
 /**
- * @brief Implementation of `xd_gens_copy_func` for `xd_job_t` objects.
+ * @brief Adds the passed job id to the free ids min-heap.
+ *
+ * @param job_id The freed job id.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
  */
-static void *xd_job_copy_func(void *data) {
+static void xd_free_ids_push(int job_id) {
+  if (xd_free_ids_length == xd_free_ids_capacity) {
+    int new_capacity = xd_free_ids_capacity == 0 ? XD_JOBS_DEF_CAP
+                                                 : xd_free_ids_capacity * 2;
+    int *ptr = (int *)realloc(xd_free_ids, sizeof(int) * new_capacity);
+    if (ptr == NULL) {
+      fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+              strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+    xd_free_ids = ptr;
+    xd_free_ids_capacity = new_capacity;
+  }
+
+  // sift up
+  int idx = xd_free_ids_length++;
+  while (idx > 0 && xd_free_ids[(idx - 1) / 2] > job_id) {
+    xd_free_ids[idx] = xd_free_ids[(idx - 1) / 2];
+    idx = (idx - 1) / 2;
+  }
+  xd_free_ids[idx] = job_id;
+}  // xd_free_ids_push()
+
+/**
+ * @brief Removes and returns the lowest id from the free ids min-heap.
+ *
+ * @return The lowest free job id, or `0` if the heap is empty.
+ */
+static int xd_free_ids_pop() {
+  if (xd_free_ids_length == 0) {
+    return 0;
+  }
+  int min_id = xd_free_ids[0];
+  int last_id = xd_free_ids[--xd_free_ids_length];
+
+  // sift down
+  int idx = 0;
+  while (1) {
+    int child = (2 * idx) + 1;
+    if (child >= xd_free_ids_length) {
+      break;
+    }
+    if (child + 1 < xd_free_ids_length &&
+        xd_free_ids[child + 1] < xd_free_ids[child]) {
+      child++;
+    }
+    if (xd_free_ids[child] >= last_id) {
+      break;
+    }
+    xd_free_ids[idx] = xd_free_ids[child];
+    idx = child;
+  }
+  xd_free_ids[idx] = last_id;
+  return min_id;
+}  // xd_free_ids_pop()
+
+/**
+ * @brief Checks whether the passed job is in the jobs table.
+ *
+ * @param job The job to be checked.
+ *
+ * @return `1` if the job is in the table, `0` otherwise.
+ */
+static int xd_is_in_table(const xd_job_t *job) {
+  return job->job_id > 0 && job->job_id <= xd_jobs_max_id &&
+         xd_jobs[job->job_id - 1].job == job;
+}  // xd_is_in_table()
+
+/**
+ * @brief Unlinks the job with the passed id from its recency list.
+ *
+ * @param job_id The id of the job to be unlinked.
+ */
+static void xd_recency_unlink(int job_id) {
+  xd_job_slot_t *slot = &xd_jobs[job_id - 1];
+  if (slot->list == XD_RECENCY_NONE) {
+    return;
+  }
+  if (slot->prev != 0) {
+    xd_jobs[slot->prev - 1].next = slot->next;
+  }
+  else {
+    xd_recency_heads[slot->list] = slot->next;
+  }
+  if (slot->next != 0) {
+    xd_jobs[slot->next - 1].prev = slot->prev;
+  }
+  slot->list = XD_RECENCY_NONE;
+  slot->prev = 0;
+  slot->next = 0;
+}  // xd_recency_unlink()
+
+/**
+ * @brief Moves the passed job to the front of the recency list matching its
+ * state, or unlinks it if it finished, and queues it for the next refresh.
+ *
+ * Called whenever the job is active (changes state or is waited), this keeps
+ * each list ordered by `last_active` without rescanning the table.
+ *
+ * @param job The job that was active.
+ *
+ * @note This function does nothing if the job is not in the jobs table.
+ */
+static void xd_recency_touch(xd_job_t *job) {
+  if (!xd_is_in_table(job)) {
+    return;
+  }
+  int job_id = job->job_id;
+  xd_dirty_push(job_id);
+  xd_recency_unlink(job_id);
+  if (!xd_job_is_alive(job)) {
+    return;
+  }
+
+  xd_recency_list_t list =
+      xd_job_is_stopped(job) ? XD_RECENCY_STOPPED : XD_RECENCY_RUNNING;
+  xd_job_slot_t *slot = &xd_jobs[job_id - 1];
+  slot->list = list;
+  slot->prev = 0;
+  slot->next = xd_recency_heads[list];
+  if (slot->next != 0) {
+    xd_jobs[slot->next - 1].prev = job_id;
+  }
+  xd_recency_heads[list] = job_id;
+}  // xd_recency_touch()
+
+/**
+ * @brief Appends the job with the passed id to the dirty queue, unless it is
+ * already queued.
+ *
+ * @param job_id The id of the job to be queued.
+ */
+static void xd_dirty_push(int job_id) {
+  xd_job_slot_t *slot = &xd_jobs[job_id - 1];
+  if (slot->is_dirty) {
+    return;
+  }
+  slot->is_dirty = 1;
+  slot->dirty_next = 0;
+  if (xd_dirty_tail != 0) {
+    xd_jobs[xd_dirty_tail - 1].dirty_next = job_id;
+  }
+  else {
+    xd_dirty_head = job_id;
+  }
+  xd_dirty_tail = job_id;
+}  // xd_dirty_push()
+
+/**
+ * @brief Implementation of `xd_gens_copy_func` for PID keys.
+ *
+ * @note PIDs are stored directly in the key pointer, nothing is allocated.
+ */
+static void *xd_pid_key_copy_func(void *data) {
   return data;
-}
-// xd_job_copy_func()
+}  // xd_pid_key_copy_func()
+
+/**
+ * @brief Implementation of `xd_gens_destroy_func` for PID keys.
+ */
+static void xd_pid_key_destroy_func(void *data) {
+  (void)data;
+}  // xd_pid_key_destroy_func()
+
+/**
+ * @brief Implementation of `xd_gens_comp_func` for PID keys.
+ */
+static int xd_pid_key_comp_func(const void *data1, const void *data2) {
+  pid_t pid1 = (pid_t)(intptr_t)data1;
+  pid_t pid2 = (pid_t)(intptr_t)data2;
+  if (pid1 < pid2) {
+    return -1;
+  }
+  if (pid1 > pid2) {
+    return 1;
+  }
+  return 0;
+}  // xd_pid_key_comp_func()
+
+/**
+ * @brief Implementation of `xd_gens_hash_func` for PID keys.
+ */
+static unsigned int xd_pid_key_hash_func(void *data) {
+  return (unsigned int)(intptr_t)data;
+}  // xd_pid_key_hash_func()
+
+/**
+ * @brief Implementation of `xd_gens_copy_func` for `xd_pid_entry_t` objects.
+ */
+static void *xd_pid_entry_copy_func(void *data) {
+  if (data == NULL) {
+    return NULL;
+  }
+  xd_pid_entry_t *copy = (xd_pid_entry_t *)malloc(sizeof(xd_pid_entry_t));
+  if (copy == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  *copy = *(xd_pid_entry_t *)data;
+  return copy;
+}  // xd_pid_entry_copy_func()
 
 /**
- * @brief Implementation of `xd_gens_destroy_func` for `xd_job_t` objects.
+ * @brief Implementation of `xd_gens_destroy_func` for `xd_pid_entry_t` objects.
  */
-static void xd_job_destroy_func(void *data) {
-  xd_job_destroy(data);
-}
-// xd_job_destroy_func()
+static void xd_pid_entry_destroy_func(void *data) {
+  free(data);
+}  // xd_pid_entry_destroy_func()
 
 /**
- * @brief Implementation of `xd_gens_comp_func` for `xd_job_t` objects.
+ * @brief Implementation of `xd_gens_comp_func` for `xd_pid_entry_t` objects.
  */
-static int xd_job_comp_func(const void *data1, const void *data2) {
+static int xd_pid_entry_comp_func(const void *data1, const void *data2) {
   if (data1 == NULL && data2 == NULL) {
     return 0;
   }
-  if (data1 == NULL) {
+  if (data1 == NULL || data2 == NULL) {
     return -1;
   }
-  if (data2 == NULL) {
-    return -1;
+  const xd_pid_entry_t *entry1 = data1;
+  const xd_pid_entry_t *entry2 = data2;
+  if (entry1->command == entry2->command) {
+    return 0;
   }
-  xd_job_t *job1 = (xd_job_t *)data1;
-  xd_job_t *job2 = (xd_job_t *)data2;
-  if (job1->job_id < job2->job_id) {
-    return -1;
+  return (entry1->command < entry2->command) ? -1 : 1;
+}  // xd_pid_entry_comp_func()
+
+/**
+ * @brief Adds the child processes of the passed job to the PID index.
+ *
+ * @param job The job to index its child processes.
+ */
+static void xd_pid_index_add_job(xd_job_t *job) {
+  for (int i = 0; i < job->command_count; i++) {
+    xd_command_t *command = job->commands[i];
+    if (command->pid == 0) {
+      continue;  // failure before fork in xd_job_executor()
+    }
+    xd_pid_entry_t entry = {job, command};
+    xd_map_put(xd_pid_index, (void *)(intptr_t)command->pid, &entry);
   }
-  if (job1->job_id > job2->job_id) {
-    return 1;
+}  // xd_pid_index_add_job()
+
+/**
+ * @brief Removes the child processes of the passed job from the PID index.
+ *
+ * @param job The job to remove its child processes from the index.
+ *
+ * @note Entries whose PID was reused by a process of another job are kept.
+ */
+static void xd_pid_index_remove_job(xd_job_t *job) {
+  for (int i = 0; i < job->command_count; i++) {
+    void *key = (void *)(intptr_t)job->commands[i]->pid;
+    xd_pid_entry_t *entry = xd_map_get(xd_pid_index, key);
+    if (entry != NULL && entry->job == job) {
+      xd_map_remove(xd_pid_index, key);
+    }
   }
-  return 0;
-}  // xd_job_comp_func()
+}  // xd_pid_index_remove_job()
 
 /**
- * @brief Used while updating the current (`+`) and previous (`-`) jobs, to
- * check whether the first passed job is newer than the second passed job.
+ * @brief Checks whether the process executing the passed command was reaped.
  *
- * @param job1 The first job, to check if newer.
- * @param job2 The second job, to check if older.
+ * @param command The command to be checked.
  *
- * @return `1` if the first passed job is newer than the second passed job, or
- * `0` otherwise.
+ * @return `1` if the process was reaped or was never forked, `0` otherwise.
  */
-static int xd_job_is_newer(const xd_job_t *job1, const xd_job_t *job2) {
-  if (job1 == NULL) {
-    return 0;
+static int xd_is_reaped(const xd_command_t *command) {
+  if (command->pid == 0) {
+    return 1;  // failure before fork in xd_job_executor()
   }
-  if (job2 == NULL) {
-    return 1;
+  return command->wait_status != -1 && (WIFEXITED(command->wait_status) ||
+                                        WIFSIGNALED(command->wait_status));
+}  // xd_is_reaped()
+
+/**
+ * @brief Updates the passed job and command with the passed wait status of the
+ * process executing the command.
+ *
+ * @param job The job owning the command.
+ * @param command The command whose process changed state.
+ * @param status The wait status returned by `wait4()`.
+ * @param rusage The resource usage returned by `wait4()`, kept in the command
+ * once its process is reaped.
+ */
+static void xd_update_status(xd_job_t *job, xd_command_t *command, int status,
+                             const struct rusage *rusage) {
+  int was_stopped = WIFSTOPPED(command->wait_status);
+  command->wait_status = status;
+
+  if (job->commands[job->command_count - 1] == command || WIFSTOPPED(status)) {
+    job->wait_status = status;
+  }
+
+  if (WIFCONTINUED(status)) {
+    if (was_stopped) {
+      job->stopped_count--;
+    }
+  }
+  else if (WIFSTOPPED(status)) {
+    if (!was_stopped) {
+      job->stopped_count++;
+    }
+  }
+  else if (WIFEXITED(status) || WIFSIGNALED(status)) {
+    if (was_stopped) {
+      job->stopped_count--;
+    }
+    job->unreaped_count--;
+    command->rusage = *rusage;
+    if (command->pidfd != -1) {
+      close(command->pidfd);
+      command->pidfd = -1;
+    }
+  }
+
+  struct timespec time_spec;
+  clock_gettime(CLOCK_MONOTONIC, &time_spec);
+  job->last_active = (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
+                     (uint64_t)time_spec.tv_nsec;
+  if (xd_is_reaped(command)) {
+    command->end_time = job->last_active;
+  }
+  if (job->unreaped_count == 0) {
+    job->end_time = job->last_active;
   }
+  xd_recency_touch(job);
+}  // xd_update_status()
 
-  int job1_stopped = xd_job_is_stopped(job1);
-  int job2_stopped = xd_job_is_stopped(job2);
+/**
+ * @brief Collects the pending state changes of the processes of the passed
+ * job without blocking.
+ *
+ * @param job The job to be updated.
+ *
+ * @return The number of state changes collected.
+ */
+static int xd_update_job(xd_job_t *job) {
+  int changes = 0;
+  int status;
+  struct rusage rusage;
+  for (int i = 0; i < job->command_count; i++) {
+    xd_command_t *command = job->commands[i];
+    if (xd_is_reaped(command)) {
+      continue;
+    }
+    pid_t pid = wait4(command->pid, &status, WNOHANG | WUNTRACED | WCONTINUED,
+                      &rusage);
+    if (pid == -1 && errno == EINTR) {
+      i--;
+      continue;
+    }
+    if (pid <= 0) {
+      continue;
+    }
+    xd_update_status(job, command, status, &rusage);
+    changes++;
+  }
+  return changes;
+}  // xd_update_job()
 
-  if (job1_stopped != job2_stopped) {
-    return job1_stopped;
+/**
+ * @brief Creates the `SIGCHLD` self-pipe, both ends are non-blocking and closed
+ * on `exec`.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` if the pipe can't be
+ * created.
+ */
+static void xd_sigchld_pipe_open() {
+  if (pipe(xd_sigchld_pipe) == -1) {
+    fprintf(stderr, "xd-shell: pipe: %s\n", strerror(errno));
+    exit(EXIT_FAILURE);
   }
-  if (job1->last_active != job2->last_active) {
-    return job1->last_active > job2->last_active;
+  for (int i = 0; i < 2; i++) {
+    int flags = fcntl(xd_sigchld_pipe[i], F_GETFL);
+    fcntl(xd_sigchld_pipe[i], F_SETFL, flags | O_NONBLOCK);
+    fcntl(xd_sigchld_pipe[i], F_SETFD, FD_CLOEXEC);
   }
-  return job1->job_id > job2->job_id;
-}  // xd_job_is_newer()
+}  // xd_sigchld_pipe_open()
 
-static void xd_notify_status_change() {
-  if (xd_jobs == NULL) {
+/**
+ * @brief Saves the statuses of the processes of the passed finished background
+ * job, so `wait` can still collect them after the job is removed.
+ *
+ * @param job A pointer to the finished job, nothing is saved if `wait` already
+ * returned its status.
+ */
+static void xd_save_statuses(const xd_job_t *job) {
+  if (!job->is_background || job->is_waited) {
     return;
   }
+  xd_saved_statuses_serial++;
+  for (int i = 0; i < job->command_count; i++) {
+    xd_saved_status_t *saved = &xd_saved_statuses[xd_saved_statuses_next];
+    xd_saved_statuses_next =
+        (xd_saved_statuses_next + 1) % XD_JOBS_SAVED_STATUSES_MAX;
+    saved->pid = job->commands[i]->pid;
+    saved->job_id = job->job_id;
+    saved->serial = xd_saved_statuses_serial;
+    saved->wait_status = job->commands[i]->wait_status;
+    saved->job_wait_status = job->wait_status;
+  }
+}  // xd_save_statuses()
+
+/**
+ * @brief Finds the most recently saved status of the process with the passed
+ * PID, or of a process of the job that had the passed id.
+ *
+ * @param pid The PID to look for, or `0` to look for `job_id`.
+ * @param job_id The job id to look for, used if `pid` is `0`.
+ *
+ * @return A pointer to the saved status, or `NULL` if not found.
+ */
+static xd_saved_status_t *xd_saved_status_find(pid_t pid, int job_id) {
+  for (int i = 1; i <= XD_JOBS_SAVED_STATUSES_MAX; i++) {
+    int index = (xd_saved_statuses_next - i + XD_JOBS_SAVED_STATUSES_MAX) %
+                XD_JOBS_SAVED_STATUSES_MAX;
+    xd_saved_status_t *saved = &xd_saved_statuses[index];
+    if ((pid > 0 && saved->pid == pid) ||
+        (pid == 0 && job_id > 0 && saved->job_id == job_id)) {
+      return saved;
+    }
+  }
+  return NULL;
+}  // xd_saved_status_find()
 
-  for (xd_list_node_t *node = xd_jobs->head; node != NULL; node = node->next) {
-    xd_job_t *job = node->data;
-    if (!job->notify) {
+/**
+ * @brief Prints the status of the queued jobs that have a pending
+ * notification.
+ */
+static void xd_notify_status_change() {
+  for (int job_id = xd_dirty_head; job_id != 0;
+       job_id = xd_jobs[job_id - 1].dirty_next) {
+    xd_job_t *job = xd_jobs[job_id - 1].job;
+    if (job == NULL || !job->notify) {
       continue;
     }
     char marker = ' ';
@@ -168,51 +715,64 @@ static void xd_notify_status_change() {
 }  // xd_notify_status_change()
 
 /**
- * @brief Remove all finished jobs from the jobs list.
+ * @brief Empties the dirty queue, removing the queued jobs that finished from
+ * the jobs table and freeing their ids.
  */
 static void xd_remove_finished() {
-  if (xd_jobs == NULL) {
-    return;
-  }
-  xd_list_node_t *curr = xd_jobs->head;
-  xd_list_node_t *next = NULL;
-  xd_job_t *curr_job = NULL;
-  while (curr != NULL) {
-    next = curr->next;
-    curr_job = curr->data;
-    if (curr_job->unreaped_count == 0) {
-      xd_list_remove_node(xd_jobs, curr);
+  int job_id = xd_dirty_head;
+  xd_dirty_head = 0;
+  xd_dirty_tail = 0;
+  while (job_id != 0) {
+    xd_job_slot_t *slot = &xd_jobs[job_id - 1];
+    int next_id = slot->dirty_next;
+    slot->is_dirty = 0;
+    slot->dirty_next = 0;
+
+    xd_job_t *job = slot->job;
+    if (job != NULL && job->unreaped_count == 0) {
+      xd_jobs_report_times(job);
+      xd_telemetry_record(job, xd_jobs_exit_code(job->wait_status));
+      xd_profile_record(job);
+      xd_save_statuses(job);
+      xd_pid_index_remove_job(job);
+      xd_recency_unlink(job_id);
+      slot->job = NULL;
+      xd_job_destroy(job);
+      xd_jobs_count--;
+      xd_free_ids_push(job_id);
     }
-    curr = next;
+    job_id = next_id;
+  }
+
+  if (xd_jobs_count == 0) {
+    // start over from `1` like a fresh table
+    xd_jobs_max_id = 0;
+    xd_free_ids_length = 0;
   }
 }  // xd_remove_finished()
 
 /**
- * @brief Updates the current (`+`) and previous jobs (`-`).
+ * @brief Updates the current (`+`) and previous jobs (`-`) from the heads of
+ * the recency lists, stopped jobs come first.
  */
 static void xd_update_current_job() {
-  if (xd_jobs == NULL) {
-    return;
-  }
-
-  xd_job_t *first = NULL;
-  xd_job_t *second = NULL;
-  for (xd_list_node_t *node = xd_jobs->head; node != NULL; node = node->next) {
-    xd_job_t *job = node->data;
-    if (!xd_job_is_alive(job)) {
-      continue;
-    }
-
-    if (xd_job_is_newer(job, first)) {
-      second = first;
-      first = job;
-    }
-    else if (job != first && xd_job_is_newer(job, second)) {
-      second = job;
+  int first = 0;
+  int second = 0;
+  int stopped_head = xd_recency_heads[XD_RECENCY_STOPPED];
+  int running_head = xd_recency_heads[XD_RECENCY_RUNNING];
+  if (stopped_head != 0) {
+    first = stopped_head;
+    second = xd_jobs[stopped_head - 1].next;
+    if (second == 0) {
+      second = running_head;
     }
   }
-  xd_current_job = first;
-  xd_previous_job = second;
+  else if (running_head != 0) {
+    first = running_head;
+    second = xd_jobs[running_head - 1].next;
+  }
+  xd_current_job = first != 0 ? xd_jobs[first - 1].job : NULL;
+  xd_previous_job = second != 0 ? xd_jobs[second - 1].job : NULL;
 }  // xd_update_current_job()
 
 // ========================
@@ -220,12 +780,48 @@ static void xd_update_current_job() {
 // ========================
 
 void xd_jobs_init() {
-  xd_jobs =
-      xd_list_create(xd_job_copy_func, xd_job_destroy_func, xd_job_comp_func);
+  xd_sigchld_pipe_open();
+  xd_jobs = (xd_job_slot_t *)calloc(XD_JOBS_DEF_CAP, sizeof(xd_job_slot_t));
+  if (xd_jobs == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  xd_jobs_capacity = XD_JOBS_DEF_CAP;
+  xd_pid_index = xd_map_create(
+      xd_pid_key_copy_func, xd_pid_key_destroy_func, xd_pid_key_comp_func,
+      xd_pid_entry_copy_func, xd_pid_entry_destroy_func, xd_pid_entry_comp_func,
+      xd_pid_key_hash_func);
 }  // xd_jobs_init()
 
 void xd_jobs_destroy() {
-  xd_list_destroy(xd_jobs);
+  int pipe_fd[2] = {xd_sigchld_pipe[0], xd_sigchld_pipe[1]};
+  xd_sigchld_pipe[0] = -1;
+  xd_sigchld_pipe[1] = -1;
+  close(pipe_fd[0]);
+  close(pipe_fd[1]);
+
+  xd_map_destroy(xd_pid_index);
+  xd_pid_index = NULL;
+  if (xd_jobs == NULL) {
+    return;
+  }
+  for (int i = 0; i < xd_jobs_max_id; i++) {
+    xd_job_destroy(xd_jobs[i].job);
+  }
+  free(xd_jobs);
+  xd_jobs = NULL;
+  xd_dirty_head = 0;
+  xd_dirty_tail = 0;
+  xd_jobs_capacity = 0;
+  xd_jobs_max_id = 0;
+  xd_jobs_count = 0;
+  free(xd_free_ids);
+  xd_free_ids = NULL;
+  xd_free_ids_length = 0;
+  xd_free_ids_capacity = 0;
+  memset(xd_saved_statuses, 0, sizeof(xd_saved_statuses));
+  xd_saved_statuses_next = 0;
 }  // xd_jobs_destroy()
 
 void xd_jobs_add(xd_job_t *job) {
@@ -233,40 +829,93 @@ void xd_jobs_add(xd_job_t *job) {
     return;
   }
 
-  int job_id = 1;
-  if (xd_jobs->length > 0) {
-    job_id = ((xd_job_t *)xd_jobs->tail->data)->job_id + 1;
+  int job_id = xd_free_ids_pop();
+  if (job_id == 0) {
+    job_id = ++xd_jobs_max_id;
   }
+  if (job_id > xd_jobs_capacity) {
+    int new_capacity = xd_jobs_capacity * 2;
+    xd_job_slot_t *ptr =
+        (xd_job_slot_t *)realloc(xd_jobs, sizeof(xd_job_slot_t) * new_capacity);
+    if (ptr == NULL) {
+      fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+              strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+    memset(ptr + xd_jobs_capacity, 0,
+           sizeof(xd_job_slot_t) * (new_capacity - xd_jobs_capacity));
+    xd_jobs = ptr;
+    xd_jobs_capacity = new_capacity;
+  }
+
   job->job_id = job_id;
-  xd_list_add_last(xd_jobs, job);
+  xd_jobs[job_id - 1].job = job;
+  xd_jobs_count++;
+  xd_pid_index_add_job(job);
+  xd_recency_touch(job);
 }  // xd_jobs_add()
 
 xd_job_t *xd_jobs_get_with_pid(pid_t pid) {
-  if (xd_jobs == NULL) {
+  xd_job_t *job = NULL;
+  xd_jobs_get_command_with_pid(pid, &job);
+  return job;
+}  // xd_jobs_get_with_pid()
+
+xd_command_t *xd_jobs_get_command_with_pid(pid_t pid, xd_job_t **job) {
+  if (job != NULL) {
+    *job = NULL;
+  }
+  if (xd_pid_index == NULL || pid <= 0) {
     return NULL;
   }
 
-  for (xd_list_node_t *node = xd_jobs->head; node != NULL; node = node->next) {
-    xd_job_t *job = node->data;
-    if (xd_job_get_command_with_pid(job, pid) != NULL) {
-      return job;
-    }
+  xd_pid_entry_t *entry = xd_map_get(xd_pid_index, (void *)(intptr_t)pid);
+  if (entry == NULL) {
+    return NULL;
   }
-  return NULL;
-}  // xd_jobs_get_with_pid()
+  if (job != NULL) {
+    *job = entry->job;
+  }
+  return entry->command;
+}  // xd_jobs_get_command_with_pid()
 
-xd_job_t *xd_jobs_get_with_id(int job_id) {
-  if (xd_jobs == NULL) {
-    return NULL;
+int xd_jobs_collect_pid_status(pid_t pid, int *wait_status) {
+  if (pid <= 0) {
+    return -1;
+  }
+  xd_saved_status_t *saved = xd_saved_status_find(pid, 0);
+  if (saved == NULL) {
+    return -1;
   }
+  *wait_status = saved->wait_status;
+  saved->pid = 0;
+  return 0;
+}  // xd_jobs_collect_pid_status()
 
-  for (xd_list_node_t *node = xd_jobs->head; node != NULL; node = node->next) {
-    xd_job_t *job = node->data;
-    if (job->job_id == job_id) {
-      return job;
+int xd_jobs_collect_job_status(int job_id, int *wait_status) {
+  if (job_id <= 0) {
+    return -1;
+  }
+  xd_saved_status_t *saved = xd_saved_status_find(0, job_id);
+  if (saved == NULL) {
+    return -1;
+  }
+  *wait_status = saved->job_wait_status;
+  unsigned int serial = saved->serial;
+  for (int i = 0; i < XD_JOBS_SAVED_STATUSES_MAX; i++) {
+    if (xd_saved_statuses[i].serial == serial) {
+      xd_saved_statuses[i].pid = 0;
+      xd_saved_statuses[i].job_id = 0;
     }
   }
-  return NULL;
+  return 0;
+}  // xd_jobs_collect_job_status()
+
+xd_job_t *xd_jobs_get_with_id(int job_id) {
+  if (xd_jobs == NULL || job_id <= 0 || job_id > xd_jobs_max_id) {
+    return NULL;
+  }
+  return xd_jobs[job_id - 1].job;
 }  // xd_jobs_get_with_id()
 
 xd_job_t *xd_jobs_get_current() {
@@ -283,13 +932,36 @@ xd_job_t *xd_jobs_get_previous() {
   return xd_previous_job;
 }  // xd_jobs_get_previous()
 
-void xd_jobs_print_status_all(int detailed, int print_pids) {
+int xd_jobs_get_count() {
+  return xd_jobs_count;
+}  // xd_jobs_get_count()
+
+int xd_jobs_get_all(xd_job_t **jobs) {
+  int count = 0;
+  for (int job_id = 1; job_id <= xd_jobs_max_id; job_id++) {
+    xd_job_t *job = xd_jobs[job_id - 1].job;
+    if (job != NULL) {
+      jobs[count++] = job;
+    }
+  }
+  return count;
+}  // xd_jobs_get_all()
+
+void xd_jobs_print_status_all(int detailed, int print_pids, int verbose) {
   if (xd_jobs == NULL) {
     return;
   }
 
-  for (xd_list_node_t *node = xd_jobs->head; node != NULL; node = node->next) {
-    xd_job_t *job = node->data;
+  struct timespec time_spec;
+  clock_gettime(CLOCK_MONOTONIC, &time_spec);
+  uint64_t now = (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
+                 (uint64_t)time_spec.tv_nsec;
+
+  for (int job_id = 1; job_id <= xd_jobs_max_id; job_id++) {
+    xd_job_t *job = xd_jobs[job_id - 1].job;
+    if (job == NULL) {
+      continue;
+    }
     char marker = ' ';
     if (job == xd_current_job) {
       marker = '+';
@@ -298,6 +970,9 @@ void xd_jobs_print_status_all(int detailed, int print_pids) {
       marker = '-';
     }
     xd_job_print_status(job, marker, detailed, print_pids);
+    if (verbose) {
+      xd_job_print_usage(job, now, stdout);
+    }
     job->notify = 0;
   }
 }  // xd_jobs_print_status_all()
@@ -306,6 +981,10 @@ void xd_jobs_refresh() {
   if (xd_jobs == NULL) {
     return;
   }
+  xd_jobs_reap();
+  if (xd_dirty_head == 0) {
+    return;  // no job was active since the last refresh
+  }
   if (xd_sh_is_interactive) {
     xd_notify_status_change();
   }
@@ -313,6 +992,20 @@ void xd_jobs_refresh() {
   xd_update_current_job();
 }  // xd_jobs_refresh()
 
+int xd_jobs_has_notifications() {
+  if (xd_jobs == NULL) {
+    return 0;
+  }
+  for (int job_id = xd_dirty_head; job_id != 0;
+       job_id = xd_jobs[job_id - 1].dirty_next) {
+    xd_job_t *job = xd_jobs[job_id - 1].job;
+    if (job != NULL && job->notify) {
+      return 1;
+    }
+  }
+  return 0;
+}  // xd_jobs_has_notifications()
+
 int xd_jobs_put_in_foreground(pid_t pgid) {
   if (!xd_sh_is_interactive) {
     return -1;
@@ -346,61 +1039,27 @@ int xd_jobs_wait(xd_job_t *job) {
     return EXIT_FAILURE;
   }
 
-  int status;
+  xd_update_job(job);
   while (xd_job_is_alive(job) && !xd_job_is_stopped(job)) {
-    for (int i = 0; i < job->command_count; i++) {
-      xd_command_t *command = job->commands[i];
-      pid_t pid = command->pid;
-      if (pid == 0) {
-        continue;  // failure before fork in xd_job_executor()
-      }
-
-      pid_t ret = waitpid(pid, &status, WUNTRACED | WCONTINUED);
-      if (ret <= 0) {
-        if (ret < 0 && errno == EINTR) {
-          i--;
+    if (xd_jobs_poll(&job, 1, -1) == -1 && errno != EINTR) {
+      // can't poll, block on the first running process instead
+      for (int i = 0; i < job->command_count; i++) {
+        xd_command_t *command = job->commands[i];
+        if (xd_is_reaped(command)) {
+          continue;
         }
-        continue;
-      }
-
-      int was_stopped = WIFSTOPPED(command->wait_status);
-      command->wait_status = status;
-      job->wait_status = status;
-
-      if (WIFCONTINUED(status)) {
-        if (was_stopped) {
-          job->stopped_count--;
-        }
-      }
-      else if (WIFSTOPPED(status)) {
-        if (!was_stopped) {
-          job->stopped_count++;
+        int status;
+        struct rusage rusage;
+        if (wait4(command->pid, &status, WUNTRACED | WCONTINUED, &rusage) > 0) {
+          xd_update_status(job, command, status, &rusage);
         }
-      }
-      else if (WIFEXITED(status) || WIFSIGNALED(status)) {
-        if (was_stopped) {
-          job->stopped_count--;
-        }
-        job->unreaped_count--;
+        break;
       }
     }
+    xd_update_job(job);
   }
 
-  struct timespec time_spec;
-  clock_gettime(CLOCK_MONOTONIC, &time_spec);
-  job->last_active = (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
-                     (uint64_t)time_spec.tv_nsec;
-
-  int exit_code = EXIT_SUCCESS;
-  if (WIFEXITED(job->wait_status)) {
-    exit_code = WEXITSTATUS(job->wait_status);
-  }
-  else if (WIFSIGNALED(job->wait_status)) {
-    exit_code = XD_SH_EXIT_CODE_SIGNAL_OFFSET + WTERMSIG(job->wait_status);
-  }
-  else if (WIFSTOPPED(job->wait_status)) {
-    exit_code = XD_SH_EXIT_CODE_SIGNAL_OFFSET + WSTOPSIG(job->wait_status);
-  }
+  int exit_code = xd_jobs_exit_code(job->wait_status);
 
   if (!xd_sh_is_interactive) {
     return exit_code;
@@ -422,15 +1081,142 @@ int xd_jobs_wait(xd_job_t *job) {
   return exit_code;
 }  // xd_jobs_wait()
 
+int xd_jobs_wait_any(xd_job_t **jobs, xd_command_t **commands, int count,
+                     int timeout_ms) {
+  struct timespec time_spec;
+  uint64_t deadline = 0;
+  if (timeout_ms >= 0) {
+    clock_gettime(CLOCK_MONOTONIC, &time_spec);
+    deadline = (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
+               (uint64_t)time_spec.tv_nsec +
+               ((uint64_t)timeout_ms * XD_JOBS_NANOSECONDS_PER_MILLISECOND);
+  }
+
+  while (1) {
+    for (int i = 0; i < count; i++) {
+      xd_update_job(jobs[i]);
+    }
+    for (int i = 0; i < count; i++) {
+      xd_job_t *job = jobs[i];
+      xd_command_t *command = commands != NULL ? commands[i] : NULL;
+      if (xd_job_is_stopped(job) ||
+          (command != NULL ? xd_is_reaped(command) : !xd_job_is_alive(job))) {
+        return i;
+      }
+    }
+
+    int remaining_ms = -1;
+    if (timeout_ms >= 0) {
+      clock_gettime(CLOCK_MONOTONIC, &time_spec);
+      uint64_t now =
+          (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
+          (uint64_t)time_spec.tv_nsec;
+      if (now >= deadline) {
+        errno = ETIMEDOUT;
+        return -1;
+      }
+      // round up, so the wait never ends before the deadline
+      uint64_t remaining_ns =
+          deadline - now + XD_JOBS_NANOSECONDS_PER_MILLISECOND - 1;
+      remaining_ms = (int)(remaining_ns / XD_JOBS_NANOSECONDS_PER_MILLISECOND);
+    }
+
+    if (xd_jobs_poll(jobs, count, remaining_ms) == -1) {
+      if (errno != EINTR) {
+        return -1;
+      }
+      if (xd_sh_is_interrupted) {
+        return -1;
+      }
+    }
+  }
+}  // xd_jobs_wait_any()
+
+int xd_jobs_exit_code(int wait_status) {
+  if (WIFEXITED(wait_status)) {
+    return WEXITSTATUS(wait_status);
+  }
+  if (WIFSIGNALED(wait_status)) {
+    return XD_SH_EXIT_CODE_SIGNAL_OFFSET + WTERMSIG(wait_status);
+  }
+  if (WIFSTOPPED(wait_status)) {
+    return XD_SH_EXIT_CODE_SIGNAL_OFFSET + WSTOPSIG(wait_status);
+  }
+  return EXIT_SUCCESS;
+}  // xd_jobs_exit_code()
+
+void xd_jobs_report_times(xd_job_t *job) {
+  if (job == NULL || job->time_mode == XD_JOB_TIME_NONE) {
+    return;
+  }
+
+  const char *format = XD_JOB_POSIX_TIMEFORMAT;
+  if (job->time_mode == XD_JOB_TIME_DEFAULT) {
+    format = xd_vars_get("TIMEFORMAT");
+    if (format == NULL) {
+      format = XD_JOB_DEF_TIMEFORMAT;
+    }
+  }
+  fflush(stdout);
+  xd_job_print_times(job, format, stderr);
+  job->time_mode = XD_JOB_TIME_NONE;
+}  // xd_jobs_report_times()
+
 void xd_jobs_wait_non_blocking(xd_job_t *job) {
   if (job == NULL) {
     return;
   }
+  xd_update_job(job);
+
+  struct timespec time_spec;
+  clock_gettime(CLOCK_MONOTONIC, &time_spec);
+  job->last_active = (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
+                     (uint64_t)time_spec.tv_nsec;
+  xd_recency_touch(job);
+}  // xd_jobs_wait_non_blocking()
+
+void xd_jobs_sigchld_notify() {
+  xd_sigchld_pending = 1;
+  if (xd_sigchld_pipe[1] != -1) {
+    char chr = 0;
+    write(xd_sigchld_pipe[1], &chr, 1);
+  }
+}  // xd_jobs_sigchld_notify()
+
+int xd_jobs_sigchld_fd() {
+  return xd_sigchld_pipe[0];
+}  // xd_jobs_sigchld_fd()
+
+void xd_jobs_sigchld_reopen() {
+  if (xd_sigchld_pipe[0] == -1) {
+    return;
+  }
+  int pipe_fd[2] = {xd_sigchld_pipe[0], xd_sigchld_pipe[1]};
+  xd_sigchld_pipe[0] = -1;
+  xd_sigchld_pipe[1] = -1;
+  close(pipe_fd[0]);
+  close(pipe_fd[1]);
+  xd_sigchld_pending = 0;
+  xd_sigchld_pipe_open();
+}  // xd_jobs_sigchld_reopen()
+
+void xd_jobs_reap() {
+  if (!xd_sigchld_pending) {
+    return;
+  }
+  xd_sigchld_pending = 0;
+
+  // drain the self-pipe
+  char buf[64];
+  while (read(xd_sigchld_pipe[0], buf, sizeof(buf)) > 0) {
+    continue;
+  }
 
   int status;
+  struct rusage rusage;
   pid_t pid;
   while (1) {
-    pid = waitpid(-job->pgid, &status, WNOHANG | WUNTRACED | WCONTINUED);
+    pid = wait4(-1, &status, WNOHANG | WUNTRACED | WCONTINUED, &rusage);
     if (pid <= 0) {
       if (pid == -1 && errno == EINTR) {
         continue;
@@ -438,61 +1224,52 @@ void xd_jobs_wait_non_blocking(xd_job_t *job) {
       break;
     }
 
-    xd_command_t *command = xd_job_get_command_with_pid(job, pid);
-    if (command == NULL) {
+    xd_job_t *job = NULL;
+    xd_command_t *command = xd_jobs_get_command_with_pid(pid, &job);
+    if (job == NULL || command == NULL) {
       continue;
     }
 
-    int was_stopped = WIFSTOPPED(command->wait_status);
-    command->wait_status = status;
-
-    if (job->commands[job->command_count - 1] == command) {
-      job->wait_status = status;
+    xd_update_status(job, command, status, &rusage);
+    if (!xd_job_is_alive(job) || xd_job_is_stopped(job)) {
+      job->notify = 1;
     }
+  }
+}  // xd_jobs_reap()
 
-    if (WIFCONTINUED(status)) {
-      if (was_stopped) {
-        job->stopped_count--;
-      }
-    }
-    else if (WIFSTOPPED(status)) {
-      if (!was_stopped) {
-        job->stopped_count++;
-      }
-    }
-    else if (WIFEXITED(status) || WIFSIGNALED(status)) {
-      if (was_stopped) {
-        job->stopped_count--;
+int xd_jobs_poll(xd_job_t **jobs, int job_count, int timeout_ms) {
+  struct pollfd fds[XD_JOBS_POLL_FDS_MAX + 1];
+  int nfds = 0;
+  if (xd_sigchld_pipe[0] != -1) {
+    fds[nfds].fd = xd_sigchld_pipe[0];
+    fds[nfds].events = POLLIN;
+    nfds++;
+  }
+  for (int i = 0; i < job_count; i++) {
+    xd_job_t *job = jobs[i];
+    for (int j = 0; j < job->command_count; j++) {
+      xd_command_t *command = job->commands[j];
+      if (command->pidfd == -1 || xd_is_reaped(command) ||
+          nfds == XD_JOBS_POLL_FDS_MAX + 1) {
+        continue;
       }
-      job->unreaped_count--;
+      fds[nfds].fd = command->pidfd;
+      fds[nfds].events = POLLIN;
+      nfds++;
     }
   }
 
-  struct timespec time_spec;
-  clock_gettime(CLOCK_MONOTONIC, &time_spec);
-  job->last_active = (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
-                     (uint64_t)time_spec.tv_nsec;
-}  // xd_jobs_wait_non_blocking()
-
-void xd_jobs_sigchld_block() {
-  if (xd_sigchld_block_count == 0) {
-    sigset_t mask;
-    sigemptyset(&mask);
-    sigaddset(&mask, SIGCHLD);
-    sigprocmask(SIG_BLOCK, &mask, NULL);
+  int ret = poll(fds, nfds, timeout_ms);
+  if (ret <= 0) {
+    return ret;
   }
-  xd_sigchld_block_count++;
-}  // xd_jobs_sigchld_block()
 
-void xd_jobs_sigchld_unblock() {
-  if (xd_sigchld_block_count > 0) {
-    xd_sigchld_block_count--;
-
-    if (xd_sigchld_block_count == 0) {
-      sigset_t mask;
-      sigemptyset(&mask);
-      sigaddset(&mask, SIGCHLD);
-      sigprocmask(SIG_UNBLOCK, &mask, NULL);
+  // drain the self-pipe, `xd_sigchld_pending` is left for `xd_jobs_reap()`
+  if (xd_sigchld_pipe[0] != -1 && fds[0].revents != 0) {
+    char buf[64];
+    while (read(xd_sigchld_pipe[0], buf, sizeof(buf)) > 0) {
+      continue;
     }
   }
-}  // xd_jobs_sigchld_unblock()
+  return 1;
+}  // xd_jobs_poll()
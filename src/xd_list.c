@@ -15,13 +15,23 @@
 
 #include "xd_list.h"
 
-#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "xd_alloc.h"
 #include "xd_generic_funcs.h"
 
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Maximum number of freed nodes kept in the pool for reuse, nodes freed
+ * while the pool is full are returned to the allocator.
+ */
+#define XD_LIST_POOL_MAX (1024)
+
 // ========================
 // Function Declarations
 // ========================
@@ -31,6 +41,21 @@ static xd_list_node_t *xd_list_node_create(void *data,
 static void xd_list_node_destroy(xd_list_node_t *node,
                                  xd_gens_destroy_func_t destroy_func);
 
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief Pool of freed nodes linked through their `next` pointers, nodes are
+ * taken from it before allocating new ones.
+ */
+static xd_list_node_t *xd_list_pool = NULL;
+
+/**
+ * @brief Number of nodes in `xd_list_pool`.
+ */
+static int xd_list_pool_length = 0;
+
 // ========================
 // Function Definitions
 // ========================
@@ -39,7 +64,7 @@ static void xd_list_node_destroy(xd_list_node_t *node,
  * @brief Creates and initializes a new `xd_list_node_t` structure.
  *
  * @param copy_func A pointer to the function used to create a copy of the
- * passed data.
+ * passed data, or `NULL` to store the passed pointer itself.
  * @param data A pointer to the data to be copied and stored in the node.
  *
  * @return A pointer to the newly created `xd_list_node_t`.
@@ -51,13 +76,16 @@ static void xd_list_node_destroy(xd_list_node_t *node,
  */
 static xd_list_node_t *xd_list_node_create(void *data,
                                            xd_gens_copy_func_t copy_func) {
-  xd_list_node_t *node = (xd_list_node_t *)malloc(sizeof(xd_list_node_t));
-  if (node == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
+  xd_list_node_t *node = xd_list_pool;
+  if (node != NULL) {
+    xd_list_pool = node->next;
+    xd_list_pool_length--;
   }
-  node->data = copy_func(data);
+  else {
+    node = (xd_list_node_t *)xd_alloc_malloc(XD_ALLOC_LIST,
+                                             sizeof(xd_list_node_t));
+  }
+  node->data = copy_func != NULL ? copy_func(data) : data;
   node->prev = node->next = NULL;
   return node;
 }  // xd_list_node_create()
@@ -67,7 +95,7 @@ static xd_list_node_t *xd_list_node_create(void *data,
  *
  * @param node A pointer to the `xd_list_node_t` to be freed.
  * @param destroy_func A pointer to the function used to free the data stored in
- * the node.
+ * the node, or `NULL` if the data is not owned by the node.
  *
  * @note If the passed node pointer is `NULL` no action shall occur.
  */
@@ -76,8 +104,17 @@ static void xd_list_node_destroy(xd_list_node_t *node,
   if (node == NULL) {
     return;
   }
-  destroy_func(node->data);
-  free(node);
+  if (destroy_func != NULL) {
+    destroy_func(node->data);
+  }
+  if (xd_list_pool_length >= XD_LIST_POOL_MAX) {
+    xd_alloc_free(XD_ALLOC_LIST, node);
+    return;
+  }
+  node->data = NULL;
+  node->next = xd_list_pool;
+  xd_list_pool = node;
+  xd_list_pool_length++;
 }  // xd_list_node_destroy()
 
 // ========================
@@ -90,12 +127,8 @@ xd_list_t *xd_list_create(xd_gens_copy_func_t copy_func,
   if (copy_func == NULL || destroy_func == NULL || comp_func == NULL) {
     return NULL;
   }
-  xd_list_t *list = (xd_list_t *)malloc(sizeof(xd_list_t));
-  if (list == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_list_t *list =
+      (xd_list_t *)xd_alloc_malloc(XD_ALLOC_LIST, sizeof(xd_list_t));
   list->copy_func = copy_func;
   list->destroy_func = destroy_func;
   list->comp_func = comp_func;
@@ -104,12 +137,26 @@ xd_list_t *xd_list_create(xd_gens_copy_func_t copy_func,
   return list;
 }  // xd_list_create()
 
+xd_list_t *xd_list_create_borrowed(xd_gens_comp_func_t comp_func) {
+  if (comp_func == NULL) {
+    return NULL;
+  }
+  xd_list_t *list =
+      (xd_list_t *)xd_alloc_malloc(XD_ALLOC_LIST, sizeof(xd_list_t));
+  list->copy_func = NULL;
+  list->destroy_func = NULL;
+  list->comp_func = comp_func;
+  list->length = 0;
+  list->head = list->tail = NULL;
+  return list;
+}  // xd_list_create_borrowed()
+
 void xd_list_destroy(xd_list_t *list) {
   if (list == NULL) {
     return;
   }
   xd_list_clear(list);
-  free(list);
+  xd_alloc_free(XD_ALLOC_LIST, list);
 }  // xd_list_destroy()
 
 void xd_list_clear(xd_list_t *list) {
@@ -278,3 +325,12 @@ void *xd_list_get_node(xd_list_t *list, int index) {
   }
   return curr;
 }  // xd_list_get_node()
+
+void xd_list_pool_clear() {
+  while (xd_list_pool != NULL) {
+    xd_list_node_t *node = xd_list_pool;
+    xd_list_pool = node->next;
+    xd_alloc_free(XD_ALLOC_LIST, node);
+  }
+  xd_list_pool_length = 0;
+}  // xd_list_pool_clear()
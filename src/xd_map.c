@@ -21,6 +21,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "xd_alloc.h"
 #include "xd_list.h"
 
 // ========================
@@ -47,14 +48,12 @@
 // ========================
 
 static xd_bucket_entry_t *xd_bucket_entry_create(
-    void *key, void *value, xd_gens_copy_func_t copy_key_func,
-    xd_gens_copy_func_t copy_value_func);
+    void *key, void *value, unsigned int hash,
+    xd_gens_copy_func_t copy_key_func, xd_gens_copy_func_t copy_value_func);
 static void xd_bucket_entry_destroy(xd_bucket_entry_t *entry,
                                     xd_gens_destroy_func_t destroy_key_func,
                                     xd_gens_destroy_func_t destroy_value_func);
 
-static void *xd_bucket_list_copy_func(void *data);
-static void xd_bucket_list_destroy_func(void *data);
 static int xd_bucket_list_comp_func(const void *data1, const void *data2);
 
 static int xd_util_is_prime(int num);
@@ -72,6 +71,7 @@ static void xd_map_rehash(xd_map_t *map);
  *
  * @param key A pointer to the key.
  * @param value A pointer to the value.
+ * @param hash The hash of the key.
  * @param copy_key_func A pointer to the function used to copy the key.
  * @param copy_value_func A pointer to the function used to copy the value.
  *
@@ -83,17 +83,14 @@ static void xd_map_rehash(xd_map_t *map);
  * calling `xd_bucket_entry_destroy()` and passing it the returned pointer.
  */
 static xd_bucket_entry_t *xd_bucket_entry_create(
-    void *key, void *value, xd_gens_copy_func_t copy_key_func,
-    xd_gens_copy_func_t copy_value_func) {
+    void *key, void *value, unsigned int hash,
+    xd_gens_copy_func_t copy_key_func, xd_gens_copy_func_t copy_value_func) {
   xd_bucket_entry_t *entry =
-      (xd_bucket_entry_t *)malloc(sizeof(xd_bucket_entry_t));
-  if (entry == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+      (xd_bucket_entry_t *)xd_alloc_malloc(XD_ALLOC_MAP,
+                                           sizeof(xd_bucket_entry_t));
   entry->key = copy_key_func(key);
   entry->value = copy_value_func(value);
+  entry->hash = hash;
   return entry;
 }  // xd_bucket_entry_create()
 
@@ -117,25 +114,11 @@ static void xd_bucket_entry_destroy(xd_bucket_entry_t *entry,
   }
   destroy_key_func(entry->key);
   destroy_value_func(entry->value);
-  free(entry);
+  xd_alloc_free(XD_ALLOC_MAP, entry);
 }  // xd_bucket_entry_destroy()
 
 /**
- * @brief Passed to `xd_list_create()` as copy function.
- */
-static void *xd_bucket_list_copy_func(void *data) {
-  return data;
-}  // xd_bucket_list_copy_func()
-
-/**
- * @brief Passed to `xd_list_create()` as destroy function.
- */
-static void xd_bucket_list_destroy_func(void *data) {
-  (void)data;
-}  // xd_bucket_list_destroy_func()
-
-/**
- * @brief Passed to `xd_list_create()` as comp function.
+ * @brief Passed to `xd_list_create_borrowed()` as comp function.
  */
 static int xd_bucket_list_comp_func(const void *data1, const void *data2) {
   (void)data1;
@@ -218,7 +201,8 @@ static int xd_util_prev_prime(int num) {
  *
  * If load factor >= `XD_MAP_MAX_LOAD_FACTOR`, grows the map.
  * If load factor <= `XD_MAP_MIN_LOAD_FACTOR`, shrinks the map.
- * Uses prime bucket counts and rehashes all entries.
+ * Uses prime bucket counts and redistributes all entries by their cached
+ * hashes, so keys are never hashed again.
  *
  * @param map The map to be rehashed.
  */
@@ -239,16 +223,10 @@ static void xd_map_rehash(xd_map_t *map) {
 
   // create the new array of buckets
   xd_list_t **new_buckets =
-      (xd_list_t **)malloc(sizeof(xd_list_t *) * new_bucket_count);
-  if (new_buckets == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+      (xd_list_t **)xd_alloc_malloc(XD_ALLOC_MAP,
+                                    sizeof(xd_list_t *) * new_bucket_count);
   for (int i = 0; i < new_bucket_count; i++) {
-    new_buckets[i] =
-        xd_list_create(xd_bucket_list_copy_func, xd_bucket_list_destroy_func,
-                       xd_bucket_list_comp_func);
+    new_buckets[i] = xd_list_create_borrowed(xd_bucket_list_comp_func);
   }
 
   // re-hash and add the entries from the old buckets to the new buckets
@@ -256,12 +234,11 @@ static void xd_map_rehash(xd_map_t *map) {
     xd_list_t *bucket = map->buckets[i];
     for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
       xd_bucket_entry_t *entry = node->data;
-      unsigned int hash = map->hash_func(entry->key) % new_bucket_count;
-      xd_list_add_last(new_buckets[hash], entry);
+      xd_list_add_last(new_buckets[entry->hash % new_bucket_count], entry);
     }
     xd_list_destroy(bucket);
   }
-  free((void *)map->buckets);
+  xd_alloc_free(XD_ALLOC_MAP, (void *)map->buckets);
 
   // update the map buckets to point to the new one
   map->buckets = new_buckets;
@@ -284,24 +261,14 @@ xd_map_t *xd_map_create(xd_gens_copy_func_t copy_key_func,
       comp_key_func == NULL || comp_value_func == NULL || hash_func == NULL) {
     return NULL;
   }
-  xd_map_t *map = (xd_map_t *)malloc(sizeof(xd_map_t));
-  if (map == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_map_t *map =
+      (xd_map_t *)xd_alloc_malloc(XD_ALLOC_MAP, sizeof(xd_map_t));
   map->bucket_count = XD_MAP_MIN_BUCKET_COUNT;
   map->entry_count = 0;
-  map->buckets = (xd_list_t **)malloc(sizeof(xd_list_t *) * map->bucket_count);
-  if (map->buckets == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  map->buckets = (xd_list_t **)xd_alloc_malloc(
+      XD_ALLOC_MAP, sizeof(xd_list_t *) * map->bucket_count);
   for (int i = 0; i < map->bucket_count; i++) {
-    map->buckets[i] =
-        xd_list_create(xd_bucket_list_copy_func, xd_bucket_list_destroy_func,
-                       xd_bucket_list_comp_func);
+    map->buckets[i] = xd_list_create_borrowed(xd_bucket_list_comp_func);
   }
   map->copy_key_func = copy_key_func;
   map->copy_value_func = copy_value_func;
@@ -325,8 +292,8 @@ void xd_map_destroy(xd_map_t *map) {
     }
     xd_list_destroy(bucket);
   }
-  free((void *)map->buckets);
-  free(map);
+  xd_alloc_free(XD_ALLOC_MAP, (void *)map->buckets);
+  xd_alloc_free(XD_ALLOC_MAP, map);
 }  // xd_map_destroy()
 
 void xd_map_clear(xd_map_t *map) {
@@ -337,16 +304,10 @@ void xd_map_clear(xd_map_t *map) {
   // create the new array of buckets
   int new_bucket_count = XD_MAP_MIN_BUCKET_COUNT;
   xd_list_t **new_buckets =
-      (xd_list_t **)malloc(sizeof(xd_list_t *) * new_bucket_count);
-  if (new_buckets == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+      (xd_list_t **)xd_alloc_malloc(XD_ALLOC_MAP,
+                                    sizeof(xd_list_t *) * new_bucket_count);
   for (int i = 0; i < new_bucket_count; i++) {
-    new_buckets[i] =
-        xd_list_create(xd_bucket_list_copy_func, xd_bucket_list_destroy_func,
-                       xd_bucket_list_comp_func);
+    new_buckets[i] = xd_list_create_borrowed(xd_bucket_list_comp_func);
   }
 
   // remove old buckets and their entries
@@ -358,7 +319,7 @@ void xd_map_clear(xd_map_t *map) {
     }
     xd_list_destroy(bucket);
   }
-  free((void *)map->buckets);
+  xd_alloc_free(XD_ALLOC_MAP, (void *)map->buckets);
 
   // update the map buckets to point to the new one
   map->buckets = new_buckets;
@@ -370,16 +331,17 @@ void xd_map_put(xd_map_t *map, void *key, void *value) {
   if (map == NULL) {
     return;
   }
-  unsigned int hash = map->hash_func(key) % map->bucket_count;
-  xd_list_t *bucket = map->buckets[hash];
+  unsigned int hash = map->hash_func(key);
+  xd_list_t *bucket = map->buckets[hash % map->bucket_count];
   xd_bucket_entry_t *new_entry = xd_bucket_entry_create(
-      key, value, map->copy_key_func, map->copy_value_func);
+      key, value, hash, map->copy_key_func, map->copy_value_func);
   xd_bucket_entry_t *old_entry = NULL;
 
   // update old entry
   for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
     old_entry = node->data;
-    if (map->comp_key_func(old_entry->key, new_entry->key) == 0) {
+    if (old_entry->hash == hash &&
+        map->comp_key_func(old_entry->key, new_entry->key) == 0) {
       node->data = new_entry;
       xd_bucket_entry_destroy(old_entry, map->destroy_key_func,
                               map->destroy_value_func);
@@ -397,11 +359,11 @@ int xd_map_remove(xd_map_t *map, void *key) {
   if (map == NULL) {
     return -1;
   }
-  unsigned int hash = map->hash_func(key) % map->bucket_count;
-  xd_list_t *bucket = map->buckets[hash];
+  unsigned int hash = map->hash_func(key);
+  xd_list_t *bucket = map->buckets[hash % map->bucket_count];
   for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
     xd_bucket_entry_t *entry = node->data;
-    if (map->comp_key_func(entry->key, key) == 0) {
+    if (entry->hash == hash && map->comp_key_func(entry->key, key) == 0) {
       xd_bucket_entry_destroy(entry, map->destroy_key_func,
                               map->destroy_value_func);
       xd_list_remove_node(bucket, node);
@@ -417,11 +379,11 @@ void *xd_map_get(xd_map_t *map, void *key) {
   if (map == NULL) {
     return NULL;
   }
-  unsigned int hash = map->hash_func(key) % map->bucket_count;
-  xd_list_t *bucket = map->buckets[hash];
+  unsigned int hash = map->hash_func(key);
+  xd_list_t *bucket = map->buckets[hash % map->bucket_count];
   for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
     xd_bucket_entry_t *entry = node->data;
-    if (map->comp_key_func(entry->key, key) == 0) {
+    if (entry->hash == hash && map->comp_key_func(entry->key, key) == 0) {
       return entry->value;
     }
   }
@@ -432,12 +394,12 @@ int xd_map_contains_key(xd_map_t *map, void *key) {
   if (map == NULL) {
     return 0;
   }
-  unsigned int hash = map->hash_func(key) % map->bucket_count;
-  xd_list_t *bucket = map->buckets[hash];
+  unsigned int hash = map->hash_func(key);
+  xd_list_t *bucket = map->buckets[hash % map->bucket_count];
 
   for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
     xd_bucket_entry_t *entry = node->data;
-    if (map->comp_key_func(entry->key, key) == 0) {
+    if (entry->hash == hash && map->comp_key_func(entry->key, key) == 0) {
       return 1;
     }
   }
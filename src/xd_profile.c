@@ -0,0 +1,333 @@
+/*
+ * ==============================================================================
+ * File: xd_profile.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_profile.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "xd_job.h"
+#include "xd_map.h"
+#include "xd_shell.h"
+#include "xd_utils.h"
+#include "xd_vars.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Number of nanoseconds in one millisecond.
+ */
+#define XD_PROFILE_NANOSECONDS_PER_MILLISECOND (1000000.0)
+
+/**
+ * @brief Number of nanoseconds in one microsecond.
+ */
+#define XD_PROFILE_NANOSECONDS_PER_MICROSECOND ((uint64_t)1000)
+
+/**
+ * @brief Format of the default report path, formatted with the shell's PID.
+ */
+#define XD_PROFILE_DEF_PATH_FORMAT "xd-shell.%d.profile"
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Represents the accumulated times of a source location.
+ */
+typedef struct xd_profile_entry_t {
+  char *location;           // Source location (`name:line[;name:line...]`)
+  int count;                // Number of jobs run from the location
+  uint64_t total_time;      // Wall time: parse, expansion and execution
+  uint64_t parse_time;      // Time spent parsing, without expansion
+  uint64_t expansion_time;  // Time spent expanding arguments
+  uint64_t spawn_time;      // Time spent forking the processes
+  uint64_t wait_time;       // Time spent waiting in foreground
+  uint64_t cpu_time;        // User and system time of the processes
+} xd_profile_entry_t;
+
+// ========================
+// Function Declarations
+// ========================
+
+static void *xd_profile_entry_copy_func(void *data);
+static void xd_profile_entry_destroy_func(void *data);
+static int xd_profile_entry_comp_func(const void *data1, const void *data2);
+static int xd_profile_entry_sort_func(const void *data1, const void *data2);
+
+static xd_map_t *xd_profile_map_create();
+static xd_profile_entry_t *xd_profile_get_entry(xd_map_t *map,
+                                                const char *location);
+static void xd_profile_add(xd_profile_entry_t *entry, const xd_job_t *job,
+                           uint64_t total_time, uint64_t cpu_time);
+static void xd_profile_write_report(const char *path);
+static void xd_profile_write_folded(const char *path);
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief Profiled times of each source line.
+ */
+static xd_map_t *xd_profile_lines = NULL;
+
+/**
+ * @brief Profiled times of each input stack (nested source lines).
+ */
+static xd_map_t *xd_profile_stacks = NULL;
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Implementation of `xd_gens_copy_func` for `xd_profile_entry_t`
+ * objects.
+ */
+static void *xd_profile_entry_copy_func(void *data) {
+  if (data == NULL) {
+    return NULL;
+  }
+  xd_profile_entry_t *copy =
+      (xd_profile_entry_t *)malloc(sizeof(xd_profile_entry_t));
+  if (copy == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  *copy = *(xd_profile_entry_t *)data;
+  copy->location = xd_utils_strdup(copy->location);
+  return copy;
+}  // xd_profile_entry_copy_func()
+
+/**
+ * @brief Implementation of `xd_gens_destroy_func` for `xd_profile_entry_t`
+ * objects.
+ */
+static void xd_profile_entry_destroy_func(void *data) {
+  xd_profile_entry_t *entry = data;
+  if (entry == NULL) {
+    return;
+  }
+  free(entry->location);
+  free(entry);
+}  // xd_profile_entry_destroy_func()
+
+/**
+ * @brief Implementation of `xd_gens_comp_func` for `xd_profile_entry_t`
+ * objects, compares the locations.
+ */
+static int xd_profile_entry_comp_func(const void *data1, const void *data2) {
+  const xd_profile_entry_t *entry1 = data1;
+  const xd_profile_entry_t *entry2 = data2;
+  return strcmp(entry1->location, entry2->location);
+}  // xd_profile_entry_comp_func()
+
+/**
+ * @brief Comparison function for `qsort()`, orders the entries by their total
+ * time, longest first.
+ */
+static int xd_profile_entry_sort_func(const void *data1, const void *data2) {
+  const xd_profile_entry_t *entry1 = *(xd_profile_entry_t *const *)data1;
+  const xd_profile_entry_t *entry2 = *(xd_profile_entry_t *const *)data2;
+  if (entry1->total_time != entry2->total_time) {
+    return entry1->total_time > entry2->total_time ? -1 : 1;
+  }
+  return strcmp(entry1->location, entry2->location);
+}  // xd_profile_entry_sort_func()
+
+/**
+ * @brief Creates a map from locations to `xd_profile_entry_t` objects.
+ */
+static xd_map_t *xd_profile_map_create() {
+  return xd_map_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                       xd_utils_str_comp_func, xd_profile_entry_copy_func,
+                       xd_profile_entry_destroy_func,
+                       xd_profile_entry_comp_func, xd_utils_str_hash_func);
+}  // xd_profile_map_create()
+
+/**
+ * @brief Returns the entry of the passed location in the passed map, adding an
+ * empty one if not found.
+ *
+ * @param map The map to search.
+ * @param location The location of the entry.
+ *
+ * @return The entry owned by the map.
+ */
+static xd_profile_entry_t *xd_profile_get_entry(xd_map_t *map,
+                                                const char *location) {
+  xd_profile_entry_t *entry = xd_map_get(map, (void *)location);
+  if (entry != NULL) {
+    return entry;
+  }
+  xd_profile_entry_t empty = {0};
+  empty.location = (char *)location;
+  xd_map_put(map, (void *)location, &empty);
+  return xd_map_get(map, (void *)location);
+}  // xd_profile_get_entry()
+
+/**
+ * @brief Adds the times of the passed job to the passed entry.
+ *
+ * @param entry The entry to be updated.
+ * @param job The finished job.
+ * @param total_time The total time of the job.
+ * @param cpu_time The CPU time of the job.
+ */
+static void xd_profile_add(xd_profile_entry_t *entry, const xd_job_t *job,
+                           uint64_t total_time, uint64_t cpu_time) {
+  entry->count++;
+  entry->total_time += total_time;
+  entry->parse_time += job->parse_time;
+  entry->expansion_time += job->expansion_time;
+  entry->spawn_time += job->spawn_time;
+  entry->wait_time += job->wait_time;
+  entry->cpu_time += cpu_time;
+}  // xd_profile_add()
+
+/**
+ * @brief Writes the report of the profiled source lines sorted by their total
+ * time to the passed path.
+ *
+ * @param path The path of the report.
+ */
+static void xd_profile_write_report(const char *path) {
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    fprintf(stderr, "xd-shell: %s: %s\n", path, strerror(errno));
+    return;
+  }
+
+  int count = xd_profile_lines->entry_count;
+  xd_profile_entry_t **entries =
+      (xd_profile_entry_t **)xd_map_to_array(xd_profile_lines);
+  qsort((void *)entries, (size_t)count, sizeof(xd_profile_entry_t *),
+        xd_profile_entry_sort_func);
+
+  fprintf(file, "%8s %12s %12s %12s %12s %12s %12s  %s\n", "count",
+          "total(ms)", "parse(ms)", "expand(ms)", "spawn(ms)", "wait(ms)",
+          "cpu(ms)", "location");
+  for (int i = 0; i < count; i++) {
+    xd_profile_entry_t *entry = entries[i];
+    fprintf(file, "%8d %12.3f %12.3f %12.3f %12.3f %12.3f %12.3f  %s\n",
+            entry->count,
+            (double)entry->total_time / XD_PROFILE_NANOSECONDS_PER_MILLISECOND,
+            (double)entry->parse_time / XD_PROFILE_NANOSECONDS_PER_MILLISECOND,
+            (double)entry->expansion_time /
+                XD_PROFILE_NANOSECONDS_PER_MILLISECOND,
+            (double)entry->spawn_time / XD_PROFILE_NANOSECONDS_PER_MILLISECOND,
+            (double)entry->wait_time / XD_PROFILE_NANOSECONDS_PER_MILLISECOND,
+            (double)entry->cpu_time / XD_PROFILE_NANOSECONDS_PER_MILLISECOND,
+            entry->location);
+  }
+  free((void *)entries);
+  fclose(file);
+}  // xd_profile_write_report()
+
+/**
+ * @brief Writes the collapsed stacks of the profiled jobs to the passed path.
+ *
+ * @param path The path of the collapsed stacks file.
+ */
+static void xd_profile_write_folded(const char *path) {
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    fprintf(stderr, "xd-shell: %s: %s\n", path, strerror(errno));
+    return;
+  }
+
+  int count = xd_profile_stacks->entry_count;
+  xd_profile_entry_t **entries =
+      (xd_profile_entry_t **)xd_map_to_array(xd_profile_stacks);
+  for (int i = 0; i < count; i++) {
+    fprintf(file, "%s %" PRIu64 "\n", entries[i]->location,
+            entries[i]->total_time / XD_PROFILE_NANOSECONDS_PER_MICROSECOND);
+  }
+  free((void *)entries);
+  fclose(file);
+}  // xd_profile_write_folded()
+
+// ========================
+// Public Functions
+// ========================
+
+void xd_profile_destroy() {
+  if (xd_profile_lines != NULL && getpid() == xd_sh_pid) {
+    char path[PATH_MAX];
+    char *profile_path = xd_vars_get(XD_PROFILE_VAR);
+    if (profile_path != NULL && *profile_path != '\0') {
+      snprintf(path, sizeof(path), "%s", profile_path);
+    }
+    else {
+      snprintf(path, sizeof(path), XD_PROFILE_DEF_PATH_FORMAT, (int)getpid());
+    }
+    xd_profile_write_report(path);
+
+    char folded_path[PATH_MAX + sizeof(XD_PROFILE_FOLDED_SUFFIX)];
+    snprintf(folded_path, sizeof(folded_path), "%s%s", path,
+             XD_PROFILE_FOLDED_SUFFIX);
+    xd_profile_write_folded(folded_path);
+  }
+
+  xd_map_destroy(xd_profile_lines);
+  xd_profile_lines = NULL;
+  xd_map_destroy(xd_profile_stacks);
+  xd_profile_stacks = NULL;
+}  // xd_profile_destroy()
+
+void xd_profile_record(const xd_job_t *job) {
+  if (job == NULL || job->location == NULL) {
+    return;
+  }
+  if (xd_profile_lines == NULL) {
+    xd_profile_lines = xd_profile_map_create();
+    xd_profile_stacks = xd_profile_map_create();
+  }
+
+  uint64_t total_time = job->parse_time + job->expansion_time;
+  if (job->end_time > job->start_time) {
+    total_time += job->end_time - job->start_time;
+  }
+  uint64_t cpu_time = 0;
+  for (int i = 0; i < job->command_count; i++) {
+    const struct rusage *rusage = &job->commands[i]->rusage;
+    cpu_time += ((uint64_t)rusage->ru_utime.tv_sec +
+                 (uint64_t)rusage->ru_stime.tv_sec) *
+                    XD_SH_NANOSECONDS_PER_SECOND +
+                ((uint64_t)rusage->ru_utime.tv_usec +
+                 (uint64_t)rusage->ru_stime.tv_usec) *
+                    XD_PROFILE_NANOSECONDS_PER_MICROSECOND;
+  }
+
+  // the line itself is the innermost location of the stack
+  const char *line = strrchr(job->location, ';');
+  line = (line != NULL) ? line + 1 : job->location;
+
+  xd_profile_add(xd_profile_get_entry(xd_profile_lines, line), job, total_time,
+                 cpu_time);
+  xd_profile_add(xd_profile_get_entry(xd_profile_stacks, job->location), job,
+                 total_time, cpu_time);
+}  // xd_profile_record()
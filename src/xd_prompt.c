@@ -0,0 +1,850 @@
+/*
+ * ==============================================================================
+ * File: xd_prompt.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_prompt.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pwd.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "xd_jobs.h"
+#include "xd_readline.h"
+#include "xd_shell.h"
+#include "xd_string.h"
+#include "xd_utils.h"
+#include "xd_vars.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Set in `xd_prompt_deps` if the compiled prompt shows the working
+ * directory.
+ */
+#define XD_PROMPT_DEP_CWD (1 << 0)
+
+/**
+ * @brief Set in `xd_prompt_deps` if the compiled prompt shows the number of
+ * jobs.
+ */
+#define XD_PROMPT_DEP_JOBS (1 << 1)
+
+/**
+ * @brief Set in `xd_prompt_deps` if the compiled prompt shows the last exit
+ * code.
+ */
+#define XD_PROMPT_DEP_EXIT_CODE (1 << 2)
+
+/**
+ * @brief Set in `xd_prompt_deps` if the compiled prompt shows the time.
+ */
+#define XD_PROMPT_DEP_TIME (1 << 3)
+
+/**
+ * @brief Set in `xd_prompt_deps` if the compiled prompt shows the output of a
+ * command.
+ */
+#define XD_PROMPT_DEP_ASYNC (1 << 4)
+
+/**
+ * @brief Maximum number of bytes kept from the output of a prompt command.
+ */
+#define XD_PROMPT_ASYNC_OUTPUT_MAX (1024)
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Types of prompt segments.
+ */
+typedef enum xd_prompt_seg_type_t {
+  XD_PROMPT_SEG_TEXT,       // Literal text
+  XD_PROMPT_SEG_CWD,        // `\w`
+  XD_PROMPT_SEG_CWD_BASE,   // `\W`
+  XD_PROMPT_SEG_TIME,       // `\t`
+  XD_PROMPT_SEG_JOBS,       // `\j`
+  XD_PROMPT_SEG_EXIT_CODE,  // `\?`
+  XD_PROMPT_SEG_ASYNC,      // `$(command)`
+} xd_prompt_seg_type_t;
+
+/**
+ * @brief Represents a segment of a compiled prompt.
+ */
+typedef struct xd_prompt_seg_t {
+  xd_prompt_seg_type_t type;  // The type of the segment
+  int start;   // Start of the text in `xd_prompt_text`, or index of the
+               // command in `xd_prompt_asyncs`
+  int length;  // Length of the text (text segments only)
+} xd_prompt_seg_t;
+
+/**
+ * @brief Represents a `$(command)` segment of the prompt run in the
+ * background.
+ */
+typedef struct xd_prompt_async_t {
+  char *command;        // The command
+  char *value;          // Output of the last finished run (`NULL` if none)
+  xd_string_t *output;  // Output of the current run so far
+  pid_t pid;            // PID of the current run (`0` if reaped)
+  int pidfd;            // pidfd of the current run (or `-1`)
+  int fd;               // Read-end of the pipe of the current run (or `-1`)
+} xd_prompt_async_t;
+
+// ========================
+// Function Declarations
+// ========================
+
+static void xd_prompt_add_text(const char *text, int length);
+static void xd_prompt_add_seg(xd_prompt_seg_type_t type, int dep);
+static void xd_prompt_compile(const char *ps1);
+static void xd_prompt_append_cwd(xd_string_t *prompt, int base_only);
+static void xd_prompt_render();
+static void xd_prompt_async_add(const char *command, int length);
+static void xd_prompt_async_clear();
+static void xd_prompt_async_reap(xd_prompt_async_t *async, int kill_running);
+static void xd_prompt_async_start(xd_prompt_async_t *async);
+static void xd_prompt_async_read(xd_prompt_async_t *async);
+static void xd_prompt_async_wait(int budget_ms);
+static void xd_prompt_async_fd_handler(int fd);
+static int xd_prompt_update();
+
+// flex and bison functions
+extern void yylex_scan_string(char *str);
+extern void yyparse_initialize();
+extern int yyparse();
+extern void yyparse_cleanup();
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief The user name, cached at startup.
+ */
+static char *xd_prompt_user = NULL;
+
+/**
+ * @brief The host name, cached at startup.
+ */
+static char *xd_prompt_host = NULL;
+
+/**
+ * @brief Whether the user is the superuser, cached at startup.
+ */
+static int xd_prompt_is_root = 0;
+
+/**
+ * @brief The working directory, updated by `xd_prompt_set_cwd()`.
+ */
+static char *xd_prompt_cwd = NULL;
+
+/**
+ * @brief Whether the working directory changed since the last render.
+ */
+static int xd_prompt_is_cwd_changed = 1;
+
+/**
+ * @brief The `PS1` value the segments were compiled from.
+ */
+static char *xd_prompt_source = NULL;
+
+/**
+ * @brief Segments of the compiled prompt.
+ */
+static xd_prompt_seg_t *xd_prompt_segs = NULL;
+
+/**
+ * @brief Number of segments in `xd_prompt_segs`.
+ */
+static int xd_prompt_seg_count = 0;
+
+/**
+ * @brief Literal text of the compiled prompt, referenced by its text segments.
+ */
+static xd_string_t *xd_prompt_text = NULL;
+
+/**
+ * @brief Bitmask of the `XD_PROMPT_DEP_*` inputs used by the compiled prompt.
+ */
+static int xd_prompt_deps = 0;
+
+/**
+ * @brief The rendered prompt.
+ */
+static xd_string_t *xd_prompt_str = NULL;
+
+/**
+ * @brief Value of `HOME` when the prompt was last rendered.
+ */
+static char *xd_prompt_home = NULL;
+
+/**
+ * @brief Number of jobs when the prompt was last rendered.
+ */
+static int xd_prompt_job_count = 0;
+
+/**
+ * @brief Last exit code when the prompt was last rendered.
+ */
+static int xd_prompt_exit_code = 0;
+
+/**
+ * @brief The `$(command)` segments of the compiled prompt.
+ */
+static xd_prompt_async_t xd_prompt_asyncs[XD_PROMPT_ASYNC_MAX];
+
+/**
+ * @brief Number of commands in `xd_prompt_asyncs`.
+ */
+static int xd_prompt_async_count = 0;
+
+/**
+ * @brief Whether a command finished since the last render.
+ */
+static int xd_prompt_is_async_changed = 0;
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Appends the passed text to the compiled prompt, merging it with the
+ * previous segment if it's a text segment too.
+ *
+ * @param text The text to be appended.
+ * @param length The length of `text`.
+ */
+static void xd_prompt_add_text(const char *text, int length) {
+  if (length == 0) {
+    return;
+  }
+  xd_prompt_seg_t *last = (xd_prompt_seg_count == 0)
+                              ? NULL
+                              : &xd_prompt_segs[xd_prompt_seg_count - 1];
+  if (last == NULL || last->type != XD_PROMPT_SEG_TEXT) {
+    last = &xd_prompt_segs[xd_prompt_seg_count++];
+    last->type = XD_PROMPT_SEG_TEXT;
+    last->start = xd_prompt_text->length;
+    last->length = 0;
+  }
+  xd_string_append_n(xd_prompt_text, text, length);
+  last->length += length;
+}  // xd_prompt_add_text()
+
+/**
+ * @brief Appends a segment rendered at display time to the compiled prompt.
+ *
+ * @param type The type of the segment.
+ * @param dep The `XD_PROMPT_DEP_*` input the segment depends on.
+ */
+static void xd_prompt_add_seg(xd_prompt_seg_type_t type, int dep) {
+  xd_prompt_seg_t *seg = &xd_prompt_segs[xd_prompt_seg_count++];
+  seg->type = type;
+  seg->start = 0;
+  seg->length = 0;
+  xd_prompt_deps |= dep;
+}  // xd_prompt_add_seg()
+
+/**
+ * @brief Compiles the passed prompt string into `xd_prompt_segs`, replacing
+ * the escapes whose value can't change (user, host, ...) with their text.
+ *
+ * @param ps1 The prompt string.
+ */
+static void xd_prompt_compile(const char *ps1) {
+  free(xd_prompt_source);
+  free(xd_prompt_segs);
+  xd_prompt_source = xd_utils_strdup((char *)ps1);
+
+  // each character adds at most one segment
+  size_t max_segs = strlen(ps1) + 1;
+  xd_prompt_segs =
+      (xd_prompt_seg_t *)malloc(max_segs * sizeof(xd_prompt_seg_t));
+  if (xd_prompt_segs == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  xd_prompt_seg_count = 0;
+  xd_prompt_deps = 0;
+  xd_prompt_async_clear();
+  if (xd_prompt_text == NULL) {
+    xd_prompt_text = xd_string_create();
+  }
+  xd_string_clear(xd_prompt_text);
+
+  const char *user = (xd_prompt_user == NULL) ? "" : xd_prompt_user;
+  const char *host = (xd_prompt_host == NULL) ? "" : xd_prompt_host;
+  for (const char *ptr = ps1; *ptr != '\0'; ptr++) {
+    if (*ptr == '$' && ptr[1] == '(' &&
+        xd_prompt_async_count < XD_PROMPT_ASYNC_MAX) {
+      // find the matching closing parenthesis
+      int depth = 0;
+      const char *end = ptr + 1;
+      for (; *end != '\0'; end++) {
+        depth += (*end == '(') - (*end == ')');
+        if (depth == 0) {
+          break;
+        }
+      }
+      if (*end == ')') {
+        xd_prompt_async_add(ptr + 2, (int)(end - ptr - 2));
+        ptr = end;
+        continue;
+      }
+    }
+    if (*ptr != '\\' || ptr[1] == '\0') {
+      xd_prompt_add_text(ptr, 1);
+      continue;
+    }
+    ptr++;
+    switch (*ptr) {
+      case 'u':
+        xd_prompt_add_text(user, (int)strlen(user));
+        break;
+      case 'h':
+        xd_prompt_add_text(host, (int)strcspn(host, "."));
+        break;
+      case 'H':
+        xd_prompt_add_text(host, (int)strlen(host));
+        break;
+      case '$':
+        xd_prompt_add_text(xd_prompt_is_root ? "#" : "$", 1);
+        break;
+      case 's':
+        xd_prompt_add_text("xd-shell", (int)strlen("xd-shell"));
+        break;
+      case 'n':
+        xd_prompt_add_text("\n", 1);
+        break;
+      case 'e':
+        xd_prompt_add_text("\x1b", 1);
+        break;
+      case 'a':
+        xd_prompt_add_text("\a", 1);
+        break;
+      case '\\':
+        xd_prompt_add_text("\\", 1);
+        break;
+      case '[':
+      case ']':
+        // escape sequences are skipped when measuring the prompt anyway
+        break;
+      case 'w':
+        xd_prompt_add_seg(XD_PROMPT_SEG_CWD, XD_PROMPT_DEP_CWD);
+        break;
+      case 'W':
+        xd_prompt_add_seg(XD_PROMPT_SEG_CWD_BASE, XD_PROMPT_DEP_CWD);
+        break;
+      case 't':
+        xd_prompt_add_seg(XD_PROMPT_SEG_TIME, XD_PROMPT_DEP_TIME);
+        break;
+      case 'j':
+        xd_prompt_add_seg(XD_PROMPT_SEG_JOBS, XD_PROMPT_DEP_JOBS);
+        break;
+      case '?':
+        xd_prompt_add_seg(XD_PROMPT_SEG_EXIT_CODE, XD_PROMPT_DEP_EXIT_CODE);
+        break;
+      default:
+        // unknown escape, keep it as is
+        xd_prompt_add_text(ptr - 1, 2);
+        break;
+    }
+  }
+}  // xd_prompt_compile()
+
+/**
+ * @brief Appends the working directory to the passed prompt, with the `HOME`
+ * prefix replaced by `~`.
+ *
+ * @param prompt The prompt being rendered.
+ * @param base_only `1` to append only the last component, `0` otherwise.
+ */
+static void xd_prompt_append_cwd(xd_string_t *prompt, int base_only) {
+  const char *cwd = (xd_prompt_cwd == NULL) ? "" : xd_prompt_cwd;
+  const char *home = xd_prompt_home;
+  int home_len = (home == NULL) ? 0 : (int)strlen(home);
+
+  if (home_len > 0 && home[home_len - 1] != '/' &&
+      strncmp(home, cwd, home_len) == 0 &&
+      (cwd[home_len] == '/' || cwd[home_len] == '\0')) {
+    if (!base_only) {
+      xd_string_append_chr(prompt, '~');
+      xd_string_append_str(prompt, cwd + home_len);
+      return;
+    }
+    if (cwd[home_len] == '\0') {
+      xd_string_append_chr(prompt, '~');
+      return;
+    }
+  }
+
+  const char *base = strrchr(cwd, '/');
+  if (!base_only || base == NULL || base[1] == '\0') {
+    xd_string_append_str(prompt, cwd);
+    return;
+  }
+  xd_string_append_str(prompt, base + 1);
+}  // xd_prompt_append_cwd()
+
+/**
+ * @brief Renders the compiled prompt into `xd_prompt_str`.
+ */
+static void xd_prompt_render() {
+  xd_string_clear(xd_prompt_str);
+  for (int i = 0; i < xd_prompt_seg_count; i++) {
+    xd_prompt_seg_t *seg = &xd_prompt_segs[i];
+    switch (seg->type) {
+      case XD_PROMPT_SEG_TEXT:
+        xd_string_append_n(xd_prompt_str, xd_prompt_text->str + seg->start,
+                           seg->length);
+        break;
+      case XD_PROMPT_SEG_CWD:
+        xd_prompt_append_cwd(xd_prompt_str, 0);
+        break;
+      case XD_PROMPT_SEG_CWD_BASE:
+        xd_prompt_append_cwd(xd_prompt_str, 1);
+        break;
+      case XD_PROMPT_SEG_TIME: {
+        char time_buf[16] = {0};
+        time_t now = time(NULL);
+        struct tm now_tm;
+        if (localtime_r(&now, &now_tm) != NULL) {
+          strftime(time_buf, sizeof(time_buf), "%H:%M:%S", &now_tm);
+        }
+        xd_string_append_str(xd_prompt_str, time_buf);
+        break;
+      }
+      case XD_PROMPT_SEG_JOBS:
+        xd_string_append_fmt(xd_prompt_str, "%d", xd_prompt_job_count);
+        break;
+      case XD_PROMPT_SEG_EXIT_CODE:
+        xd_string_append_fmt(xd_prompt_str, "%d", xd_prompt_exit_code);
+        break;
+      case XD_PROMPT_SEG_ASYNC: {
+        const char *value = xd_prompt_asyncs[seg->start].value;
+        xd_string_append_str(xd_prompt_str, value == NULL ? "" : value);
+        break;
+      }
+    }
+  }
+}  // xd_prompt_render()
+
+/**
+ * @brief Appends a `$(command)` segment to the compiled prompt.
+ *
+ * @param command The command.
+ * @param length The length of `command`.
+ */
+static void xd_prompt_async_add(const char *command, int length) {
+  xd_prompt_async_t *async = &xd_prompt_asyncs[xd_prompt_async_count];
+  xd_string_t *command_str = xd_string_create();
+  xd_string_append_n(command_str, command, length);
+  async->command = xd_string_release(command_str);
+  xd_string_destroy(command_str);
+  async->value = NULL;
+  async->output = xd_string_create();
+  async->pid = 0;
+  async->pidfd = -1;
+  async->fd = -1;
+
+  xd_prompt_add_seg(XD_PROMPT_SEG_ASYNC, XD_PROMPT_DEP_ASYNC);
+  xd_prompt_segs[xd_prompt_seg_count - 1].start = xd_prompt_async_count;
+  xd_prompt_async_count++;
+}  // xd_prompt_async_add()
+
+/**
+ * @brief Removes the `$(command)` segments of the compiled prompt, closing the
+ * pipes of the running ones and killing their commands.
+ */
+static void xd_prompt_async_clear() {
+  for (int i = 0; i < xd_prompt_async_count; i++) {
+    xd_prompt_async_t *async = &xd_prompt_asyncs[i];
+    if (async->fd != -1) {
+      xd_readline_unwatch_fd(async->fd);
+      close(async->fd);
+    }
+    xd_prompt_async_reap(async, 1);
+    free(async->command);
+    free(async->value);
+    xd_string_destroy(async->output);
+  }
+  xd_prompt_async_count = 0;
+}  // xd_prompt_async_clear()
+
+/**
+ * @brief Reaps the last run of the passed segment through its pidfd.
+ *
+ * The run may already have been reaped along with the unknown children by
+ * `xd_jobs_reap()`, its PID may then belong to another process, so it's only
+ * used while the pidfd shows the run wasn't reaped yet.
+ *
+ * @param async The segment to reap its last run.
+ * @param kill_running Whether to kill the run and wait for it if it's still
+ * running, otherwise it's left to be reaped by a later call.
+ *
+ * @note Without pidfds the run is waited once without blocking, and is
+ * otherwise reaped along with the unknown children.
+ */
+static void xd_prompt_async_reap(xd_prompt_async_t *async, int kill_running) {
+  if (async->pid == 0) {
+    return;
+  }
+
+  if (async->pidfd == -1) {
+    waitpid(async->pid, NULL, WNOHANG);
+    async->pid = 0;
+    return;
+  }
+
+  siginfo_t info;
+  int ret;
+  do {
+    info.si_pid = 0;
+    ret = waitid(P_PIDFD, (id_t)async->pidfd, &info, WEXITED | WNOHANG);
+  } while (ret == -1 && errno == EINTR);
+
+  if (ret == 0 && info.si_pid == 0) {
+    if (!kill_running) {
+      return;
+    }
+    // not reaped yet, so the PID still belongs to the run
+    kill(async->pid, SIGKILL);
+    while (waitid(P_PIDFD, (id_t)async->pidfd, &info, WEXITED) == -1 &&
+           errno == EINTR) {
+      continue;
+    }
+  }
+
+  close(async->pidfd);
+  async->pidfd = -1;
+  async->pid = 0;
+}  // xd_prompt_async_reap()
+
+/**
+ * @brief Runs the command of the passed segment in a subshell, with its output
+ * going to a pipe watched by `xd_readline()`.
+ *
+ * @param async The segment to run, its last run is killed if it didn't exit
+ * yet.
+ */
+static void xd_prompt_async_start(xd_prompt_async_t *async) {
+  xd_prompt_async_reap(async, 1);
+
+  int pipe_fd[2];
+  if (pipe(pipe_fd) == -1) {
+    return;
+  }
+
+  // the child would write the pending output to the pipe when exiting
+  fflush(stdout);
+
+  pid_t pid = fork();
+  if (pid == -1) {
+    close(pipe_fd[0]);
+    close(pipe_fd[1]);
+    return;
+  }
+
+  if (pid == 0) {
+    close(pipe_fd[0]);
+    if (dup2(pipe_fd[1], STDOUT_FILENO) == -1) {
+      exit(EXIT_FAILURE);
+    }
+    close(pipe_fd[1]);
+
+    // keep the command away from the line being edited
+    int null_fd = open("/dev/null", O_RDWR);
+    if (null_fd != -1) {
+      dup2(null_fd, STDIN_FILENO);
+      dup2(null_fd, STDERR_FILENO);
+      close(null_fd);
+    }
+
+    xd_sh_is_subshell = 1;
+    yyparse_cleanup();
+    yyparse_initialize();
+    xd_sh_is_interactive = 0;
+    yylex_scan_string(async->command);
+    yyparse();
+    exit(EXIT_FAILURE);  // shouldn't reach this
+  }
+
+  close(pipe_fd[1]);
+  fcntl(pipe_fd[0], F_SETFD, FD_CLOEXEC);
+  fcntl(pipe_fd[0], F_SETFL, fcntl(pipe_fd[0], F_GETFL) | O_NONBLOCK);
+  async->pid = pid;
+  async->pidfd = xd_utils_pidfd_open(pid);
+  async->fd = pipe_fd[0];
+  xd_string_clear(async->output);
+  xd_readline_watch_fd(async->fd, xd_prompt_async_fd_handler);
+}  // xd_prompt_async_start()
+
+/**
+ * @brief Reads the available output of the passed running segment, and makes
+ * it the value of the segment once the command closes its output.
+ *
+ * @param async The running segment.
+ */
+static void xd_prompt_async_read(xd_prompt_async_t *async) {
+  char buf[LINE_MAX];
+  ssize_t count;
+  while ((count = read(async->fd, buf, sizeof(buf))) != 0) {
+    if (count == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      break;
+    }
+    int room = XD_PROMPT_ASYNC_OUTPUT_MAX - async->output->length;
+    xd_string_append_n(async->output, buf, count < room ? (int)count : room);
+  }
+
+  // done, the child is reaped here if it exited, or by the next start
+  xd_readline_unwatch_fd(async->fd);
+  close(async->fd);
+  async->fd = -1;
+  xd_prompt_async_reap(async, 0);
+
+  while (async->output->length > 0 &&
+         async->output->str[async->output->length - 1] == '\n') {
+    async->output->str[--async->output->length] = '\0';
+  }
+  if (async->value == NULL || strcmp(async->value, async->output->str) != 0) {
+    free(async->value);
+    async->value = xd_utils_strdup(async->output->str);
+    xd_prompt_is_async_changed = 1;
+  }
+}  // xd_prompt_async_read()
+
+/**
+ * @brief Waits until all the running segments finish or the passed budget
+ * runs out.
+ *
+ * @param budget_ms The maximum time to wait in milliseconds.
+ */
+static void xd_prompt_async_wait(int budget_ms) {
+  uint64_t deadline = xd_utils_now() + (uint64_t)budget_ms * 1000000;
+  while (1) {
+    struct pollfd fds[XD_PROMPT_ASYNC_MAX];
+    xd_prompt_async_t *running[XD_PROMPT_ASYNC_MAX];
+    int nfds = 0;
+    for (int i = 0; i < xd_prompt_async_count; i++) {
+      if (xd_prompt_asyncs[i].fd != -1) {
+        running[nfds] = &xd_prompt_asyncs[i];
+        fds[nfds].fd = xd_prompt_asyncs[i].fd;
+        fds[nfds].events = POLLIN;
+        nfds++;
+      }
+    }
+    uint64_t now = xd_utils_now();
+    if (nfds == 0 || now >= deadline) {
+      return;
+    }
+
+    int timeout_ms = (int)((deadline - now + 999999) / 1000000);
+    int ret = poll(fds, nfds, timeout_ms);
+    if (ret == -1 && errno != EINTR) {
+      return;
+    }
+    for (int i = 0; i < nfds && ret > 0; i++) {
+      if (fds[i].revents != 0) {
+        xd_prompt_async_read(running[i]);
+      }
+    }
+  }
+}  // xd_prompt_async_wait()
+
+/**
+ * @brief Handles output of a running segment arriving while `xd_readline()`
+ * waits for input, redrawing the prompt if the value changed.
+ *
+ * @param fd The read-end of the pipe of the segment.
+ */
+static void xd_prompt_async_fd_handler(int fd) {
+  for (int i = 0; i < xd_prompt_async_count; i++) {
+    if (xd_prompt_asyncs[i].fd == fd) {
+      xd_prompt_async_read(&xd_prompt_asyncs[i]);
+      break;
+    }
+  }
+  if (xd_prompt_update() && xd_readline_prompt == xd_sh_prompt) {
+    snprintf(xd_sh_prompt, XD_SH_PROMPT_MAX_LENGTH, "%s",
+             xd_prompt_str->str);
+    xd_readline_prompt_redraw();
+  }
+}  // xd_prompt_async_fd_handler()
+
+/**
+ * @brief Renders the compiled prompt again if one of its inputs changed since
+ * the last render.
+ *
+ * @return `1` if the prompt was rendered again, `0` otherwise.
+ */
+static int xd_prompt_update() {
+  int is_changed = 0;
+  if (xd_prompt_str == NULL) {
+    xd_prompt_str = xd_string_create();
+    is_changed = 1;
+  }
+
+  if (xd_prompt_deps & XD_PROMPT_DEP_CWD) {
+    const char *home = xd_vars_get("HOME");
+    if ((home == NULL) != (xd_prompt_home == NULL) ||
+        (home != NULL && strcmp(home, xd_prompt_home) != 0)) {
+      free(xd_prompt_home);
+      xd_prompt_home = (home == NULL) ? NULL : xd_utils_strdup((char *)home);
+      is_changed = 1;
+    }
+    if (xd_prompt_is_cwd_changed) {
+      xd_prompt_is_cwd_changed = 0;
+      is_changed = 1;
+    }
+  }
+  if ((xd_prompt_deps & XD_PROMPT_DEP_JOBS) &&
+      xd_jobs_get_count() != xd_prompt_job_count) {
+    xd_prompt_job_count = xd_jobs_get_count();
+    is_changed = 1;
+  }
+  if ((xd_prompt_deps & XD_PROMPT_DEP_EXIT_CODE) &&
+      xd_sh_last_exit_code != xd_prompt_exit_code) {
+    xd_prompt_exit_code = xd_sh_last_exit_code;
+    is_changed = 1;
+  }
+  if ((xd_prompt_deps & XD_PROMPT_DEP_ASYNC) && xd_prompt_is_async_changed) {
+    xd_prompt_is_async_changed = 0;
+    is_changed = 1;
+  }
+  if (xd_prompt_deps & XD_PROMPT_DEP_TIME) {
+    is_changed = 1;
+  }
+
+  if (is_changed) {
+    xd_prompt_render();
+  }
+  return is_changed;
+}  // xd_prompt_update()
+
+// ========================
+// Public Functions
+// ========================
+
+void xd_prompt_init() {
+  struct passwd *pwd = getpwuid(getuid());
+  free(xd_prompt_user);
+  xd_prompt_user = xd_utils_strdup(pwd == NULL ? "" : pwd->pw_name);
+  xd_prompt_is_root = (geteuid() == 0);
+
+  char hostname[HOST_NAME_MAX + 1] = {0};
+  if (gethostname(hostname, sizeof(hostname) - 1) == -1) {
+    hostname[0] = '\0';
+  }
+  free(xd_prompt_host);
+  xd_prompt_host = xd_utils_strdup(hostname);
+
+  char cwd[PATH_MAX] = {0};
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    cwd[0] = '\0';
+  }
+  xd_prompt_set_cwd(cwd);
+
+  // user and host are compiled in, recompile with the cached values
+  free(xd_prompt_source);
+  xd_prompt_source = NULL;
+}  // xd_prompt_init()
+
+void xd_prompt_destroy() {
+  xd_prompt_async_clear();
+  free(xd_prompt_user);
+  free(xd_prompt_host);
+  free(xd_prompt_cwd);
+  free(xd_prompt_source);
+  free(xd_prompt_segs);
+  free(xd_prompt_home);
+  xd_string_destroy(xd_prompt_text);
+  xd_string_destroy(xd_prompt_str);
+  xd_prompt_user = NULL;
+  xd_prompt_host = NULL;
+  xd_prompt_cwd = NULL;
+  xd_prompt_source = NULL;
+  xd_prompt_segs = NULL;
+  xd_prompt_home = NULL;
+  xd_prompt_text = NULL;
+  xd_prompt_str = NULL;
+  xd_prompt_seg_count = 0;
+}  // xd_prompt_destroy()
+
+void xd_prompt_set_cwd(const char *cwd) {
+  if (cwd == NULL ||
+      (xd_prompt_cwd != NULL && strcmp(xd_prompt_cwd, cwd) == 0)) {
+    return;
+  }
+  free(xd_prompt_cwd);
+  xd_prompt_cwd = xd_utils_strdup((char *)cwd);
+  xd_prompt_is_cwd_changed = 1;
+}  // xd_prompt_set_cwd()
+
+const char *xd_prompt_get() {
+  const char *ps1 = xd_vars_get(XD_PROMPT_VAR);
+  if (ps1 == NULL) {
+    ps1 = XD_PROMPT_DEF_PS1;
+  }
+
+  if (xd_prompt_source == NULL || strcmp(xd_prompt_source, ps1) != 0) {
+    xd_prompt_compile(ps1);
+    xd_string_destroy(xd_prompt_str);
+    xd_prompt_str = NULL;
+  }
+
+  if (xd_prompt_async_count > 0) {
+    for (int i = 0; i < xd_prompt_async_count; i++) {
+      xd_prompt_async_t *async = &xd_prompt_asyncs[i];
+      if (async->fd != -1) {
+        xd_prompt_async_read(async);
+      }
+      if (async->fd == -1) {
+        xd_prompt_async_start(async);
+      }
+    }
+
+    long budget_ms = XD_PROMPT_DEF_BUDGET;
+    const char *budget_str = xd_vars_get(XD_PROMPT_BUDGET_VAR);
+    if (budget_str != NULL &&
+        (xd_utils_strtol(budget_str, &budget_ms) == -1 || budget_ms < 0 ||
+         budget_ms > INT_MAX)) {
+      budget_ms = XD_PROMPT_DEF_BUDGET;
+    }
+    xd_prompt_async_wait((int)budget_ms);
+  }
+
+  xd_prompt_update();
+  return xd_prompt_str->str;
+}  // xd_prompt_get()
@@ -18,6 +18,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -27,6 +28,8 @@
 #include <termios.h>
 #include <unistd.h>
 
+#include "xd_alloc.h"
+
 // ========================
 // Macros and Constants
 // ========================
@@ -36,6 +39,12 @@
  */
 #define XD_RL_SMALL_BUFFER_SIZE (32)
 
+/**
+ * @brief Maximum time in milliseconds to wait for each byte of the cursor
+ * position reported by the terminal.
+ */
+#define XD_RL_CRSR_REQ_POS_TIMEOUT (100)
+
 /**
  * @brief The prompt for reverse history serach.
  */
@@ -132,6 +141,7 @@
 #define XD_RL_ANSI_SCRN_CLR     "\033[2J"    // ANSI for clearing the screen
 
 #define XD_RL_ANSI_CRSR_REQ_POS "\033[6n"  // ANSI for requesting crsr position
+#define XD_RL_ANSI_PARTIAL_MARK "\033[7m%\033[0m"  // ANSI for partial line mark
 
 #define XD_RL_ANSI_TEXT_HIGHLIGHT "\033[30;107m"  // ANSI for text highlight
 #define XD_RL_ANSI_TEXT_RESET     "\033[0m"       // ANSI for text restore
@@ -162,6 +172,14 @@ typedef struct xd_history_entry_t {
   int length;    // The length of the history string.
 } xd_history_entry_t;
 
+/**
+ * @brief Represents a file descriptor watched while waiting for input.
+ */
+typedef struct xd_watched_fd_t {
+  int fd;                                 // The watched file descriptor.
+  xd_readline_fd_handler_func_t handler;  // The handler function.
+} xd_watched_fd_t;
+
 /**
  * @brief Represents the running mode of `xd_readline`.
  */
@@ -208,6 +226,8 @@ static void xd_tty_input_redraw();
 
 static void xd_tty_screen_resize();
 
+static int xd_readline_wait_input();
+
 static void xd_tty_write_ansii_sequence(const char *format, ...);
 static void xd_tty_write(const void *data, int length);
 static void xd_tty_write_track(const void *data, int length);
@@ -340,6 +360,13 @@ static int xd_input_cursor = 0;
  */
 static int xd_readline_redraw = 0;
 
+/**
+ * @brief Indicates whether the cursor is known to be at the beginning of a
+ * line (non-zero) or not (zero), set when `xd_readline()` returns and cleared
+ * by `xd_readline_cursor_unknown()`.
+ */
+static int xd_tty_cursor_at_line_start = 0;
+
 /**
  * @brief Indicates whether readline finished (non-zero) or not (zero).
  */
@@ -420,6 +447,16 @@ static int xd_search_original_input_cursor = 0;
  */
 static int xd_search_result_highlight_start = -1;
 
+/**
+ * @brief File descriptors watched while waiting for input.
+ */
+static xd_watched_fd_t xd_watched_fds[XD_RL_WATCHED_FDS_MAX];
+
+/**
+ * @brief Number of file descriptors in `xd_watched_fds`.
+ */
+static int xd_watched_fds_length = 0;
+
 /**
  * @brief Array mapping ANSI escape sequences to corresponding input
  * handlers.
@@ -595,23 +632,14 @@ static void xd_readline_init() {
   xd_readline_history_init();
 
   // initialize input buffer
-  xd_input_buffer = (char *)malloc(sizeof(char) * xd_input_capacity);
-  if (xd_input_buffer == NULL) {
-    fprintf(stderr, "xd_readline: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_input_buffer = (char *)xd_alloc_malloc(XD_ALLOC_READLINE,
+                                            sizeof(char) * xd_input_capacity);
   xd_input_length = 0;
   xd_input_buffer[0] = XD_RL_ASCII_NUL;
 
   // initialize search query buffer
-  xd_search_query_buffer =
-      (char *)malloc(sizeof(char) * XD_RL_SEARCH_QUERY_MAX);
-  if (xd_search_query_buffer == NULL) {
-    fprintf(stderr, "xd_readline: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_search_query_buffer = (char *)xd_alloc_malloc(
+      XD_ALLOC_READLINE, sizeof(char) * XD_RL_SEARCH_QUERY_MAX);
   xd_search_query_length = 0;
   xd_search_query_buffer[0] = XD_RL_ASCII_NUL;
 
@@ -633,8 +661,8 @@ static void xd_readline_destroy() {
     return;
   }
   xd_readline_history_destroy();
-  free(xd_input_buffer);
-  free(xd_search_query_buffer);
+  xd_alloc_free(XD_ALLOC_READLINE, xd_input_buffer);
+  xd_alloc_free(XD_ALLOC_READLINE, xd_search_query_buffer);
 }  // xd_readline_destroy()
 
 /**
@@ -645,32 +673,18 @@ static void xd_readline_destroy() {
  * `xd_readline_init()` beacuse it calls `exit()` on failure.
  */
 static void xd_readline_history_init() {
-  xd_history = (xd_history_entry_t **)malloc(sizeof(xd_history_entry_t *) *
-                                             (XD_RL_HISTORY_MAX + 1));
-  if (xd_history == NULL) {
-    fprintf(stderr, "xd_readline: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_history = (xd_history_entry_t **)xd_alloc_malloc(
+      XD_ALLOC_READLINE,
+      sizeof(xd_history_entry_t *) * (XD_RL_HISTORY_MAX + 1));
 
   for (int i = 0; i <= XD_RL_HISTORY_MAX; i++) {
-    xd_history[i] = (xd_history_entry_t *)malloc(sizeof(xd_history_entry_t));
-    if (xd_history[i] == NULL) {
-      fprintf(stderr, "xd_readline: failed to allocate memory: %s\n",
-              strerror(errno));
-      exit(EXIT_FAILURE);
-    }
+    xd_history[i] = (xd_history_entry_t *)xd_alloc_malloc(
+        XD_ALLOC_READLINE, sizeof(xd_history_entry_t));
 
     xd_history[i]->capacity = LINE_MAX;
     xd_history[i]->length = 0;
-    xd_history[i]->str = (char *)malloc(sizeof(char) * LINE_MAX);
-    if (xd_history[i]->str == NULL) {
-      free(xd_history[i]);
-      xd_history[i] = NULL;
-      fprintf(stderr, "xd_readline: failed to allocate memory: %s\n",
-              strerror(errno));
-      exit(EXIT_FAILURE);
-    }
+    xd_history[i]->str =
+        (char *)xd_alloc_malloc(XD_ALLOC_READLINE, sizeof(char) * LINE_MAX);
     xd_history[i]->str[0] = XD_RL_ASCII_NUL;
   }
 }  // xd_readline_history_init()
@@ -683,10 +697,10 @@ static void xd_readline_history_destroy() {
     if (xd_history[i] == NULL) {
       break;
     }
-    free(xd_history[i]->str);
-    free(xd_history[i]);
+    xd_alloc_free(XD_ALLOC_READLINE, xd_history[i]->str);
+    xd_alloc_free(XD_ALLOC_READLINE, xd_history[i]);
   }
-  free((void *)xd_history);
+  xd_alloc_free(XD_ALLOC_READLINE, (void *)xd_history);
 }  // xd_readline_history_destroy()
 
 /**
@@ -815,13 +829,9 @@ static void xd_input_buffer_save_to_history() {
       new_capacity += LINE_MAX - (new_capacity % LINE_MAX);
     }
 
-    char *ptr =
-        (char *)realloc(history_entry->str, sizeof(char) * new_capacity);
-    if (ptr == NULL) {
-      return;  // allocation error, stop saving
-    }
+    history_entry->str = (char *)xd_alloc_realloc(
+        XD_ALLOC_READLINE, history_entry->str, sizeof(char) * new_capacity);
     history_entry->capacity = new_capacity;
-    history_entry->str = ptr;
   }
 
   memcpy(history_entry->str, xd_input_buffer, xd_input_length);
@@ -844,12 +854,9 @@ static void xd_input_buffer_load_from_history() {
       new_capacity += LINE_MAX - (new_capacity % LINE_MAX);
     }
 
-    char *ptr = (char *)realloc(xd_input_buffer, sizeof(char) * new_capacity);
-    if (ptr == NULL) {
-      return;  // allocation error, stop loading
-    }
+    xd_input_buffer = (char *)xd_alloc_realloc(
+        XD_ALLOC_READLINE, xd_input_buffer, sizeof(char) * new_capacity);
     xd_input_capacity = new_capacity;
-    xd_input_buffer = ptr;
   }
 
   xd_input_length = history_entry->length;
@@ -902,8 +909,35 @@ static void xd_tty_restore() {
 /**
  * @brief Helper used to ensures the tty cursor is on a fresh new line first
  * thing after calling `xd_readline()`.
+ *
+ * Nothing is done if nothing was written since the last line was read.
+ * Otherwise a marker followed by enough spaces to fill the line is written
+ * then the line is cleared: if the cursor was at the beginning of a line the
+ * marker is cleared, otherwise the spaces wrap and the marker is left after
+ * the partial line. The cursor position is requested from the terminal only if
+ * its width is unknown.
  */
 static void xd_tty_cursor_fix_initial_pos() {
+  if (xd_tty_cursor_at_line_start) {
+    return;
+  }
+
+  if (xd_tty_win_width > 0) {
+    char spaces[XD_RL_SMALL_BUFFER_SIZE];
+    memset(spaces, ' ', XD_RL_SMALL_BUFFER_SIZE);
+    xd_tty_write(XD_RL_ANSI_PARTIAL_MARK,
+                 (int)strlen(XD_RL_ANSI_PARTIAL_MARK));
+    for (int left = xd_tty_win_width - 1; left > 0;
+         left -= XD_RL_SMALL_BUFFER_SIZE) {
+      xd_tty_write(spaces, left < XD_RL_SMALL_BUFFER_SIZE
+                               ? left
+                               : XD_RL_SMALL_BUFFER_SIZE);
+    }
+    xd_tty_write("\r", 1);
+    xd_tty_write_ansii_sequence(XD_RL_ANSI_LINE_CLR);
+    return;
+  }
+
   xd_tty_write_ansii_sequence(XD_RL_ANSI_CRSR_REQ_POS);
   tcdrain(STDOUT_FILENO);
 
@@ -911,6 +945,11 @@ static void xd_tty_cursor_fix_initial_pos() {
   int idx = 0;
   char chr = ' ';
   while (idx < XD_RL_SMALL_BUFFER_SIZE - 1) {
+    // don't hang on terminals that never answer
+    struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    if (poll(&pfd, 1, XD_RL_CRSR_REQ_POS_TIMEOUT) <= 0) {
+      break;
+    }
     ssize_t ret = read(STDIN_FILENO, &chr, 1);
     if (ret <= 0) {
       break;
@@ -1016,6 +1055,67 @@ static void xd_tty_screen_resize() {
   }
 }  // xd_tty_screen_resize()
 
+/**
+ * @brief Waits until `stdin` has input to be read, calling the handlers of the
+ * watched file descriptors that become readable in the meantime.
+ *
+ * @return `1` when `stdin` is ready to be read, `0` if the wait was interrupted
+ * by a signal not reported through a watched file descriptor (`errno` is set to
+ * `EINTR`), or `-1` on error.
+ *
+ * @note Returns `1` immediately if no file descriptors are watched, leaving
+ * the blocking to `read()`.
+ */
+static int xd_readline_wait_input() {
+  if (xd_watched_fds_length == 0) {
+    return 1;
+  }
+
+  struct pollfd fds[XD_RL_WATCHED_FDS_MAX + 1];
+  int nfds = xd_watched_fds_length + 1;
+  fds[0].fd = STDIN_FILENO;
+  fds[0].events = POLLIN;
+  for (int i = 1; i < nfds; i++) {
+    fds[i].fd = xd_watched_fds[i - 1].fd;
+    fds[i].events = POLLIN;
+  }
+
+  while (1) {
+    int ret = poll(fds, nfds, -1);
+    if (ret == -1) {
+      if (errno != EINTR) {
+        return -1;
+      }
+      int resized = xd_tty_win_resized;
+      if (resized) {
+        xd_tty_screen_resize();
+        xd_tty_win_resized = 0;
+        xd_tty_input_redraw();
+        xd_readline_redraw = 0;
+      }
+
+      // check whether the signal was reported through a watched descriptor
+      ret = poll(fds, nfds, 0);
+      if (ret <= 0) {
+        if (resized) {
+          continue;
+        }
+        errno = EINTR;
+        return 0;
+      }
+    }
+
+    for (int i = 1; i < nfds; i++) {
+      if (fds[i].revents != 0) {
+        xd_watched_fds[i - 1].handler(fds[i].fd);
+      }
+    }
+    if (fds[0].revents != 0) {
+      return 1;
+    }
+  }
+}  // xd_readline_wait_input()
+
 /**
  * @brief Writes a formatted ANSI escape sequence to the terminal.
  *
@@ -2024,20 +2124,20 @@ char *xd_readline() {
 
     // expand the input buffer
     if (xd_input_length == xd_input_capacity - 1) {
-      char *ptr = (char *)realloc(xd_input_buffer,
-                                  sizeof(char) * xd_input_capacity * 2);
-      if (ptr == NULL) {
-        break;
-      }
+      xd_input_buffer = (char *)xd_alloc_realloc(
+          XD_ALLOC_READLINE, xd_input_buffer,
+          sizeof(char) * xd_input_capacity * 2);
       xd_input_capacity *= 2;
-      xd_input_buffer = ptr;
       xd_readline_return = xd_input_buffer;
     }
 
     xd_readline_prev_read_char = chr;
 
     // read one character
-    ssize_t ret = read(STDIN_FILENO, &chr, 1);
+    ssize_t ret = -1;
+    if (xd_readline_wait_input() == 1) {
+      ret = read(STDIN_FILENO, &chr, 1);
+    }
 
     // EOF or Error while reading
     if (ret <= 0) {
@@ -2061,11 +2161,61 @@ char *xd_readline() {
     chr = XD_RL_ASCII_LF;
     xd_tty_write(&chr, 1);
   }
+  xd_tty_cursor_at_line_start = 1;
 
   xd_tty_restore();
   return xd_readline_return;
 }  // xd_readline()
 
+int xd_readline_watch_fd(int fd, xd_readline_fd_handler_func_t handler) {
+  if (fd < 0 || handler == NULL ||
+      xd_watched_fds_length == XD_RL_WATCHED_FDS_MAX) {
+    return -1;
+  }
+  xd_watched_fds[xd_watched_fds_length].fd = fd;
+  xd_watched_fds[xd_watched_fds_length].handler = handler;
+  xd_watched_fds_length++;
+  return 0;
+}  // xd_readline_watch_fd()
+
+int xd_readline_unwatch_fd(int fd) {
+  for (int i = 0; i < xd_watched_fds_length; i++) {
+    if (xd_watched_fds[i].fd != fd) {
+      continue;
+    }
+    xd_watched_fds[i] = xd_watched_fds[xd_watched_fds_length - 1];
+    xd_watched_fds_length--;
+    return 0;
+  }
+  return -1;
+}  // xd_readline_unwatch_fd()
+
+void xd_readline_output_begin() {
+  xd_tty_input_clear();
+}  // xd_readline_output_begin()
+
+void xd_readline_output_end() {
+  fflush(stdout);
+  xd_tty_cursor_row = 1;
+  xd_tty_cursor_col = 1;
+  xd_tty_input_redraw();
+}  // xd_readline_output_end()
+
+void xd_readline_cursor_unknown() {
+  xd_tty_cursor_at_line_start = 0;
+}  // xd_readline_cursor_unknown()
+
+void xd_readline_prompt_redraw() {
+  // the old prompt is cleared using the tracked character count
+  if (xd_readline_prompt != NULL) {
+    xd_readline_prompt_length = (int)strlen(xd_readline_prompt);
+  }
+  else {
+    xd_readline_prompt_length = 0;
+  }
+  xd_tty_input_redraw();
+}  // xd_readline_prompt_redraw()
+
 void xd_readline_history_clear() {
   for (int i = 0; i <= XD_RL_HISTORY_MAX; i++) {
     xd_history[i]->length = 0;
@@ -2099,15 +2249,9 @@ int xd_readline_history_add(const char *str) {
       new_capacity += LINE_MAX - (new_capacity % LINE_MAX);
     }
 
-    char *ptr =
-        (char *)realloc(history_entry->str, sizeof(char) * new_capacity);
-    if (ptr == NULL) {
-      fprintf(stderr, "xd_readline: failed to allocate memory: %s\n",
-              strerror(errno));
-      return -1;
-    }
+    history_entry->str = (char *)xd_alloc_realloc(
+        XD_ALLOC_READLINE, history_entry->str, sizeof(char) * new_capacity);
     history_entry->capacity = new_capacity;
-    history_entry->str = ptr;
   }
 
   // add to history
@@ -33,12 +33,19 @@
 #include "xd_arg_expander.h"
 #include "xd_command.h"
 #include "xd_comp_generator.h"
+#include "xd_intern.h"
 #include "xd_job.h"
 #include "xd_jobs.h"
+#include "xd_list.h"
+#include "xd_profile.h"
+#include "xd_prompt.h"
 #include "xd_readline.h"
+#include "xd_snapshot.h"
 #include "xd_string.h"
+#include "xd_telemetry.h"
 #include "xd_utils.h"
 #include "xd_vars.h"
+#include "xd_xtrace.h"
 
 // ========================
 // Function Declarations
@@ -52,6 +59,7 @@ static void xd_sh_init(int argc, char **argv);
 static void xd_sh_destroy() __attribute__((destructor));
 static void xd_sh_sigint_handler(int signum);
 static void xd_sh_sigchld_handler(int signum);
+static void xd_sh_sigchld_fd_handler(int fd);
 static int xd_sh_setup_signal_handlers();
 static const char *xd_sh_resolve_home();
 static int xd_sh_source_file(const char *path);
@@ -61,7 +69,7 @@ static int xd_sh_run();
 
 // flex and bison functions
 extern void yylex_scan_string(char *str);
-extern void yylex_scan_file(FILE *file);
+extern int yylex_scan_file(FILE *file, const char *name);
 extern void yylex_scan_stdin();
 extern void yyparse_initialize();
 extern int yyparse();
@@ -86,6 +94,10 @@ volatile sig_atomic_t xd_sh_readline_running = 0;
 volatile sig_atomic_t xd_sh_is_interrupted = 0;
 int xd_sh_last_exit_code = 0;
 pid_t xd_sh_last_bg_job_pid = 0;
+int xd_sh_notify = 0;
+int xd_sh_profile = 0;
+int xd_sh_xtrace = 0;
+int xd_sh_xtrace_time = 0;
 struct termios xd_sh_tty_modes = {0};
 
 // ========================
@@ -234,6 +246,11 @@ static void xd_sh_init(int argc, char **argv) {
   xd_vars_init();
   xd_sh_set_default_env();
 
+  char *profile_path = xd_vars_get(XD_PROFILE_VAR);
+  if (profile_path != NULL && *profile_path != '\0') {
+    xd_sh_profile = 1;
+  }
+
   if (script_arg != NULL) {
     int slash_found = (strchr(script_arg, '/') != NULL);
     char *resolved_path = NULL;
@@ -296,6 +313,9 @@ static void xd_sh_init(int argc, char **argv) {
   xd_sh_pid = pid;
   xd_sh_pgid = pgid;
   xd_jobs_init();
+  if (xd_sh_is_interactive) {
+    xd_readline_watch_fd(xd_jobs_sigchld_fd(), xd_sh_sigchld_fd_handler);
+  }
   xd_aliases_init();
   yyparse_initialize();
   xd_arg_expander_init();
@@ -328,13 +348,16 @@ static void xd_sh_init(int argc, char **argv) {
 
     // setup tab-completion function
     xd_readline_completions_generator = xd_completions_generator;
+
+    // cache the user, host and working directory shown in the prompt
+    xd_prompt_init();
   }
 
   if (command_string != NULL) {
     yylex_scan_string(command_string);
   }
   else if (input_file != NULL) {
-    yylex_scan_file(input_file);
+    yylex_scan_file(input_file, script_arg);
   }
   else {
     yylex_scan_stdin();
@@ -351,8 +374,6 @@ static void xd_sh_init(int argc, char **argv) {
  * @brief Destructor, runs before exit to cleanup after the shell.
  */
 static void xd_sh_destroy() {
-  xd_jobs_sigchld_block();
-
   // save history to file
   if (xd_sh_is_interactive && getpid() == xd_sh_pid) {
     char *histfile = xd_vars_get("HISTFILE");
@@ -363,8 +384,15 @@ static void xd_sh_destroy() {
   yyparse_cleanup();
   xd_jobs_destroy();
   xd_aliases_destroy();
+  xd_profile_destroy();
   xd_vars_destroy();
   xd_arg_expander_destroy();
+  xd_telemetry_destroy();
+  xd_xtrace_destroy();
+  xd_snapshot_destroy();
+  xd_prompt_destroy();
+  xd_intern_destroy();
+  xd_list_pool_clear();
 }  // xd_sh_destroy()
 
 /**
@@ -385,63 +413,38 @@ static void xd_sh_sigint_handler(int signum) {
   errno = saved_errno;
 }  // xd_sh_sigint_handler()
 
+/**
+ * @brief Handles `SIGCHLD` signal.
+ *
+ * Only records the signal, the children are reaped from the main loop by
+ * `xd_jobs_reap()`.
+ *
+ * @param signum The signal number.
+ */
 static void xd_sh_sigchld_handler(int signum) {
   (void)signum;
-  int status;
-  pid_t pid;
   int saved_errno = errno;
-  while (1) {
-    pid = waitpid(-1, &status, WNOHANG | WUNTRACED | WCONTINUED);
-    if (pid <= 0) {
-      if (pid == -1 && errno == EINTR) {
-        continue;
-      }
-      break;
-    }
-
-    xd_job_t *job = xd_jobs_get_with_pid(pid);
-    xd_command_t *command = xd_job_get_command_with_pid(job, pid);
-    if (job == NULL || command == NULL) {
-      continue;
-    }
-
-    int was_stopped = WIFSTOPPED(command->wait_status);
-    command->wait_status = status;
-
-    if (job->commands[job->command_count - 1] == command) {
-      job->wait_status = status;
-    }
-
-    if (WIFCONTINUED(status)) {
-      if (was_stopped) {
-        job->stopped_count--;
-      }
-    }
-    else if (WIFSTOPPED(status)) {
-      if (!was_stopped) {
-        job->stopped_count++;
-      }
-    }
-    else if (WIFEXITED(status) || WIFSIGNALED(status)) {
-      if (was_stopped) {
-        job->stopped_count--;
-      }
-      job->unreaped_count--;
-    }
-
-    if (!xd_job_is_alive(job) || xd_job_is_stopped(job)) {
-      job->notify = 1;
-    }
-
-    struct timespec time_spec;
-    clock_gettime(CLOCK_MONOTONIC, &time_spec);
-    job->last_active =
-        (uint64_t)time_spec.tv_sec * XD_SH_NANOSECONDS_PER_SECOND +
-        (uint64_t)time_spec.tv_nsec;
-  }
+  xd_jobs_sigchld_notify();
   errno = saved_errno;
 }  // xd_sh_sigchld_handler()
 
+/**
+ * @brief Called by `xd_readline()` when a `SIGCHLD` is received while waiting
+ * for input, to reap the children without waiting for the next line, the job
+ * notifications are printed right away when `set -b` is on.
+ *
+ * @param fd The `SIGCHLD` self-pipe read-end (unused).
+ */
+static void xd_sh_sigchld_fd_handler(int fd) {
+  (void)fd;
+  xd_jobs_reap();
+  if (xd_sh_notify && xd_jobs_has_notifications()) {
+    xd_readline_output_begin();
+    xd_jobs_refresh();
+    xd_readline_output_end();
+  }
+}  // xd_sh_sigchld_fd_handler()
+
 /**
  * @brief Sets up the signal handlers.
  *
@@ -517,13 +520,20 @@ static int xd_sh_source_file(const char *path) {
   if (file == NULL) {
     return -1;
   }
+  int is_interactive = xd_sh_is_interactive;
   xd_sh_is_interactive = 0;
-  yylex_scan_file(file);
+  if (yylex_scan_file(file, path) == -1) {
+    xd_sh_is_interactive = is_interactive;
+    fclose(file);
+    return -1;
+  }
   return 0;
 }  // xd_sh_source_file()
 
 /**
- * @brief Pushes startup script files onto the lexer input stack.
+ * @brief Pushes startup script files onto the lexer input stack, or restores
+ * their variables and aliases from the snapshot if `XDSH_SNAPSHOT` is set and
+ * the shell is interactive.
  */
 static void xd_sh_source_startup_files() {
   const char *home = xd_sh_resolve_home();
@@ -533,11 +543,20 @@ static void xd_sh_source_startup_files() {
   char path[PATH_MAX];
   if (xd_sh_is_login) {
     snprintf(path, PATH_MAX, "%s/.xdsh_profile", home);
-    xd_sh_source_file(path);
   }
   else if (xd_sh_is_interactive) {
     snprintf(path, PATH_MAX, "%s/.xdshrc", home);
-    xd_sh_source_file(path);
+  }
+  else {
+    return;
+  }
+
+  int use_snapshot = xd_sh_is_interactive;
+  if (use_snapshot && xd_snapshot_restore(path) == 0) {
+    return;
+  }
+  if (xd_sh_source_file(path) == 0 && use_snapshot) {
+    xd_snapshot_record_start(path);
   }
 }  // xd_sh_source_startup_files()
 
@@ -590,39 +609,7 @@ static int xd_sh_run() {
 // ========================
 
 void xd_sh_update_prompt() {
-  struct passwd *pwd = getpwuid(getuid());
-  const char *username = (pwd == NULL) ? "" : pwd->pw_name;
-  char prompt_char = (strcmp(username, "root") == 0) ? '#' : '$';
-
-  char hostname[PATH_MAX] = {0};
-  if (gethostname(hostname, PATH_MAX) == -1) {
-    hostname[0] = '\0';
-  }
-
-  char cwd[PATH_MAX] = {0};
-  if (getcwd(cwd, PATH_MAX) == NULL) {
-    cwd[0] = '\0';
-  }
-
-  const char *HOME = xd_vars_get("HOME");
-  int home_len = (HOME == NULL) ? 0 : (int)strlen(HOME);
-
-  int use_tilde = 0;
-  if (home_len > 0 && HOME[home_len - 1] != '/' &&
-      strncmp(HOME, cwd, home_len) == 0 &&
-      (cwd[home_len] == '/' || cwd[home_len] == '\0')) {
-    use_tilde = 1;
-  }
-  else {
-    home_len = 0;
-  }
-
-  snprintf(xd_sh_prompt, XD_SH_PROMPT_MAX_LENGTH,
-           XD_UTILS_CNSOL_FG_RED "%s@%s" XD_UTILS_CNSOL_RESET
-                                 ":" XD_UTILS_CNSOL_FG_BLUE
-                                 "%s%s" XD_UTILS_CNSOL_RESET "%c ",
-           username, hostname, use_tilde ? "~" : "", cwd + home_len,
-           prompt_char);
+  snprintf(xd_sh_prompt, XD_SH_PROMPT_MAX_LENGTH, "%s", xd_prompt_get());
 }  // xd_sh_update_prompt()
 
 char *xd_sh_path_search(const char *name) {
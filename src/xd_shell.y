@@ -17,6 +17,7 @@
 
 #include <errno.h>
 #include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -28,6 +29,7 @@
 #include "xd_shell.h"
 #include "xd_string.h"
 #include "xd_utils.h"
+#include "xd_vec.h"
 
 // ========================
 // Macros
@@ -44,6 +46,7 @@ void yyerror(const char *s);
 extern void yylex_initialize();
 extern void yylex_cleanup();
 extern int yylex();
+extern char *yylex_job_location(uint64_t *start_time);
 extern int xd_lex_fatal_error;
 
 // ========================
@@ -111,6 +114,7 @@ xd_command_t *xd_current_command = NULL;
 %token PIPE AMPERSAND NEWLINE
 %token LT GT GT_GT TWO_GT TWO_GT_GT GT_AMPERSAND GT_GT_AMPERSAND
 %token LEX_INTR
+%token TIME TIME_POSIX
 
 %nterm <string_pair> redirection_arg
 
@@ -129,25 +133,37 @@ command_line:
   ;
 
 job:
-    command_list optional_ampersand NEWLINE {
-      xd_jobs_sigchld_block();
+    optional_time command_list optional_ampersand NEWLINE {
+      uint64_t parse_start = 0;
+      xd_current_job->location = yylex_job_location(&parse_start);
+      if (xd_current_job->location != NULL) {
+        uint64_t parse_time = xd_utils_now() - parse_start;
+        if (parse_time > xd_current_job->expansion_time) {
+          xd_current_job->parse_time =
+              parse_time - xd_current_job->expansion_time;
+        }
+      }
       xd_job_execute(xd_current_job);
       xd_jobs_refresh();
-      xd_jobs_sigchld_unblock();
 
       xd_current_job = xd_job_create();
       usleep(1000);
     }
   | NEWLINE {
-      xd_jobs_sigchld_block();
       xd_jobs_refresh();
-      xd_jobs_sigchld_unblock();
+      usleep(1000);
+    }
+  | time_keyword NEWLINE {
+      // timing an empty pipeline reports zero times
+      xd_jobs_report_times(xd_current_job);
+      xd_jobs_refresh();
+
+      xd_job_destroy(xd_current_job);
+      xd_current_job = xd_job_create();
       usleep(1000);
     }
   | error NEWLINE {
-      xd_jobs_sigchld_block();
       xd_jobs_refresh();
-      xd_jobs_sigchld_unblock();
 
       xd_command_destroy(xd_current_command);
       xd_current_command = NULL;
@@ -161,9 +177,7 @@ job:
       usleep(1000);
     }
   | error LEX_INTR {
-      xd_jobs_sigchld_block();
       xd_jobs_refresh();
-      xd_jobs_sigchld_unblock();
 
       xd_command_destroy(xd_current_command);
       xd_current_command = NULL;
@@ -178,6 +192,20 @@ job:
     }
   ;
 
+optional_time:
+    time_keyword
+  | %empty
+  ;
+
+time_keyword:
+    TIME {
+      xd_current_job->time_mode = XD_JOB_TIME_DEFAULT;
+    }
+  | TIME TIME_POSIX {
+      xd_current_job->time_mode = XD_JOB_TIME_POSIX;
+    }
+  ;
+
 optional_ampersand:
     AMPERSAND {
       xd_current_job->is_background = 1;
@@ -192,7 +220,7 @@ command_list:
 
 command:
     argument_list io_redirection_list {
-      xd_current_command->str = xd_utils_strdup(xd_command_str->str);
+      xd_current_command->str = xd_string_release(xd_command_str);
       xd_job_add_command(xd_current_job, xd_current_command);
       xd_current_command = NULL;
     }
@@ -215,18 +243,20 @@ argument:
 
       xd_string_append_str(xd_command_str, $1);
 
-      xd_list_t *list = xd_arg_expander($1);
+      uint64_t expansion_start = xd_utils_now();
+      xd_vec_t *list = xd_arg_expander($1);
+      xd_current_job->expansion_time += xd_utils_now() - expansion_start;
       if (list == NULL) {
-        xd_list_destroy(list);
+        xd_vec_destroy(list);
         free($1);
         YYERROR;
       }
       free($1);
 
-      for (xd_list_node_t *node = list->head; node != NULL; node = node->next) {
-        xd_command_add_arg(xd_current_command, node->data);
+      for (int i = 0; i < list->length; i++) {
+        xd_command_add_arg(xd_current_command, list->data[i]);
       }
-      xd_list_destroy(list);
+      xd_vec_destroy(list);
     }
   ;
 
@@ -342,15 +372,17 @@ io_redirection:
 
 redirection_arg:
     ARG {
-      xd_list_t *list = xd_arg_expander($1);
+      uint64_t expansion_start = xd_utils_now();
+      xd_vec_t *list = xd_arg_expander($1);
+      xd_current_job->expansion_time += xd_utils_now() - expansion_start;
       if (list == NULL) {
-        xd_list_destroy(list);
+        xd_vec_destroy(list);
         free($1);
         YYERROR;
       }
       if (list->length != 1) {
         fprintf(stderr, "xd-shell: %s: ambiguous redirect\n", $1);
-        xd_list_destroy(list);
+        xd_vec_destroy(list);
         free($1);
         YYERROR;
       }
@@ -363,10 +395,10 @@ redirection_arg:
         exit(EXIT_FAILURE);
       }
       pair->first = $1;
-      pair->second = xd_utils_strdup(list->head->data);
+      pair->second = xd_utils_strdup(list->data[0]);
 
       $$ = pair;
-      xd_list_destroy(list);
+      xd_vec_destroy(list);
     }
   ;
 
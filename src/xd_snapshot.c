@@ -0,0 +1,652 @@
+/*
+ * ==============================================================================
+ * File: xd_snapshot.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_snapshot.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "xd_aliases.h"
+#include "xd_builtins.h"
+#include "xd_intern.h"
+#include "xd_map.h"
+#include "xd_string.h"
+#include "xd_utils.h"
+#include "xd_vars.h"
+#include "xd_vec.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief First line of a snapshot, changed whenever the format changes.
+ */
+#define XD_SNAPSHOT_MAGIC "xd-shell snapshot 2\n"
+
+/**
+ * @brief Permissions of a newly written snapshot.
+ */
+#define XD_SNAPSHOT_FILE_MODE (0600)
+
+// ========================
+// Typedefs
+// ========================
+
+/**
+ * @brief Represents the position of the parser in a snapshot.
+ */
+typedef struct xd_snapshot_reader_t {
+  char *pos;  // The next byte to be read
+  char *end;  // The end of the snapshot
+} xd_snapshot_reader_t;
+
+// ========================
+// Function Declarations
+// ========================
+
+static char *xd_snapshot_var_state(const char *name);
+static void xd_snapshot_on_access(const char *name, int is_write);
+static void xd_snapshot_append_state(xd_string_t *snapshot,
+                                     const char *state);
+static int xd_snapshot_write(const xd_string_t *snapshot);
+static char *xd_snapshot_read_word(xd_snapshot_reader_t *reader);
+static int xd_snapshot_read_number(xd_snapshot_reader_t *reader, long *out);
+static char *xd_snapshot_read_data(xd_snapshot_reader_t *reader);
+static int xd_snapshot_read_state(xd_snapshot_reader_t *reader, char **value,
+                                  int *is_exported);
+static int xd_snapshot_parse(char *data, size_t length, const char *rc_path,
+                             int apply);
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief PID of the process recording the snapshot (`0` if not recording), a
+ * subshell inherits the recording of its parent but must not save it.
+ */
+static pid_t xd_snapshot_owner = 0;
+
+/**
+ * @brief Path of the snapshot being recorded.
+ */
+static char *xd_snapshot_path = NULL;
+
+/**
+ * @brief Working directory when the recording started, the snapshot is not
+ * saved if the startup files change it.
+ */
+static char xd_snapshot_cwd[PATH_MAX];
+
+/**
+ * @brief Whether the recording can still be saved, cleared when a sourced
+ * file can't be tracked.
+ */
+static int xd_snapshot_is_valid = 0;
+
+/**
+ * @brief The `F` lines of the files sourced while recording, the startup file
+ * first.
+ */
+static xd_string_t *xd_snapshot_files = NULL;
+
+/**
+ * @brief Hash-map of the variables accessed while recording, maps the name
+ * symbol to its state string.
+ *
+ * The first character of the state is `1` if the variable was read before
+ * being set, the second is `1` if it was set or removed, and the rest is its
+ * state before the first access (see `xd_snapshot_var_state()`).
+ */
+static xd_map_t *xd_snapshot_names = NULL;
+
+/**
+ * @brief The names (symbols) of the shell options set while recording, each
+ * saved with its state when the recording is saved.
+ */
+static xd_vec_t *xd_snapshot_options = NULL;
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Encodes the current state of the variable with the passed name,
+ * `xd_vars_access_hook` must not be set while calling this.
+ *
+ * @param name The name of the variable.
+ *
+ * @return `-` if the variable is unset, otherwise `1` if it's exported or `0`
+ * if not followed by its value.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ */
+static char *xd_snapshot_var_state(const char *name) {
+  char *value = xd_vars_get((char *)name);
+  xd_string_t *state = xd_string_create();
+  if (value == NULL) {
+    xd_string_append_chr(state, '-');
+  }
+  else {
+    xd_string_append_chr(state, xd_vars_is_exported((char *)name) ? '1' : '0');
+    xd_string_append_str(state, value);
+  }
+  char *ret = xd_string_release(state);
+  xd_string_destroy(state);
+  return ret;
+}  // xd_snapshot_var_state()
+
+/**
+ * @brief Records the first access to each variable while recording, set as
+ * `xd_vars_access_hook`.
+ *
+ * @param name The name of the variable.
+ * @param is_write `1` if the variable is about to be set or removed, `0` if it
+ * is about to be read.
+ */
+static void xd_snapshot_on_access(const char *name, int is_write) {
+  const char *symbol = xd_intern(name);
+  char *state = xd_map_get(xd_snapshot_names, (void *)symbol);
+  if (state != NULL) {
+    if (is_write) {
+      state[1] = '1';
+    }
+    return;
+  }
+
+  xd_vars_access_hook = NULL;
+  char *prev_state = xd_snapshot_var_state(symbol);
+  xd_vars_access_hook = xd_snapshot_on_access;
+
+  xd_string_t *new_state = xd_string_create();
+  xd_string_append_chr(new_state, is_write ? '0' : '1');
+  xd_string_append_chr(new_state, is_write ? '1' : '0');
+  xd_string_append_str(new_state, prev_state);
+  xd_map_put(xd_snapshot_names, (void *)symbol, new_state->str);
+  xd_string_destroy(new_state);
+  free(prev_state);
+}  // xd_snapshot_on_access()
+
+/**
+ * @brief Appends the passed variable state to the passed snapshot, ending the
+ * current line.
+ *
+ * @param snapshot The snapshot being built.
+ * @param state The state as returned by `xd_snapshot_var_state()`.
+ */
+static void xd_snapshot_append_state(xd_string_t *snapshot,
+                                     const char *state) {
+  if (*state == '-') {
+    xd_string_append_str(snapshot, "-\n");
+    return;
+  }
+  xd_string_append_fmt(snapshot, "%c %zu %s\n", *state, strlen(state + 1),
+                       state + 1);
+}  // xd_snapshot_append_state()
+
+/**
+ * @brief Writes the passed snapshot to a temporary file and renames it to
+ * `xd_snapshot_path`.
+ *
+ * @param snapshot The snapshot to be written.
+ *
+ * @return `0` on success, or `-1` on failure.
+ */
+static int xd_snapshot_write(const xd_string_t *snapshot) {
+  xd_string_t *tmp_path = xd_string_create();
+  xd_string_append_fmt(tmp_path, "%s.%d.tmp", xd_snapshot_path, (int)getpid());
+
+  int fd = open(tmp_path->str, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                XD_SNAPSHOT_FILE_MODE);
+  if (fd == -1) {
+    xd_string_destroy(tmp_path);
+    return -1;
+  }
+
+  const char *data = snapshot->str;
+  size_t length = (size_t)snapshot->length;
+  while (length > 0) {
+    ssize_t written = write(fd, data, length);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+
+  int ret = (length == 0) ? 0 : -1;
+  if (close(fd) == -1) {
+    ret = -1;
+  }
+  if (ret == 0 && rename(tmp_path->str, xd_snapshot_path) == -1) {
+    ret = -1;
+  }
+  if (ret == -1) {
+    int saved_errno = errno;
+    unlink(tmp_path->str);
+    errno = saved_errno;
+  }
+  xd_string_destroy(tmp_path);
+  return ret;
+}  // xd_snapshot_write()
+
+/**
+ * @brief Reads the next word from the snapshot and NUL-terminates it in place.
+ *
+ * A word ends with a space or a newline (or a NUL written by a previous parse
+ * of the same snapshot).
+ *
+ * @param reader The position in the snapshot.
+ *
+ * @return The word, or `NULL` if it's empty or not terminated.
+ */
+static char *xd_snapshot_read_word(xd_snapshot_reader_t *reader) {
+  char *word = reader->pos;
+  while (reader->pos < reader->end && *reader->pos != ' ' &&
+         *reader->pos != '\n' && *reader->pos != '\0') {
+    reader->pos++;
+  }
+  if (reader->pos == reader->end || reader->pos == word) {
+    return NULL;
+  }
+  *reader->pos++ = '\0';
+  return word;
+}  // xd_snapshot_read_word()
+
+/**
+ * @brief Reads the next word from the snapshot as a number.
+ *
+ * @param reader The position in the snapshot.
+ * @param out Output parameter, the number will be stored here on success.
+ *
+ * @return `0` on success, or `-1` on failure.
+ */
+static int xd_snapshot_read_number(xd_snapshot_reader_t *reader, long *out) {
+  char *word = xd_snapshot_read_word(reader);
+  if (word == NULL) {
+    return -1;
+  }
+  return xd_utils_strtol(word, out);
+}  // xd_snapshot_read_number()
+
+/**
+ * @brief Reads a length-prefixed string ending the current line from the
+ * snapshot and NUL-terminates it in place.
+ *
+ * @param reader The position in the snapshot.
+ *
+ * @return The string, or `NULL` on failure.
+ */
+static char *xd_snapshot_read_data(xd_snapshot_reader_t *reader) {
+  long length;
+  if (xd_snapshot_read_number(reader, &length) == -1 || length < 0 ||
+      length >= reader->end - reader->pos) {
+    return NULL;
+  }
+  char *data = reader->pos;
+  reader->pos += length;
+  if (*reader->pos != '\n' && *reader->pos != '\0') {
+    return NULL;
+  }
+  *reader->pos++ = '\0';
+  return data;
+}  // xd_snapshot_read_data()
+
+/**
+ * @brief Reads a variable state written by `xd_snapshot_append_state()`.
+ *
+ * @param reader The position in the snapshot.
+ * @param value Output parameter, the value or `NULL` if the variable is unset.
+ * @param is_exported Output parameter, whether the variable is exported.
+ *
+ * @return `0` on success, or `-1` on failure.
+ */
+static int xd_snapshot_read_state(xd_snapshot_reader_t *reader, char **value,
+                                  int *is_exported) {
+  char *word = xd_snapshot_read_word(reader);
+  if (word == NULL) {
+    return -1;
+  }
+  if (strcmp(word, "-") == 0) {
+    *value = NULL;
+    *is_exported = 0;
+    return 0;
+  }
+  if (strcmp(word, "0") != 0 && strcmp(word, "1") != 0) {
+    return -1;
+  }
+  *is_exported = (*word == '1');
+  *value = xd_snapshot_read_data(reader);
+  return (*value == NULL) ? -1 : 0;
+}  // xd_snapshot_read_state()
+
+/**
+ * @brief Parses the passed snapshot, either checking that it's still valid or
+ * applying it.
+ *
+ * @param data The snapshot, without the magic line.
+ * @param length The length of `data`.
+ * @param rc_path The resolved path of the startup file.
+ * @param apply `0` to check that every file and variable the snapshot depends
+ * on is unchanged, `1` to set the variables and aliases it holds.
+ *
+ * @return `0` on success, `-1` if the snapshot is malformed or out of date.
+ */
+static int xd_snapshot_parse(char *data, size_t length, const char *rc_path,
+                             int apply) {
+  xd_snapshot_reader_t reader = {data, data + length};
+  int file_count = 0;
+  while (reader.pos < reader.end) {
+    char *type = xd_snapshot_read_word(&reader);
+    if (type == NULL) {
+      return -1;
+    }
+
+    if (strcmp(type, "F") == 0) {
+      long sec, nsec, size;
+      if (xd_snapshot_read_number(&reader, &sec) == -1 ||
+          xd_snapshot_read_number(&reader, &nsec) == -1 ||
+          xd_snapshot_read_number(&reader, &size) == -1) {
+        return -1;
+      }
+      char *path = xd_snapshot_read_data(&reader);
+      if (path == NULL) {
+        return -1;
+      }
+      if (!apply) {
+        struct stat st;
+        if ((file_count == 0 && strcmp(path, rc_path) != 0) ||
+            stat(path, &st) == -1 || st.st_mtim.tv_sec != sec ||
+            st.st_mtim.tv_nsec != nsec || st.st_size != size) {
+          return -1;
+        }
+      }
+      file_count++;
+    }
+    else if (strcmp(type, "D") == 0 || strcmp(type, "V") == 0) {
+      char *name = xd_snapshot_read_word(&reader);
+      char *value;
+      int is_exported;
+      if (name == NULL ||
+          xd_snapshot_read_state(&reader, &value, &is_exported) == -1) {
+        return -1;
+      }
+      if (*type == 'D' && !apply) {
+        char *cur_value = xd_vars_get(name);
+        if ((value == NULL) != (cur_value == NULL)) {
+          return -1;
+        }
+        if (value != NULL && (strcmp(value, cur_value) != 0 ||
+                              xd_vars_is_exported(name) != is_exported)) {
+          return -1;
+        }
+      }
+      else if (*type == 'V' && apply) {
+        if (value == NULL) {
+          xd_vars_remove(name);
+        }
+        else {
+          xd_vars_put(name, value, is_exported);
+        }
+      }
+    }
+    else if (strcmp(type, "O") == 0) {
+      char *name = xd_snapshot_read_word(&reader);
+      long value;
+      if (name == NULL || xd_snapshot_read_number(&reader, &value) == -1 ||
+          (value != 0 && value != 1)) {
+        return -1;
+      }
+      int *flag = xd_builtins_option_flag(name);
+      if (flag == NULL) {
+        return -1;
+      }
+      if (apply) {
+        *flag = (int)value;
+      }
+    }
+    else if (strcmp(type, "A") == 0) {
+      char *name = xd_snapshot_read_word(&reader);
+      char *value = (name == NULL) ? NULL : xd_snapshot_read_data(&reader);
+      if (value == NULL) {
+        return -1;
+      }
+      if (apply) {
+        xd_aliases_put(name, value);
+      }
+    }
+    else {
+      return -1;
+    }
+  }
+  return (file_count == 0) ? -1 : 0;
+}  // xd_snapshot_parse()
+
+// ========================
+// Public Functions
+// ========================
+
+int xd_snapshot_restore(const char *rc_path) {
+  const char *path = xd_vars_get(XD_SNAPSHOT_VAR);
+  if (path == NULL || *path == '\0') {
+    return -1;
+  }
+  char rc_real_path[PATH_MAX];
+  if (realpath(rc_path, rc_real_path) == NULL) {
+    return -1;
+  }
+
+  // only trust a regular file that no one else can write
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return -1;
+  }
+  struct stat st;
+  if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) ||
+      st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+    close(fd);
+    return -1;
+  }
+
+  size_t length = (size_t)st.st_size;
+  char *data = (char *)malloc(length + 1);
+  if (data == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  size_t total = 0;
+  while (total < length) {
+    ssize_t count = read(fd, data + total, length - total);
+    if (count == -1 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      break;
+    }
+    total += (size_t)count;
+  }
+  close(fd);
+  data[total] = '\0';
+
+  int ret = -1;
+  size_t magic_length = strlen(XD_SNAPSHOT_MAGIC);
+  if (total == length && length >= magic_length &&
+      memcmp(data, XD_SNAPSHOT_MAGIC, magic_length) == 0 &&
+      xd_snapshot_parse(data + magic_length, length - magic_length,
+                        rc_real_path, 0) == 0) {
+    xd_snapshot_parse(data + magic_length, length - magic_length,
+                      rc_real_path, 1);
+    ret = 0;
+  }
+  free(data);
+  return ret;
+}  // xd_snapshot_restore()
+
+void xd_snapshot_record_start(const char *rc_path) {
+  xd_snapshot_destroy();
+
+  const char *path = xd_vars_get(XD_SNAPSHOT_VAR);
+  if (path == NULL || *path == '\0') {
+    return;
+  }
+  if (getcwd(xd_snapshot_cwd, sizeof(xd_snapshot_cwd)) == NULL) {
+    return;
+  }
+
+  xd_snapshot_path = xd_utils_strdup((char *)path);
+  xd_snapshot_files = xd_string_create();
+  xd_snapshot_names = xd_map_create(
+      xd_intern_copy_func, xd_intern_destroy_func, xd_intern_comp_func,
+      xd_utils_str_copy_func, xd_utils_str_destroy_func,
+      xd_utils_str_comp_func, xd_intern_hash_func);
+  xd_snapshot_options = xd_vec_create(
+      xd_intern_copy_func, xd_intern_destroy_func, xd_intern_comp_func);
+  xd_snapshot_owner = getpid();
+  xd_snapshot_is_valid = 1;
+  xd_snapshot_track_file(rc_path);
+  xd_vars_access_hook = xd_snapshot_on_access;
+}  // xd_snapshot_record_start()
+
+void xd_snapshot_track_file(const char *path) {
+  if (!xd_snapshot_is_recording() || !xd_snapshot_is_valid) {
+    return;
+  }
+
+  char real_path[PATH_MAX];
+  struct stat st;
+  if (realpath(path, real_path) == NULL || stat(real_path, &st) == -1) {
+    xd_snapshot_is_valid = 0;
+    return;
+  }
+  xd_string_append_fmt(xd_snapshot_files, "F %ld %ld %ld %zu %s\n",
+                       (long)st.st_mtim.tv_sec, (long)st.st_mtim.tv_nsec,
+                       (long)st.st_size, strlen(real_path), real_path);
+}  // xd_snapshot_track_file()
+
+void xd_snapshot_track_option(const char *name) {
+  if (!xd_snapshot_is_recording()) {
+    return;
+  }
+  const char *symbol = xd_intern(name);
+  for (int i = 0; i < xd_snapshot_options->length; i++) {
+    if (xd_vec_get(xd_snapshot_options, i) == symbol) {
+      return;
+    }
+  }
+  xd_vec_push(xd_snapshot_options, (void *)symbol);
+}  // xd_snapshot_track_option()
+
+int xd_snapshot_is_recording() {
+  return xd_snapshot_owner != 0 && xd_snapshot_owner == getpid();
+}  // xd_snapshot_is_recording()
+
+void xd_snapshot_save() {
+  if (!xd_snapshot_is_recording()) {
+    return;
+  }
+  xd_vars_access_hook = NULL;
+
+  // a changed working directory can't be restored
+  char cwd[PATH_MAX];
+  if (getcwd(cwd, sizeof(cwd)) == NULL || strcmp(cwd, xd_snapshot_cwd) != 0) {
+    xd_snapshot_is_valid = 0;
+  }
+  if (!xd_snapshot_is_valid) {
+    xd_snapshot_destroy();
+    return;
+  }
+
+  xd_string_t *snapshot = xd_string_create();
+  xd_string_append_str(snapshot, XD_SNAPSHOT_MAGIC);
+  xd_string_append_str(snapshot, xd_snapshot_files->str);
+
+  // dependencies first, so they are all checked before anything is applied
+  for (int i = 0; i < xd_snapshot_names->bucket_count; i++) {
+    xd_list_t *bucket = xd_snapshot_names->buckets[i];
+    for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
+      xd_bucket_entry_t *entry = node->data;
+      char *state = entry->value;
+      if (state[0] == '1') {
+        xd_string_append_fmt(snapshot, "D %s ", (char *)entry->key);
+        xd_snapshot_append_state(snapshot, state + 2);
+      }
+    }
+  }
+  for (int i = 0; i < xd_snapshot_names->bucket_count; i++) {
+    xd_list_t *bucket = xd_snapshot_names->buckets[i];
+    for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
+      xd_bucket_entry_t *entry = node->data;
+      char *state = entry->value;
+      if (state[1] == '1') {
+        char *cur_state = xd_snapshot_var_state(entry->key);
+        xd_string_append_fmt(snapshot, "V %s ", (char *)entry->key);
+        xd_snapshot_append_state(snapshot, cur_state);
+        free(cur_state);
+      }
+    }
+  }
+
+  for (int i = 0; i < xd_snapshot_options->length; i++) {
+    char *name = xd_vec_get(xd_snapshot_options, i);
+    int *flag = xd_builtins_option_flag(name);
+    if (flag != NULL) {
+      xd_string_append_fmt(snapshot, "O %s %d\n", name, *flag ? 1 : 0);
+    }
+  }
+
+  xd_vec_t *aliases = xd_aliases_names_list();
+  for (int i = 0; aliases != NULL && i < aliases->length; i++) {
+    char *name = xd_vec_get(aliases, i);
+    char *value = xd_aliases_get(name);
+    xd_string_append_fmt(snapshot, "A %s %zu %s\n", name, strlen(value),
+                         value);
+  }
+  xd_vec_destroy(aliases);
+
+  if (xd_snapshot_write(snapshot) == -1) {
+    fprintf(stderr, "xd-shell: %s: %s: %s\n", XD_SNAPSHOT_VAR,
+            xd_snapshot_path, strerror(errno));
+  }
+  xd_string_destroy(snapshot);
+  xd_snapshot_destroy();
+}  // xd_snapshot_save()
+
+void xd_snapshot_destroy() {
+  if (xd_vars_access_hook == xd_snapshot_on_access) {
+    xd_vars_access_hook = NULL;
+  }
+  xd_map_destroy(xd_snapshot_names);
+  xd_vec_destroy(xd_snapshot_options);
+  xd_string_destroy(xd_snapshot_files);
+  free(xd_snapshot_path);
+  xd_snapshot_names = NULL;
+  xd_snapshot_options = NULL;
+  xd_snapshot_files = NULL;
+  xd_snapshot_path = NULL;
+  xd_snapshot_owner = 0;
+  xd_snapshot_is_valid = 0;
+}  // xd_snapshot_destroy()
@@ -15,27 +15,61 @@
 
 #include "xd_string.h"
 
-#include <errno.h>
 #include <limits.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "xd_alloc.h"
+
+// ========================
+// Function Declarations
+// ========================
+
+static void xd_string_grow(xd_string_t *string, int min_capacity);
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Grows the buffer of the passed string to at least `min_capacity`
+ * bytes, doubling the capacity so that repeated appends stay amortized O(1).
+ *
+ * @param string A pointer to the `xd_string_t` to grow.
+ * @param min_capacity The minimum capacity in bytes including '\0'.
+ */
+static void xd_string_grow(xd_string_t *string, int min_capacity) {
+  int new_capacity = string->capacity;
+  while (new_capacity < min_capacity) {
+    new_capacity = (new_capacity > INT_MAX / 2) ? min_capacity
+                                                : new_capacity * 2;
+  }
+
+  if (string->str == string->small) {
+    char *str = (char *)xd_alloc_malloc(XD_ALLOC_STRING,
+                                        sizeof(char) * new_capacity);
+    memcpy(str, string->small, string->length + 1);
+    string->str = str;
+  }
+  else {
+    string->str = (char *)xd_alloc_realloc(XD_ALLOC_STRING, string->str,
+                                           sizeof(char) * new_capacity);
+  }
+  string->capacity = new_capacity;
+}  // xd_string_grow()
+
 // ========================
 // Public Functions
 // ========================
 
 xd_string_t *xd_string_create() {
-  xd_string_t *string = (xd_string_t *)malloc(sizeof(xd_string_t));
-  char *str = (char *)malloc(sizeof(char) * XD_STR_DEF_CAP);
-  if (string == NULL || str == NULL) {
-    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-            strerror(errno));
-    exit(EXIT_FAILURE);
-  }
+  xd_string_t *string =
+      (xd_string_t *)xd_alloc_malloc(XD_ALLOC_STRING, sizeof(xd_string_t));
   string->length = 0;
   string->capacity = XD_STR_DEF_CAP;
-  string->str = str;
+  string->str = string->small;
   string->str[0] = '\0';
   return string;
 }  // xd_string_create()
@@ -44,8 +78,10 @@ void xd_string_destroy(xd_string_t *string) {
   if (string == NULL) {
     return;
   }
-  free(string->str);
-  free(string);
+  if (string->str != string->small) {
+    xd_alloc_free(XD_ALLOC_STRING, string->str);
+  }
+  xd_alloc_free(XD_ALLOC_STRING, string);
 }  // xd_string_destroy()
 
 void xd_string_clear(xd_string_t *string) {
@@ -60,30 +96,7 @@ void xd_string_append_str(xd_string_t *string, const char *str) {
   if (string == NULL || str == NULL) {
     return;
   }
-
-  int str_len = (int)strlen(str);
-
-  // resize if needed
-  if (string->length + str_len > string->capacity - 1) {
-    // resize to multiple of `XD_STR_DEF_CAP`
-    int new_capacity = string->length + str_len + 1;
-    if (new_capacity % XD_STR_DEF_CAP != 0) {
-      new_capacity += XD_STR_DEF_CAP - (new_capacity % XD_STR_DEF_CAP);
-    }
-
-    char *ptr = (char *)realloc(string->str, sizeof(char) * new_capacity);
-    if (ptr == NULL) {
-      fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-              strerror(errno));
-      exit(EXIT_FAILURE);
-    }
-
-    string->str = ptr;
-    string->capacity = new_capacity;
-  }
-  memcpy(string->str + string->length, str, str_len);
-  string->length += str_len;
-  string->str[string->length] = '\0';
+  xd_string_append_n(string, str, (int)strlen(str));
 }  // xd_string_append_str()
 
 void xd_string_append_chr(xd_string_t *string, char chr) {
@@ -91,24 +104,78 @@ void xd_string_append_chr(xd_string_t *string, char chr) {
     return;
   }
 
-  // resize if needed
   if (string->length + 1 > string->capacity - 1) {
-    // resize to multiple of `XD_STR_DEF_CAP`
-    int new_capacity = string->length + 2;
-    if (new_capacity % XD_STR_DEF_CAP != 0) {
-      new_capacity += XD_STR_DEF_CAP - (new_capacity % XD_STR_DEF_CAP);
-    }
-
-    char *ptr = (char *)realloc(string->str, sizeof(char) * new_capacity);
-    if (ptr == NULL) {
-      fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-              strerror(errno));
-      exit(EXIT_FAILURE);
-    }
-
-    string->str = ptr;
-    string->capacity = new_capacity;
+    xd_string_grow(string, string->length + 2);
   }
   string->str[string->length++] = chr;
   string->str[string->length] = '\0';
 }  // xd_string_append_chr()
+
+void xd_string_append_n(xd_string_t *string, const char *str, int n) {
+  if (string == NULL || str == NULL || n <= 0) {
+    return;
+  }
+
+  if (string->length + n > string->capacity - 1) {
+    xd_string_grow(string, string->length + n + 1);
+  }
+  memcpy(string->str + string->length, str, n);
+  string->length += n;
+  string->str[string->length] = '\0';
+}  // xd_string_append_n()
+
+void xd_string_append_fmt(xd_string_t *string, const char *format, ...) {
+  if (string == NULL || format == NULL) {
+    return;
+  }
+
+  va_list args;
+  va_list args_copy;
+  va_start(args, format);
+  va_copy(args_copy, args);
+
+  // try formatting into the free space first, most output fits
+  int room = string->capacity - string->length;
+  int n = vsnprintf(string->str + string->length, room, format, args);
+  if (n >= room) {
+    xd_string_grow(string, string->length + n + 1);
+    vsnprintf(string->str + string->length, n + 1, format, args_copy);
+  }
+  if (n > 0) {
+    string->length += n;
+  }
+  string->str[string->length] = '\0';
+
+  va_end(args_copy);
+  va_end(args);
+}  // xd_string_append_fmt()
+
+void xd_string_reserve(xd_string_t *string, int capacity) {
+  if (string == NULL || capacity <= string->capacity) {
+    return;
+  }
+  xd_string_grow(string, capacity);
+}  // xd_string_reserve()
+
+char *xd_string_release(xd_string_t *string) {
+  if (string == NULL) {
+    return NULL;
+  }
+
+  char *str;
+  if (string->str == string->small) {
+    str = (char *)xd_alloc_malloc(XD_ALLOC_STRING,
+                                  sizeof(char) * (string->length + 1));
+    memcpy(str, string->small, string->length + 1);
+  }
+  else {
+    str = string->str;
+  }
+  xd_alloc_hand_off(XD_ALLOC_STRING, str);
+
+  string->str = string->small;
+  string->str[0] = '\0';
+  string->length = 0;
+  string->capacity = XD_STR_DEF_CAP;
+  return str;
+}  // xd_string_release()
@@ -0,0 +1,273 @@
+/*
+ * ==============================================================================
+ * File: xd_telemetry.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_telemetry.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "xd_job.h"
+#include "xd_string.h"
+#include "xd_utils.h"
+#include "xd_vars.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Size of the buffer holding the records not yet written to the log.
+ */
+#define XD_TELEMETRY_BUFFER_SIZE (8192)
+
+/**
+ * @brief Permissions of a newly created telemetry log.
+ */
+#define XD_TELEMETRY_FILE_MODE (0644)
+
+// ========================
+// Function Declarations
+// ========================
+
+static void xd_telemetry_close();
+static int xd_telemetry_open(const char *path);
+static void xd_telemetry_write(const char *data, size_t length);
+static void xd_telemetry_append_number(xd_string_t *record, const char *key,
+                                       uint64_t value);
+static void xd_telemetry_append_escaped(xd_string_t *record, const char *str);
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief Records not yet written to the log.
+ */
+static char xd_telemetry_buffer[XD_TELEMETRY_BUFFER_SIZE];
+
+/**
+ * @brief Number of bytes used in `xd_telemetry_buffer`.
+ */
+static size_t xd_telemetry_length = 0;
+
+/**
+ * @brief PID of the process that buffered the records, a subshell inherits
+ * the buffer of its parent but must not write it.
+ */
+static pid_t xd_telemetry_owner = 0;
+
+/**
+ * @brief File descriptor of the open log (`-1` if not open).
+ */
+static int xd_telemetry_fd = -1;
+
+/**
+ * @brief Path of the open log, kept after a failed open to report the error
+ * only once.
+ */
+static char *xd_telemetry_path = NULL;
+
+/**
+ * @brief Dynamic string for building a record.
+ */
+static xd_string_t *xd_telemetry_record_str = NULL;
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Flushes the buffered records and closes the log.
+ */
+static void xd_telemetry_close() {
+  xd_telemetry_flush();
+  if (xd_telemetry_fd != -1) {
+    close(xd_telemetry_fd);
+    xd_telemetry_fd = -1;
+  }
+  free(xd_telemetry_path);
+  xd_telemetry_path = NULL;
+}  // xd_telemetry_close()
+
+/**
+ * @brief Opens the log at the passed path for appending, closing the
+ * previously open one.
+ *
+ * @param path The path of the log.
+ *
+ * @return `0` on success, or `-1` on failure.
+ */
+static int xd_telemetry_open(const char *path) {
+  if (xd_telemetry_path != NULL && strcmp(xd_telemetry_path, path) == 0) {
+    return xd_telemetry_fd == -1 ? -1 : 0;
+  }
+
+  xd_telemetry_close();
+  xd_telemetry_path = xd_utils_strdup((char *)path);
+  xd_telemetry_fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                         XD_TELEMETRY_FILE_MODE);
+  if (xd_telemetry_fd == -1) {
+    fprintf(stderr, "xd-shell: %s: %s: %s\n", XD_TELEMETRY_VAR, path,
+            strerror(errno));
+    return -1;
+  }
+  return 0;
+}  // xd_telemetry_open()
+
+/**
+ * @brief Writes the passed data to the log, retrying on partial writes.
+ *
+ * @param data The data to be written.
+ * @param length The number of bytes to write.
+ */
+static void xd_telemetry_write(const char *data, size_t length) {
+  while (length > 0) {
+    ssize_t written = write(xd_telemetry_fd, data, length);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+}  // xd_telemetry_write()
+
+/**
+ * @brief Appends a `"key":value` member to the passed record.
+ *
+ * @param record The record being built.
+ * @param key The key of the member.
+ * @param value The value of the member.
+ */
+static void xd_telemetry_append_number(xd_string_t *record, const char *key,
+                                       uint64_t value) {
+  xd_string_append_fmt(record, "\"%s\":%" PRIu64 ",", key, value);
+}  // xd_telemetry_append_number()
+
+/**
+ * @brief Appends the passed string to the passed record, escaped to be
+ * used inside a JSON string.
+ *
+ * @param record The record being built.
+ * @param str The string to be appended.
+ */
+static void xd_telemetry_append_escaped(xd_string_t *record, const char *str) {
+  for (const char *ptr = str; *ptr != '\0'; ptr++) {
+    unsigned char chr = (unsigned char)*ptr;
+    if (chr == '"' || chr == '\\') {
+      xd_string_append_chr(record, '\\');
+      xd_string_append_chr(record, (char)chr);
+    }
+    else if (chr < ' ') {
+      xd_string_append_fmt(record, "\\u%04x", chr);
+    }
+    else {
+      xd_string_append_chr(record, (char)chr);
+    }
+  }
+}  // xd_telemetry_append_escaped()
+
+// ========================
+// Public Functions
+// ========================
+
+void xd_telemetry_destroy() {
+  xd_telemetry_close();
+  xd_string_destroy(xd_telemetry_record_str);
+  xd_telemetry_record_str = NULL;
+}  // xd_telemetry_destroy()
+
+void xd_telemetry_record(const xd_job_t *job, int exit_code) {
+  if (job == NULL) {
+    return;
+  }
+  if (xd_telemetry_owner != getpid()) {
+    // the records were buffered by the parent shell
+    xd_telemetry_length = 0;
+    xd_telemetry_owner = getpid();
+  }
+
+  const char *path = xd_vars_get(XD_TELEMETRY_VAR);
+  if (path == NULL || *path == '\0') {
+    xd_telemetry_close();
+    return;
+  }
+  if (xd_telemetry_open(path) == -1) {
+    return;
+  }
+
+  if (xd_telemetry_record_str == NULL) {
+    xd_telemetry_record_str = xd_string_create();
+  }
+  xd_string_t *record = xd_telemetry_record_str;
+  xd_string_clear(record);
+
+  xd_string_append_chr(record, '{');
+  xd_telemetry_append_number(record, "start", job->start_time);
+  xd_telemetry_append_number(record, "end", job->end_time);
+  xd_telemetry_append_number(record, "status", (uint64_t)exit_code);
+  xd_telemetry_append_number(record, "expand", job->expansion_time);
+  xd_telemetry_append_number(record, "spawn", job->spawn_time);
+  xd_telemetry_append_number(record, "wait", job->wait_time);
+
+  xd_string_append_str(record, "\"pids\":[");
+  for (int i = 0; i < job->command_count; i++) {
+    xd_string_append_fmt(record, "%s%d", i > 0 ? "," : "",
+                         (int)job->commands[i]->pid);
+  }
+  xd_string_append_str(record, "],\"command\":\"");
+  for (int i = 0; i < job->command_count; i++) {
+    if (i > 0) {
+      xd_string_append_str(record, " | ");
+    }
+    if (job->commands[i]->str != NULL) {
+      xd_telemetry_append_escaped(record, job->commands[i]->str);
+    }
+  }
+  if (job->is_background) {
+    xd_string_append_str(record, " &");
+  }
+  xd_string_append_str(record, "\"}\n");
+
+  size_t length = (size_t)record->length;
+  if (xd_telemetry_length + length > XD_TELEMETRY_BUFFER_SIZE) {
+    xd_telemetry_flush();
+  }
+  if (length > XD_TELEMETRY_BUFFER_SIZE) {
+    xd_telemetry_write(record->str, length);
+    return;
+  }
+  memcpy(xd_telemetry_buffer + xd_telemetry_length, record->str, length);
+  xd_telemetry_length += length;
+}  // xd_telemetry_record()
+
+void xd_telemetry_flush() {
+  if (xd_telemetry_owner != getpid()) {
+    xd_telemetry_length = 0;
+    return;
+  }
+  if (xd_telemetry_fd != -1 && xd_telemetry_length > 0) {
+    xd_telemetry_write(xd_telemetry_buffer, xd_telemetry_length);
+  }
+  xd_telemetry_length = 0;
+}  // xd_telemetry_flush()
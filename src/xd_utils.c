@@ -20,6 +20,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/random.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
 
 // ========================
 // Macros
@@ -31,14 +36,15 @@
 #define XD_UTILS_STRTOL_BASE (10)
 
 /**
- * @brief Initial value for djb2 string hash.
+ * @brief Rotates the passed 64-bit value left by `bits` bits.
  */
-#define XD_UTILS_DJB2_INITIAL (5381)
+#define XD_UTILS_ROTL64(value, bits) \
+  (((value) << (bits)) | ((value) >> (64 - (bits))))
 
 /**
- * @brief Multiplier used in djb2 string hash.
+ * @brief Number of nanoseconds in one second.
  */
-#define XD_UTILS_DJB2_MULTIPLIER (5)
+#define XD_UTILS_NANOSECONDS_PER_SECOND (1000000000ULL)
 
 /**
  * @brief Number of bytes to read from a file when checking for binary content.
@@ -49,14 +55,64 @@
 // Function Declarations
 // ========================
 
+static void xd_utils_hash_seed();
+static void xd_utils_sipround(uint64_t *v0, uint64_t *v1, uint64_t *v2,
+                              uint64_t *v3);
+
 // ========================
 // Variables
 // ========================
 
+/**
+ * @brief Random 128-bit key of the string hash, chosen once per process so
+ * that colliding keys can't be crafted in advance.
+ */
+static uint64_t xd_utils_hash_key[2];
+
+/**
+ * @brief Whether `xd_utils_hash_key` has been chosen.
+ */
+static int xd_utils_hash_is_seeded = 0;
+
 // ========================
 // Function Definitions
 // ========================
 
+/**
+ * @brief Chooses the key of the string hash from the kernel's random source,
+ * falling back to mixing the time and PID if it is unavailable.
+ */
+static void xd_utils_hash_seed() {
+  if (getrandom(xd_utils_hash_key, sizeof(xd_utils_hash_key), GRND_NONBLOCK) !=
+      (ssize_t)sizeof(xd_utils_hash_key)) {
+    uint64_t now = xd_utils_now();
+    xd_utils_hash_key[0] = now ^ ((uint64_t)getpid() << 32);
+    xd_utils_hash_key[1] = XD_UTILS_ROTL64(now, 29) ^ (uint64_t)getppid();
+  }
+  xd_utils_hash_is_seeded = 1;
+}  // xd_utils_hash_seed()
+
+/**
+ * @brief Performs one SipHash round on the passed state.
+ */
+static void xd_utils_sipround(uint64_t *v0, uint64_t *v1, uint64_t *v2,
+                              uint64_t *v3) {
+  *v0 += *v1;
+  *v1 = XD_UTILS_ROTL64(*v1, 13);
+  *v1 ^= *v0;
+  *v0 = XD_UTILS_ROTL64(*v0, 32);
+  *v2 += *v3;
+  *v3 = XD_UTILS_ROTL64(*v3, 16);
+  *v3 ^= *v2;
+  *v0 += *v3;
+  *v3 = XD_UTILS_ROTL64(*v3, 21);
+  *v3 ^= *v0;
+  *v2 += *v1;
+  *v1 = XD_UTILS_ROTL64(*v1, 17);
+  *v1 ^= *v2;
+  *v2 = XD_UTILS_ROTL64(*v2, 32);
+}  // xd_utils_sipround()
+
 // ========================
 // Public Functions
 // ========================
@@ -128,15 +184,54 @@ unsigned int xd_utils_str_hash_func(void *data) {
   if (data == NULL) {
     return 0;
   }
-  char *str = data;
-  unsigned int hash = XD_UTILS_DJB2_INITIAL;
-  int chr;
-  while ((chr = (unsigned char)*str++)) {
-    hash = ((hash << XD_UTILS_DJB2_MULTIPLIER) + hash) + chr;
-  }
-  return hash;
+  return xd_utils_hash(data, strlen(data));
 }  // xd_utils_str_hash_func()
 
+void xd_utils_hash_set_key(uint64_t key0, uint64_t key1) {
+  xd_utils_hash_key[0] = key0;
+  xd_utils_hash_key[1] = key1;
+  xd_utils_hash_is_seeded = 1;
+}  // xd_utils_hash_set_key()
+
+unsigned int xd_utils_hash(const void *data, size_t length) {
+  if (!xd_utils_hash_is_seeded) {
+    xd_utils_hash_seed();
+  }
+
+  // SipHash-1-3: one compression round per 8-byte word, three finalization
+  // rounds (words are loaded in host byte order)
+  uint64_t v0 = xd_utils_hash_key[0] ^ 0x736f6d6570736575ULL;
+  uint64_t v1 = xd_utils_hash_key[1] ^ 0x646f72616e646f6dULL;
+  uint64_t v2 = xd_utils_hash_key[0] ^ 0x6c7967656e657261ULL;
+  uint64_t v3 = xd_utils_hash_key[1] ^ 0x7465646279746573ULL;
+
+  const unsigned char *bytes = data;
+  const unsigned char *end = bytes + (length & ~(size_t)7);
+  for (; bytes != end; bytes += 8) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    v3 ^= word;
+    xd_utils_sipround(&v0, &v1, &v2, &v3);
+    v0 ^= word;
+  }
+
+  uint64_t last = (uint64_t)length << 56;
+  for (size_t i = 0; i < (length & 7); i++) {
+    last |= (uint64_t)bytes[i] << (8 * i);
+  }
+  v3 ^= last;
+  xd_utils_sipround(&v0, &v1, &v2, &v3);
+  v0 ^= last;
+
+  v2 ^= 0xff;
+  for (int i = 0; i < 3; i++) {
+    xd_utils_sipround(&v0, &v1, &v2, &v3);
+  }
+
+  uint64_t hash = v0 ^ v1 ^ v2 ^ v3;
+  return (unsigned int)(hash ^ (hash >> 32));
+}  // xd_utils_hash()
+
 char *xd_utils_strdup(char *str) {
   char *copy = strdup(str);
   if (copy == NULL) {
@@ -166,3 +261,20 @@ int xd_utils_is_bin(const char *path) {
   }
   return 0;
 }  // xd_utils_is_bin()
+
+int xd_utils_pidfd_open(pid_t pid) {
+#ifdef SYS_pidfd_open
+  return (int)syscall(SYS_pidfd_open, pid, 0);
+#else
+  (void)pid;
+  errno = ENOSYS;
+  return -1;
+#endif  // SYS_pidfd_open
+}  // xd_utils_pidfd_open()
+
+uint64_t xd_utils_now() {
+  struct timespec time_spec;
+  clock_gettime(CLOCK_MONOTONIC, &time_spec);
+  return (uint64_t)time_spec.tv_sec * XD_UTILS_NANOSECONDS_PER_SECOND +
+         (uint64_t)time_spec.tv_nsec;
+}  // xd_utils_now()
@@ -22,6 +22,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include "xd_intern.h"
 #include "xd_list.h"
 #include "xd_map.h"
 #include "xd_utils.h"
@@ -30,6 +31,23 @@
 // Macros
 // ========================
 
+/**
+ * @brief Minimum number of slots in the environment index, must be a power of
+ * two.
+ */
+#define XD_VARS_ENV_INDEX_MIN_CAPACITY (64)
+
+/**
+ * @brief Marks an empty slot of the environment index.
+ */
+#define XD_VARS_ENV_SLOT_EMPTY (-1)
+
+/**
+ * @brief Marks a slot of the environment index whose entry was moved into
+ * `xd_vars` (or removed), so probing continues past it.
+ */
+#define XD_VARS_ENV_SLOT_TAKEN (-2)
+
 // ========================
 // Typedefs
 // ========================
@@ -38,9 +56,10 @@
  * @brief Represents a shell variable.
  */
 typedef struct xd_var_t {
-  char *name;       // Variable name
-  char *value;      // Variable value
-  int is_exported;  // Whether exported (an environment variable) or not
+  const char *name;  // Variable name (an interned symbol)
+  char *value;       // Variable value
+  int is_exported;   // Whether exported (an environment variable) or not
+  int env_pos;       // Position in the environment the shell started with
 } xd_var_t;
 
 // ========================
@@ -51,6 +70,14 @@ static void *xd_var_copy_func(void *data);
 static void xd_var_destroy_func(void *data);
 static int xd_var_comp_func(const void *data1, const void *data2);
 
+static void xd_vars_env_index_build();
+static int xd_vars_env_find(const char *name);
+static char *xd_vars_env_take(const char *name, int *env_pos);
+static void xd_vars_env_import_all();
+static int xd_vars_find_is_exported(const char *name);
+static void xd_vars_env_modified();
+static int xd_vars_envp_comp_func(const void *data1, const void *data2);
+
 // ========================
 // Variables
 // ========================
@@ -65,6 +92,47 @@ static xd_map_t *xd_vars = NULL;
  */
 extern char **environ;
 
+/**
+ * @brief The environment the shell started with. Its variables are not copied
+ * into `xd_vars` until they are read or modified.
+ */
+static char **xd_vars_environ = NULL;
+
+/**
+ * @brief Number of entries in `xd_vars_environ`.
+ */
+static int xd_vars_environ_count = 0;
+
+/**
+ * @brief Open-addressing index from variable names to the positions of the
+ * entries of `xd_vars_environ` that haven't been moved into `xd_vars` yet,
+ * built on the first lookup.
+ */
+static int *xd_vars_env_index = NULL;
+
+/**
+ * @brief Number of slots in `xd_vars_env_index`.
+ */
+static int xd_vars_env_index_capacity = 0;
+
+/**
+ * @brief Whether the exported variables differ from `xd_vars_environ`, when
+ * they don't the original environment is passed to children as is.
+ */
+static int xd_vars_env_is_modified = 0;
+
+/**
+ * @brief The environment array built by `xd_vars_create_envp()`, kept until
+ * an exported variable changes (or `NULL`).
+ */
+static char **xd_vars_envp = NULL;
+
+// ========================
+// Public Variables
+// ========================
+
+xd_vars_access_func_t xd_vars_access_hook = NULL;
+
 // ========================
 // Function Definitions
 // ========================
@@ -93,10 +161,11 @@ static void *xd_var_copy_func(void *data) {
             strerror(errno));
     exit(EXIT_FAILURE);
   }
-  copy->name = strdup(var->name);
+  copy->name = var->name;
   copy->value = strdup(var->value);
   copy->is_exported = var->is_exported;
-  if (copy->name == NULL || copy->value == NULL) {
+  copy->env_pos = var->env_pos;
+  if (copy->value == NULL) {
     fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
             strerror(errno));
     exit(EXIT_FAILURE);
@@ -116,7 +185,6 @@ static void xd_var_destroy_func(void *data) {
     return;
   }
   xd_var_t *var = data;
-  free(var->name);
   free(var->value);
   free(var);
 }  // xd_var_destroy_func()
@@ -151,194 +219,429 @@ static int xd_var_comp_func(const void *data1, const void *data2) {
   return xd_utils_str_comp_func(var1->value, var2->value);
 }  // xd_var_comp_func()
 
-// ========================
-// Public Functions
-// ========================
+/**
+ * @brief Indexes the valid entries of `xd_vars_environ` by name, pointing into
+ * the environment without copying.
+ *
+ * Entries with invalid names and duplicates are left out of the index, which
+ * also marks the environment as modified so they aren't passed to children.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static void xd_vars_env_index_build() {
+  int count = 0;
+  while (xd_vars_environ != NULL && xd_vars_environ[count] != NULL) {
+    count++;
+  }
+  xd_vars_environ_count = count;
 
-void xd_vars_init() {
-  xd_vars = xd_map_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                          xd_utils_str_comp_func, xd_var_copy_func,
-                          xd_var_destroy_func, xd_var_comp_func,
-                          xd_utils_str_hash_func);
-
-  // load environment variables
-  if (environ != NULL) {
-    for (char **env = environ; *env != NULL; env++) {
-      char *entry = *env;
-      char *equal = strchr(entry, '=');
-      if (equal == NULL || equal == entry) {
-        continue;  // skip invalid entries
-      }
+  int capacity = XD_VARS_ENV_INDEX_MIN_CAPACITY;
+  while (capacity < 2 * count) {
+    capacity *= 2;
+  }
+  xd_vars_env_index = (int *)malloc(capacity * sizeof(int));
+  if (xd_vars_env_index == NULL) {
+    fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
+            strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+  for (int i = 0; i < capacity; i++) {
+    xd_vars_env_index[i] = XD_VARS_ENV_SLOT_EMPTY;
+  }
+  xd_vars_env_index_capacity = capacity;
+
+  for (int pos = 0; pos < count; pos++) {
+    char *entry = xd_vars_environ[pos];
+    char *equal = strchr(entry, '=');
+    int is_valid = (equal != NULL && equal != entry);
+    for (char *chr = entry; is_valid && chr < equal; chr++) {
+      is_valid = (*chr == '_' || isalnum((unsigned char)*chr));
+    }
+    if (!is_valid || isdigit((unsigned char)*entry)) {
+      xd_vars_env_is_modified = 1;
+      continue;  // skip invalid entries
+    }
 
-      size_t name_len = (size_t)(equal - entry);
-      char *name = (char *)malloc(sizeof(char) * (name_len + 1));
-      if (name == NULL) {
-        fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-                strerror(errno));
-        exit(EXIT_FAILURE);
-      }
-      memcpy(name, entry, name_len);
-      name[name_len] = '\0';
+    size_t name_len = (size_t)(equal - entry);
+    int mask = capacity - 1;
+    int idx = (int)(xd_utils_hash(entry, name_len) & (unsigned int)mask);
+    while (xd_vars_env_index[idx] != XD_VARS_ENV_SLOT_EMPTY &&
+           strncmp(xd_vars_environ[xd_vars_env_index[idx]], entry,
+                   name_len + 1) != 0) {
+      idx = (idx + 1) & mask;
+    }
+    if (xd_vars_env_index[idx] != XD_VARS_ENV_SLOT_EMPTY) {
+      xd_vars_env_is_modified = 1;  // later duplicates win
+    }
+    xd_vars_env_index[idx] = pos;
+  }
+}  // xd_vars_env_index_build()
 
-      if (!xd_vars_is_valid_name(name)) {
-        free(name);
-        continue;
-      }
+/**
+ * @brief Finds the environment entry of the variable with the passed name.
+ *
+ * @param name The name of the variable.
+ *
+ * @return Index of the slot of the entry in `xd_vars_env_index`, or `-1` if
+ * the environment doesn't hold the variable (anymore).
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static int xd_vars_env_find(const char *name) {
+  if (name == NULL) {
+    return -1;
+  }
+  if (xd_vars_env_index == NULL) {
+    xd_vars_env_index_build();
+  }
 
-      char *value = strdup(equal + 1);
-      if (value == NULL) {
-        fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-                strerror(errno));
-        exit(EXIT_FAILURE);
-      }
+  size_t name_len = strlen(name);
+  int mask = xd_vars_env_index_capacity - 1;
+  int idx = (int)(xd_utils_hash(name, name_len) & (unsigned int)mask);
+  while (xd_vars_env_index[idx] != XD_VARS_ENV_SLOT_EMPTY) {
+    int pos = xd_vars_env_index[idx];
+    if (pos != XD_VARS_ENV_SLOT_TAKEN &&
+        strncmp(xd_vars_environ[pos], name, name_len) == 0 &&
+        xd_vars_environ[pos][name_len] == '=') {
+      return idx;
+    }
+    idx = (idx + 1) & mask;
+  }
+  return -1;
+}  // xd_vars_env_find()
+
+/**
+ * @brief Removes the variable with the passed name from the environment index.
+ *
+ * @param name The name of the variable.
+ * @param env_pos If not `NULL` and the variable is found, receives the
+ * position of its entry in `xd_vars_environ`.
+ *
+ * @return Pointer to the value of the variable inside the environment, or
+ * `NULL` if the environment doesn't hold the variable (anymore).
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static char *xd_vars_env_take(const char *name, int *env_pos) {
+  int idx = xd_vars_env_find(name);
+  if (idx == -1) {
+    return NULL;
+  }
+  int pos = xd_vars_env_index[idx];
+  xd_vars_env_index[idx] = XD_VARS_ENV_SLOT_TAKEN;
+  if (env_pos != NULL) {
+    *env_pos = pos;
+  }
+  return xd_vars_environ[pos] + strlen(name) + 1;
+}  // xd_vars_env_take()
+
+/**
+ * @brief Moves all the variables left in the environment index into
+ * `xd_vars`, used before walking over all variables.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static void xd_vars_env_import_all() {
+  if (xd_vars_env_index == NULL) {
+    xd_vars_env_index_build();
+  }
 
-      xd_vars_put(name, value, 1);
+  for (int i = 0; i < xd_vars_env_index_capacity; i++) {
+    int pos = xd_vars_env_index[i];
+    if (pos < 0) {
+      continue;
+    }
+    char *entry = xd_vars_environ[pos];
+    char *equal = strchr(entry, '=');
+    char *name = xd_utils_strdup(entry);
+    name[equal - entry] = '\0';
+
+    const char *symbol = xd_intern(name);
+    xd_var_t var = {symbol, equal + 1, 1, pos};
+    xd_map_put(xd_vars, (void *)symbol, &var);
+    xd_vars_env_index[i] = XD_VARS_ENV_SLOT_TAKEN;
+    free(name);
+  }
+}  // xd_vars_env_import_all()
 
-      // free temporaries
-      free(name);
-      free(value);
+/**
+ * @brief Checks whether the variable with the passed name is exported, without
+ * calling `xd_vars_access_hook`.
+ *
+ * @param name The name of the variable.
+ *
+ * @return `1` if the variable is found and is exported, `0` otherwise.
+ */
+static int xd_vars_find_is_exported(const char *name) {
+  const char *symbol = xd_intern_lookup(name);
+  if (symbol != NULL) {
+    xd_var_t *var = xd_map_get(xd_vars, (void *)symbol);
+    if (var != NULL) {
+      return var->is_exported;
     }
   }
+  return xd_vars_env_find(name) != -1;
+}  // xd_vars_find_is_exported()
+
+/**
+ * @brief Marks the exported variables as differing from `xd_vars_environ`,
+ * dropping the environment array built by `xd_vars_create_envp()`.
+ */
+static void xd_vars_env_modified() {
+  xd_vars_env_is_modified = 1;
+  free((void *)xd_vars_envp);
+  xd_vars_envp = NULL;
+}  // xd_vars_env_modified()
+
+/**
+ * @brief Compares two `name=value` environment entries, used to sort the
+ * variables that were not in `xd_vars_environ` by name.
+ */
+static int xd_vars_envp_comp_func(const void *data1, const void *data2) {
+  return strcmp(*(char *const *)data1, *(char *const *)data2);
+}  // xd_vars_envp_comp_func()
+
+// ========================
+// Public Functions
+// ========================
+
+void xd_vars_init() {
+  xd_vars = xd_map_create(xd_intern_copy_func, xd_intern_destroy_func,
+                          xd_intern_comp_func, xd_var_copy_func,
+                          xd_var_destroy_func, xd_var_comp_func,
+                          xd_intern_hash_func);
+
+  // the environment is indexed and copied lazily, see `xd_vars_env_find()`
+  xd_vars_environ = environ;
+  xd_vars_env_is_modified = (environ == NULL);
 }  // xd_vars_init()
 
 void xd_vars_destroy() {
   xd_map_destroy(xd_vars);
+  free((void *)xd_vars_env_index);
+  free((void *)xd_vars_envp);
+  xd_vars = NULL;
+  xd_vars_env_index = NULL;
+  xd_vars_env_index_capacity = 0;
+  xd_vars_environ_count = 0;
+  xd_vars_envp = NULL;
 }  // xd_vars_destroy()
 
 char *xd_vars_get(char *name) {
-  xd_var_t *var = xd_map_get(xd_vars, name);
-  return var == NULL ? NULL : var->value;
+  if (xd_vars_access_hook != NULL) {
+    xd_vars_access_hook(name, 0);
+  }
+
+  // a name that was never interned isn't in `xd_vars`
+  const char *symbol = xd_intern_lookup(name);
+  if (symbol != NULL) {
+    xd_var_t *var = xd_map_get(xd_vars, (void *)symbol);
+    if (var != NULL) {
+      return var->value;
+    }
+  }
+
+  // first read of an environment variable, copy it in unmodified
+  int env_pos;
+  char *value = xd_vars_env_take(name, &env_pos);
+  if (value == NULL) {
+    return NULL;
+  }
+  symbol = xd_intern(name);
+  xd_var_t var = {symbol, value, 1, env_pos};
+  xd_map_put(xd_vars, (void *)symbol, &var);
+  return ((xd_var_t *)xd_map_get(xd_vars, (void *)symbol))->value;
 }  // xd_vars_get()
 
 void xd_vars_put(char *name, char *value, int is_exported) {
-  xd_var_t new_var = {name, value, is_exported};
-  xd_map_put(xd_vars, name, &new_var);
+  if (xd_vars_access_hook != NULL) {
+    xd_vars_access_hook(name, 1);
+  }
+
+  if (is_exported || xd_vars_find_is_exported(name)) {
+    xd_vars_env_modified();
+  }
+
+  // keep the position of a variable the shell started with
+  int env_pos = -1;
+  const char *symbol = xd_intern(name);
+  if (xd_vars_env_take(name, &env_pos) == NULL) {
+    xd_var_t *var = xd_map_get(xd_vars, (void *)symbol);
+    env_pos = (var != NULL) ? var->env_pos : -1;
+  }
+  xd_var_t new_var = {symbol, value, is_exported, env_pos};
+  xd_map_put(xd_vars, (void *)symbol, &new_var);
 }  // xd_vars_put()
 
 int xd_vars_remove(char *name) {
-  return xd_map_remove(xd_vars, name);
+  if (xd_vars_access_hook != NULL) {
+    xd_vars_access_hook(name, 1);
+  }
+
+  if (xd_vars_find_is_exported(name)) {
+    xd_vars_env_modified();
+  }
+  int ret = (xd_vars_env_take(name, NULL) == NULL) ? -1 : 0;
+
+  const char *symbol = xd_intern_lookup(name);
+  if (symbol != NULL && xd_map_remove(xd_vars, (void *)symbol) == 0) {
+    ret = 0;
+  }
+  return ret;
 }  // xd_vars_remove()
 
 int xd_vars_is_exported(char *name) {
-  xd_var_t *var = xd_map_get(xd_vars, name);
-  if (var != NULL && var->is_exported) {
-    return 1;
+  if (xd_vars_access_hook != NULL) {
+    xd_vars_access_hook(name, 0);
   }
-  return 0;
+  return xd_vars_find_is_exported(name);
 }  // xd_vars_is_exported()
 
 void xd_vars_print_all() {
   if (xd_vars == NULL) {
     return;
   }
-  for (int i = 0; i < xd_vars->bucket_count; i++) {
-    xd_list_t *bucket = xd_vars->buckets[i];
-    for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
-      xd_bucket_entry_t *entry = node->data;
-      char *name = entry->key;
-      xd_var_t *var = entry->value;
-      printf("set %s='%s'\n", name, var->value);
-    }
+  // the buckets are in hash order, print the names sorted
+  xd_vec_t *names = xd_vars_names_list();
+  xd_vec_sort(names);
+  for (int i = 0; i < names->length; i++) {
+    char *name = names->data[i];
+    xd_var_t *var = xd_map_get(xd_vars, (void *)xd_intern_lookup(name));
+    printf("set %s='%s'\n", name, var->value);
   }
+  xd_vec_destroy(names);
 }  // xd_vars_print_all()
 
 void xd_vars_print_all_exported() {
   if (xd_vars == NULL) {
     return;
   }
-  for (int i = 0; i < xd_vars->bucket_count; i++) {
-    xd_list_t *bucket = xd_vars->buckets[i];
-    for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
-      xd_bucket_entry_t *entry = node->data;
-      char *name = entry->key;
-      xd_var_t *var = entry->value;
-      if (var->is_exported) {
-        printf("export %s='%s'\n", name, var->value);
-      }
+  xd_vec_t *names = xd_vars_names_list();
+  xd_vec_sort(names);
+  for (int i = 0; i < names->length; i++) {
+    char *name = names->data[i];
+    xd_var_t *var = xd_map_get(xd_vars, (void *)xd_intern_lookup(name));
+    if (var->is_exported) {
+      printf("export %s='%s'\n", name, var->value);
     }
   }
+  xd_vec_destroy(names);
 }  // xd_vars_print_all_exported()
 
 char **xd_vars_create_envp() {
-  int exported_count = 0;
-
-  if (xd_vars != NULL) {
-    for (int i = 0; i < xd_vars->bucket_count; i++) {
-      xd_list_t *bucket = xd_vars->buckets[i];
-      for (xd_list_node_t *node = bucket->head; node != NULL;
-           node = node->next) {
-        xd_bucket_entry_t *entry = node->data;
-        xd_var_t *var = entry->value;
-        if (var->is_exported) {
-          exported_count++;
-        }
+  // building the index finds invalid and duplicate entries
+  if (xd_vars_env_index == NULL) {
+    xd_vars_env_index_build();
+  }
+  if (!xd_vars_env_is_modified) {
+    return xd_vars_environ;
+  }
+  if (xd_vars_envp != NULL) {
+    return xd_vars_envp;
+  }
+
+  // size the array and the `name=value` strings of the variables in `xd_vars`
+  int env_count = 0;
+  size_t strings_size = 0;
+  for (int i = 0; i < xd_vars_env_index_capacity; i++) {
+    if (xd_vars_env_index[i] >= 0) {
+      env_count++;
+    }
+  }
+  for (int i = 0; xd_vars != NULL && i < xd_vars->bucket_count; i++) {
+    xd_list_t *bucket = xd_vars->buckets[i];
+    for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
+      xd_bucket_entry_t *entry = node->data;
+      xd_var_t *var = entry->value;
+      if (var->is_exported) {
+        env_count++;
+        strings_size += strlen(var->name) + strlen(var->value) + 2;
       }
     }
   }
 
-  char **env = (char **)malloc(sizeof(char *) * (exported_count + 1));
-  if (env == NULL) {
+  // one block holds the array followed by the strings it points to, entries
+  // still in the environment are pointed to directly
+  size_t array_size = sizeof(char *) * (env_count + 1);
+  char **env = (char **)malloc(array_size + strings_size);
+  char **slots = (char **)calloc(xd_vars_environ_count + 1, sizeof(char *));
+  if (env == NULL || slots == NULL) {
     fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
             strerror(errno));
     exit(EXIT_FAILURE);
   }
-
-  int idx = 0;
-  if (xd_vars != NULL) {
-    for (int i = 0; i < xd_vars->bucket_count; i++) {
-      xd_list_t *bucket = xd_vars->buckets[i];
-      for (xd_list_node_t *node = bucket->head; node != NULL;
-           node = node->next) {
-        xd_bucket_entry_t *entry = node->data;
-        xd_var_t *var = entry->value;
-        if (var->is_exported) {
-          size_t name_len = strlen(var->name);
-          size_t value_len = strlen(var->value);
-          char *pair =
-              (char *)malloc(sizeof(char) * (name_len + value_len + 2));
-          if (pair == NULL) {
-            fprintf(stderr, "xd-shell: failed to allocate memory: %s\n",
-                    strerror(errno));
-            exit(EXIT_FAILURE);
-          }
-          memcpy(pair, var->name, name_len);
-          pair[name_len] = '=';
-          memcpy(pair + name_len + 1, var->value, value_len);
-          pair[name_len + value_len + 1] = '\0';
-          env[idx++] = pair;
+  char *strings = (char *)env + array_size;
+
+  // the variables the shell started with keep their original order, the
+  // others follow sorted by name (the buckets are in hash order)
+  for (int i = 0; i < xd_vars_env_index_capacity; i++) {
+    int pos = xd_vars_env_index[i];
+    if (pos >= 0) {
+      slots[pos] = xd_vars_environ[pos];
+    }
+  }
+  int new_count = 0;
+  char **new_entries = env + env_count;
+  for (int i = 0; xd_vars != NULL && i < xd_vars->bucket_count; i++) {
+    xd_list_t *bucket = xd_vars->buckets[i];
+    for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
+      xd_bucket_entry_t *entry = node->data;
+      xd_var_t *var = entry->value;
+      if (var->is_exported) {
+        size_t name_len = strlen(var->name);
+        size_t value_len = strlen(var->value);
+        memcpy(strings, var->name, name_len);
+        strings[name_len] = '=';
+        memcpy(strings + name_len + 1, var->value, value_len + 1);
+        if (var->env_pos >= 0) {
+          slots[var->env_pos] = strings;
+        }
+        else {
+          new_count++;
+          *(new_entries - new_count) = strings;
         }
+        strings += name_len + value_len + 2;
       }
     }
   }
-  env[idx] = NULL;
+
+  int idx = 0;
+  for (int pos = 0; pos < xd_vars_environ_count; pos++) {
+    if (slots[pos] != NULL) {
+      env[idx++] = slots[pos];
+    }
+  }
+  // the new entries were filled backwards right after them
+  qsort((void *)(env + idx), new_count, sizeof(char *),
+        xd_vars_envp_comp_func);
+  env[idx + new_count] = NULL;
+  free((void *)slots);
+
+  xd_vars_envp = env;
   return env;
 }  // xd_vars_create_envp()
 
 void xd_vars_destroy_envp(char **envp) {
-  if (envp == NULL) {
-    return;
-  }
-  for (int i = 0; envp[i] != NULL; i++) {
-    free(envp[i]);
-  }
-  free((void *)envp);
+  // the array is kept in `xd_vars_envp` until an exported variable changes
+  (void)envp;
 }  // xd_vars_destroy_envp()
 
-xd_list_t *xd_vars_names_list() {
+xd_vec_t *xd_vars_names_list() {
   if (xd_vars == NULL) {
     return NULL;
   }
+  xd_vars_env_import_all();
 
-  xd_list_t *name_list =
-      xd_list_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
-                     xd_utils_str_comp_func);
+  xd_vec_t *name_list =
+      xd_vec_create(xd_utils_str_copy_func, xd_utils_str_destroy_func,
+                    xd_utils_str_comp_func);
 
   for (int i = 0; i < xd_vars->bucket_count; i++) {
     xd_list_t *bucket = xd_vars->buckets[i];
     for (xd_list_node_t *node = bucket->head; node != NULL; node = node->next) {
       xd_bucket_entry_t *entry = node->data;
       char *name = entry->key;
-      xd_list_add_last(name_list, name);
+      xd_vec_push(name_list, name);
     }
   }
   return name_list;
@@ -0,0 +1,212 @@
+/*
+ * ==============================================================================
+ * File: xd_vec.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_vec.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "xd_alloc.h"
+#include "xd_generic_funcs.h"
+
+// ========================
+// Function Declarations
+// ========================
+
+static void xd_vec_alloc_data(xd_vec_t *vec, int capacity);
+static int xd_vec_sort_func(const void *ptr1, const void *ptr2);
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief Comparison function of the array being sorted, `qsort()` doesn't
+ * pass a context to its comparator.
+ */
+static xd_gens_comp_func_t xd_vec_sort_comp_func = NULL;
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Resizes the buffer of the passed array to hold the passed number of
+ * elements plus the null-terminator.
+ *
+ * @param vec A pointer to the `xd_vec_t` whose buffer is resized.
+ * @param capacity The new capacity of the array.
+ *
+ * @warning This function calls `exit(EXIT_FAILURE)` on allocation failure.
+ */
+static void xd_vec_alloc_data(xd_vec_t *vec, int capacity) {
+  vec->data = (void **)xd_alloc_realloc(XD_ALLOC_VEC, (void *)vec->data,
+                                        sizeof(void *) * (capacity + 1));
+  vec->capacity = capacity;
+}  // xd_vec_alloc_data()
+
+/**
+ * @brief Passed to `qsort()` to compare two elements of the array being
+ * sorted.
+ */
+static int xd_vec_sort_func(const void *ptr1, const void *ptr2) {
+  return xd_vec_sort_comp_func(*(void *const *)ptr1, *(void *const *)ptr2);
+}  // xd_vec_sort_func()
+
+// ========================
+// Public Functions
+// ========================
+
+xd_vec_t *xd_vec_create(xd_gens_copy_func_t copy_func,
+                        xd_gens_destroy_func_t destroy_func,
+                        xd_gens_comp_func_t comp_func) {
+  if (copy_func == NULL || destroy_func == NULL || comp_func == NULL) {
+    return NULL;
+  }
+  xd_vec_t *vec = (xd_vec_t *)xd_alloc_malloc(XD_ALLOC_VEC, sizeof(xd_vec_t));
+  vec->data = NULL;
+  vec->length = 0;
+  vec->copy_func = copy_func;
+  vec->destroy_func = destroy_func;
+  vec->comp_func = comp_func;
+  xd_vec_alloc_data(vec, XD_VEC_DEF_CAP);
+  vec->data[0] = NULL;
+  return vec;
+}  // xd_vec_create()
+
+void xd_vec_destroy(xd_vec_t *vec) {
+  if (vec == NULL) {
+    return;
+  }
+  xd_vec_clear(vec);
+  xd_alloc_free(XD_ALLOC_VEC, (void *)vec->data);
+  xd_alloc_free(XD_ALLOC_VEC, vec);
+}  // xd_vec_destroy()
+
+void xd_vec_clear(xd_vec_t *vec) {
+  if (vec == NULL) {
+    return;
+  }
+  for (int i = 0; i < vec->length; i++) {
+    vec->destroy_func(vec->data[i]);
+  }
+  vec->length = 0;
+  vec->data[0] = NULL;
+}  // xd_vec_clear()
+
+void xd_vec_push(xd_vec_t *vec, void *data) {
+  if (vec == NULL) {
+    return;
+  }
+  if (vec->length == vec->capacity) {
+    xd_vec_alloc_data(vec, vec->capacity * 2);
+  }
+  vec->data[vec->length++] = vec->copy_func(data);
+  vec->data[vec->length] = NULL;
+}  // xd_vec_push()
+
+int xd_vec_pop(xd_vec_t *vec) {
+  if (vec == NULL || vec->length == 0) {
+    return -1;
+  }
+  vec->length--;
+  vec->destroy_func(vec->data[vec->length]);
+  vec->data[vec->length] = NULL;
+  return 0;
+}  // xd_vec_pop()
+
+void *xd_vec_get(const xd_vec_t *vec, int index) {
+  if (vec == NULL || index < 0 || index >= vec->length) {
+    return NULL;
+  }
+  return vec->data[index];
+}  // xd_vec_get()
+
+int xd_vec_set(xd_vec_t *vec, int index, void *data) {
+  if (vec == NULL || index < 0 || index >= vec->length) {
+    return -1;
+  }
+  // copy first, the passed data may be the element being replaced
+  void *copy = vec->copy_func(data);
+  vec->destroy_func(vec->data[index]);
+  vec->data[index] = copy;
+  return 0;
+}  // xd_vec_set()
+
+void xd_vec_sort(xd_vec_t *vec) {
+  if (vec == NULL || vec->length < 2) {
+    return;
+  }
+  xd_vec_sort_comp_func = vec->comp_func;
+  qsort((void *)vec->data, vec->length, sizeof(void *), xd_vec_sort_func);
+  xd_vec_sort_comp_func = NULL;
+}  // xd_vec_sort()
+
+int xd_vec_dedupe(xd_vec_t *vec) {
+  if (vec == NULL) {
+    return -1;
+  }
+  if (vec->length < 2) {
+    return 0;
+  }
+  int kept = 1;
+  for (int i = 1; i < vec->length; i++) {
+    if (vec->comp_func(vec->data[kept - 1], vec->data[i]) == 0) {
+      vec->destroy_func(vec->data[i]);
+    }
+    else {
+      vec->data[kept++] = vec->data[i];
+    }
+  }
+  int removed = vec->length - kept;
+  vec->length = kept;
+  vec->data[kept] = NULL;
+  return removed;
+}  // xd_vec_dedupe()
+
+int xd_vec_bsearch(const xd_vec_t *vec, const void *data) {
+  if (vec == NULL) {
+    return -1;
+  }
+  int low = 0;
+  int high = vec->length - 1;
+  while (low <= high) {
+    int mid = low + ((high - low) / 2);
+    int comp = vec->comp_func(vec->data[mid], data);
+    if (comp == 0) {
+      return mid;
+    }
+    if (comp < 0) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+  return -1;
+}  // xd_vec_bsearch()
+
+void **xd_vec_release(xd_vec_t *vec) {
+  if (vec == NULL) {
+    return NULL;
+  }
+  void **data = vec->data;
+  xd_alloc_hand_off(XD_ALLOC_VEC, (void *)data);
+  vec->data = NULL;
+  vec->length = 0;
+  xd_vec_alloc_data(vec, XD_VEC_DEF_CAP);
+  vec->data[0] = NULL;
+  return data;
+}  // xd_vec_release()
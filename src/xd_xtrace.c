@@ -0,0 +1,232 @@
+/*
+ * ==============================================================================
+ * File: xd_xtrace.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include "xd_xtrace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "xd_command.h"
+#include "xd_job.h"
+#include "xd_shell.h"
+#include "xd_string.h"
+#include "xd_utils.h"
+#include "xd_vars.h"
+
+// ========================
+// Macros
+// ========================
+
+/**
+ * @brief Size of the buffer holding the trace not yet written.
+ */
+#define XD_XTRACE_BUFFER_SIZE (8192)
+
+/**
+ * @brief Characters that don't need quoting in a traced argument.
+ */
+#define XD_XTRACE_SAFE_CHARS \
+  "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_./=:,@%+-"
+
+// ========================
+// Function Declarations
+// ========================
+
+static int xd_xtrace_get_fd();
+static void xd_xtrace_write(int fd, const char *data, size_t length);
+static void xd_xtrace_append_arg(xd_string_t *line, const char *arg);
+
+// ========================
+// Variables
+// ========================
+
+/**
+ * @brief Trace not yet written.
+ */
+static char xd_xtrace_buffer[XD_XTRACE_BUFFER_SIZE];
+
+/**
+ * @brief Number of bytes used in `xd_xtrace_buffer`.
+ */
+static size_t xd_xtrace_length = 0;
+
+/**
+ * @brief PID of the process that buffered the trace, a subshell inherits the
+ * buffer of its parent but must not write it.
+ */
+static pid_t xd_xtrace_owner = 0;
+
+/**
+ * @brief File descriptor the buffered trace is written to.
+ */
+static int xd_xtrace_fd = STDERR_FILENO;
+
+/**
+ * @brief Time of the previous trace line (nanoseconds), `0` if none.
+ */
+static uint64_t xd_xtrace_prev_time = 0;
+
+/**
+ * @brief Dynamic string for building the trace of a job.
+ */
+static xd_string_t *xd_xtrace_str = NULL;
+
+// ========================
+// Function Definitions
+// ========================
+
+/**
+ * @brief Returns the file descriptor in `XDSH_XTRACEFD`, or `STDERR_FILENO` if
+ * it's unset or not an open descriptor.
+ */
+static int xd_xtrace_get_fd() {
+  const char *value = xd_vars_get(XD_XTRACE_FD_VAR);
+  long fd = 0;
+  if (value == NULL || *value == '\0' || xd_utils_strtol(value, &fd) == -1 ||
+      fd < 0 || fd > INT_MAX || fcntl((int)fd, F_GETFD) == -1) {
+    return STDERR_FILENO;
+  }
+  return (int)fd;
+}  // xd_xtrace_get_fd()
+
+/**
+ * @brief Writes the passed data to the passed file descriptor, retrying on
+ * partial writes.
+ *
+ * @param fd The file descriptor to write to.
+ * @param data The data to be written.
+ * @param length The number of bytes to write.
+ */
+static void xd_xtrace_write(int fd, const char *data, size_t length) {
+  while (length > 0) {
+    ssize_t written = write(fd, data, length);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data += written;
+    length -= (size_t)written;
+  }
+}  // xd_xtrace_write()
+
+/**
+ * @brief Appends the passed argument to the passed line, single-quoted if it's
+ * empty or contains characters special to the shell.
+ *
+ * @param line The trace line being built.
+ * @param arg The argument to be appended.
+ */
+static void xd_xtrace_append_arg(xd_string_t *line, const char *arg) {
+  if (*arg != '\0' && arg[strspn(arg, XD_XTRACE_SAFE_CHARS)] == '\0') {
+    xd_string_append_str(line, arg);
+    return;
+  }
+  xd_string_append_chr(line, '\'');
+  for (const char *ptr = arg; *ptr != '\0'; ptr++) {
+    if (*ptr == '\'') {
+      xd_string_append_str(line, "'\\''");
+    }
+    else {
+      xd_string_append_chr(line, *ptr);
+    }
+  }
+  xd_string_append_chr(line, '\'');
+}  // xd_xtrace_append_arg()
+
+// ========================
+// Public Functions
+// ========================
+
+void xd_xtrace_destroy() {
+  xd_xtrace_flush();
+  xd_string_destroy(xd_xtrace_str);
+  xd_xtrace_str = NULL;
+}  // xd_xtrace_destroy()
+
+void xd_xtrace_job(const xd_job_t *job) {
+  if (job == NULL) {
+    return;
+  }
+  if (xd_xtrace_owner != getpid()) {
+    // the trace was buffered by the parent shell
+    xd_xtrace_length = 0;
+    xd_xtrace_owner = getpid();
+  }
+
+  int fd = xd_xtrace_get_fd();
+  if (fd != xd_xtrace_fd) {
+    xd_xtrace_flush();
+    xd_xtrace_fd = fd;
+  }
+
+  if (xd_xtrace_str == NULL) {
+    xd_xtrace_str = xd_string_create();
+  }
+  xd_string_t *trace = xd_xtrace_str;
+  xd_string_clear(trace);
+
+  for (int i = 0; i < job->command_count; i++) {
+    const xd_command_t *command = job->commands[i];
+    if (xd_sh_xtrace_time) {
+      uint64_t now = xd_utils_now();
+      uint64_t elapsed =
+          xd_xtrace_prev_time == 0 ? 0 : now - xd_xtrace_prev_time;
+      xd_xtrace_prev_time = now;
+      xd_string_append_fmt(trace, "%" PRIu64 " +%" PRIu64 " ", now, elapsed);
+    }
+    xd_string_append_chr(trace, '+');
+    for (int j = 0; j < command->argc; j++) {
+      xd_string_append_chr(trace, ' ');
+      xd_xtrace_append_arg(trace, command->argv[j]);
+    }
+    xd_string_append_chr(trace, '\n');
+  }
+
+  size_t length = (size_t)trace->length;
+  if (xd_xtrace_length + length > XD_XTRACE_BUFFER_SIZE) {
+    xd_xtrace_flush();
+  }
+  if (length > XD_XTRACE_BUFFER_SIZE) {
+    xd_xtrace_write(xd_xtrace_fd, trace->str, length);
+    return;
+  }
+  memcpy(xd_xtrace_buffer + xd_xtrace_length, trace->str, length);
+  xd_xtrace_length += length;
+
+  if (xd_xtrace_fd == STDERR_FILENO || isatty(xd_xtrace_fd)) {
+    // keep the trace in order with what the commands write to the terminal
+    xd_xtrace_flush();
+  }
+}  // xd_xtrace_job()
+
+void xd_xtrace_flush() {
+  if (xd_xtrace_owner != getpid()) {
+    xd_xtrace_length = 0;
+    return;
+  }
+  if (xd_xtrace_length > 0) {
+    xd_xtrace_write(xd_xtrace_fd, xd_xtrace_buffer, xd_xtrace_length);
+  }
+  xd_xtrace_length = 0;
+}  // xd_xtrace_flush()
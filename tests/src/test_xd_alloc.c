@@ -0,0 +1,141 @@
+/*
+ * ==============================================================================
+ * File: test_xd_alloc.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xd_alloc.h"
+#include "xd_ctest.h"
+
+static int test_xd_alloc_malloc_free() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_alloc_stats_t before = *xd_alloc_get_stats(XD_ALLOC_STRING);
+
+  // Act
+  char *ptr = (char *)xd_alloc_malloc(XD_ALLOC_STRING, 100);
+  xd_alloc_stats_t allocated = *xd_alloc_get_stats(XD_ALLOC_STRING);
+  xd_alloc_free(XD_ALLOC_STRING, ptr);
+  ptr = NULL;
+  xd_alloc_stats_t freed = *xd_alloc_get_stats(XD_ALLOC_STRING);
+
+  // Assert
+  XD_TEST_ASSERT(allocated.allocations == before.allocations + 1);
+  XD_TEST_ASSERT(allocated.current_bytes >= before.current_bytes + 100);
+  XD_TEST_ASSERT(allocated.peak_bytes >= allocated.current_bytes);
+  XD_TEST_ASSERT(freed.frees == before.frees + 1);
+  XD_TEST_ASSERT(freed.current_bytes == before.current_bytes);
+  XD_TEST_ASSERT(freed.peak_bytes == allocated.peak_bytes);
+
+xd_test_cleanup:
+  xd_alloc_free(XD_ALLOC_STRING, ptr);
+  XD_TEST_END;
+}  // test_xd_alloc_malloc_free()
+
+static int test_xd_alloc_realloc() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_alloc_stats_t before = *xd_alloc_get_stats(XD_ALLOC_LIST);
+  char *ptr = (char *)xd_alloc_realloc(XD_ALLOC_LIST, NULL, 16);
+  strcpy(ptr, "xd-shell");
+
+  // Act
+  ptr = (char *)xd_alloc_realloc(XD_ALLOC_LIST, ptr, 4096);
+  xd_alloc_stats_t after = *xd_alloc_get_stats(XD_ALLOC_LIST);
+
+  // Assert
+  XD_TEST_ASSERT(strcmp(ptr, "xd-shell") == 0);
+  XD_TEST_ASSERT(after.allocations == before.allocations + 1);
+  XD_TEST_ASSERT(after.frees == before.frees);
+  XD_TEST_ASSERT(after.current_bytes >= before.current_bytes + 4096);
+
+xd_test_cleanup:
+  xd_alloc_free(XD_ALLOC_LIST, ptr);
+  XD_TEST_END;
+}  // test_xd_alloc_realloc()
+
+static int test_xd_alloc_strdup() {
+  XD_TEST_START;
+
+  // Arrange
+  const char *str = "hello world";
+
+  // Act
+  char *dup = xd_alloc_strdup(XD_ALLOC_COMMAND, str);
+
+  // Assert
+  XD_TEST_ASSERT(dup != NULL);
+  XD_TEST_ASSERT(dup != str);
+  XD_TEST_ASSERT(strcmp(dup, str) == 0);
+
+xd_test_cleanup:
+  xd_alloc_free(XD_ALLOC_COMMAND, dup);
+  XD_TEST_END;
+}  // test_xd_alloc_strdup()
+
+static int test_xd_alloc_total() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_alloc_stats_t before = *xd_alloc_get_total();
+
+  // Act
+  void *ptr1 = xd_alloc_malloc(XD_ALLOC_MAP, 64);
+  void *ptr2 = xd_alloc_malloc(XD_ALLOC_JOB, 64);
+  xd_alloc_stats_t allocated = *xd_alloc_get_total();
+  xd_alloc_free(XD_ALLOC_MAP, ptr1);
+  ptr1 = NULL;
+  xd_alloc_stats_t freed = *xd_alloc_get_total();
+
+  // Assert
+  XD_TEST_ASSERT(allocated.allocations == before.allocations + 2);
+  XD_TEST_ASSERT(allocated.current_bytes >= before.current_bytes + 128);
+  XD_TEST_ASSERT(freed.frees == before.frees + 1);
+  XD_TEST_ASSERT(freed.current_bytes < allocated.current_bytes);
+  XD_TEST_ASSERT(freed.peak_bytes == allocated.peak_bytes);
+
+xd_test_cleanup:
+  xd_alloc_free(XD_ALLOC_MAP, ptr1);
+  xd_alloc_free(XD_ALLOC_JOB, ptr2);
+  XD_TEST_END;
+}  // test_xd_alloc_total()
+
+static int test_xd_alloc_get_name() {
+  XD_TEST_START;
+
+  // Arrange - Act - Assert
+  XD_TEST_ASSERT(strcmp(xd_alloc_get_name(XD_ALLOC_STRING), "string") == 0);
+  XD_TEST_ASSERT(strcmp(xd_alloc_get_name(XD_ALLOC_READLINE), "readline") ==
+                 0);
+  XD_TEST_ASSERT(xd_alloc_get_name(XD_ALLOC_SUBSYSTEM_COUNT) == NULL);
+  XD_TEST_ASSERT(xd_alloc_get_stats(XD_ALLOC_SUBSYSTEM_COUNT) == NULL);
+
+xd_test_cleanup:
+  XD_TEST_END;
+}  // test_xd_alloc_get_name()
+
+static xd_test_case test_suite[] = {
+    XD_TEST_CASE(test_xd_alloc_malloc_free),
+    XD_TEST_CASE(test_xd_alloc_realloc),
+    XD_TEST_CASE(test_xd_alloc_strdup),
+    XD_TEST_CASE(test_xd_alloc_total),
+    XD_TEST_CASE(test_xd_alloc_get_name),
+};
+
+int main() {
+  XD_TEST_RUN_ALL(test_suite);
+}  // main()
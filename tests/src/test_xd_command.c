@@ -36,6 +36,10 @@ static int test_xd_command_create() {
   XD_TEST_ASSERT(command->append_output == 0);
   XD_TEST_ASSERT(command->append_output == 0);
   XD_TEST_ASSERT(command->pid == 0);
+  XD_TEST_ASSERT(command->pidfd == -1);
+  XD_TEST_ASSERT(command->rusage.ru_maxrss == 0);
+  XD_TEST_ASSERT(command->start_time == 0);
+  XD_TEST_ASSERT(command->end_time == 0);
 
 xd_test_cleanup:
   xd_command_destroy(command);
@@ -0,0 +1,191 @@
+/*
+ * ==============================================================================
+ * File: test_xd_intern.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xd_ctest.h"
+#include "xd_intern.h"
+#include "xd_utils.h"
+
+static int test_xd_intern_same_symbol() {
+  XD_TEST_START;
+
+  // Arrange
+  char name1[] = "PATH";
+  char name2[] = "PATH";
+
+  // Act
+  const char *symbol1 = xd_intern(name1);
+  const char *symbol2 = xd_intern(name2);
+
+  // Assert
+  XD_TEST_ASSERT(symbol1 != NULL);
+  XD_TEST_ASSERT(symbol1 == symbol2);
+  XD_TEST_ASSERT(symbol1 != name1);
+  XD_TEST_ASSERT(strcmp(symbol1, "PATH") == 0);
+  XD_TEST_ASSERT(xd_intern_count() == 1);
+
+xd_test_cleanup:
+  xd_intern_destroy();
+  XD_TEST_END;
+}  // test_xd_intern_same_symbol()
+
+static int test_xd_intern_different_symbols() {
+  XD_TEST_START;
+
+  // Arrange - Act
+  const char *symbol1 = xd_intern("HOME");
+  const char *symbol2 = xd_intern("HOMES");
+  const char *symbol3 = xd_intern("");
+
+  // Assert
+  XD_TEST_ASSERT(symbol1 != symbol2);
+  XD_TEST_ASSERT(symbol1 != symbol3);
+  XD_TEST_ASSERT(strcmp(symbol3, "") == 0);
+  XD_TEST_ASSERT(xd_intern_count() == 3);
+
+xd_test_cleanup:
+  xd_intern_destroy();
+  XD_TEST_END;
+}  // test_xd_intern_different_symbols()
+
+static int test_xd_intern_lookup() {
+  XD_TEST_START;
+
+  // Arrange
+  const char *symbol = xd_intern("HOME");
+
+  // Act
+  const char *found = xd_intern_lookup("HOME");
+  const char *missing = xd_intern_lookup("USER");
+
+  // Assert
+  XD_TEST_ASSERT(found == symbol);
+  XD_TEST_ASSERT(missing == NULL);
+  XD_TEST_ASSERT(xd_intern_count() == 1);
+  XD_TEST_ASSERT(xd_intern_lookup(NULL) == NULL);
+
+xd_test_cleanup:
+  xd_intern_destroy();
+  XD_TEST_END;
+}  // test_xd_intern_lookup()
+
+static int test_xd_intern_hash() {
+  XD_TEST_START;
+
+  // Arrange - Act
+  const char *symbol = xd_intern("HISTFILE");
+
+  // Assert
+  XD_TEST_ASSERT(xd_intern_hash(symbol) ==
+                 xd_utils_str_hash_func("HISTFILE"));
+  XD_TEST_ASSERT(xd_intern_hash_func((void *)symbol) ==
+                 xd_intern_hash(symbol));
+  XD_TEST_ASSERT(xd_intern_hash(NULL) == 0);
+
+xd_test_cleanup:
+  xd_intern_destroy();
+  XD_TEST_END;
+}  // test_xd_intern_hash()
+
+static int test_xd_intern_grow() {
+  XD_TEST_START;
+
+  // Arrange
+  const int count = 5000;
+  const char *first = xd_intern("name0");
+  char name[32];
+
+  // Act
+  for (int i = 1; i < count; i++) {
+    snprintf(name, sizeof(name), "name%d", i);
+    xd_intern(name);
+  }
+
+  // Assert - symbols survive the table growing
+  XD_TEST_ASSERT(xd_intern_count() == count);
+  XD_TEST_ASSERT(xd_intern_lookup("name0") == first);
+  for (int i = 0; i < count; i++) {
+    snprintf(name, sizeof(name), "name%d", i);
+    const char *symbol = xd_intern_lookup(name);
+    XD_TEST_ASSERT(symbol != NULL);
+    XD_TEST_ASSERT(strcmp(symbol, name) == 0);
+  }
+
+xd_test_cleanup:
+  xd_intern_destroy();
+  XD_TEST_END;
+}  // test_xd_intern_grow()
+
+static int test_xd_intern_generic_funcs() {
+  XD_TEST_START;
+
+  // Arrange
+  char name[] = "alias";
+
+  // Act
+  void *symbol1 = xd_intern_copy_func(name);
+  void *symbol2 = xd_intern_copy_func("alias");
+  void *symbol3 = xd_intern_copy_func("unalias");
+  xd_intern_destroy_func(symbol1);
+
+  // Assert
+  XD_TEST_ASSERT(symbol1 == symbol2);
+  XD_TEST_ASSERT(xd_intern_comp_func(symbol1, symbol2) == 0);
+  XD_TEST_ASSERT(xd_intern_comp_func(symbol1, symbol3) != 0);
+  XD_TEST_ASSERT(xd_intern_comp_func(symbol1, symbol3) ==
+                 -xd_intern_comp_func(symbol3, symbol1));
+  XD_TEST_ASSERT(xd_intern_copy_func(NULL) == NULL);
+  XD_TEST_ASSERT(strcmp(symbol1, "alias") == 0);
+
+xd_test_cleanup:
+  xd_intern_destroy();
+  XD_TEST_END;
+}  // test_xd_intern_generic_funcs()
+
+static int test_xd_intern_destroy() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_intern("PATH");
+
+  // Act
+  xd_intern_destroy();
+
+  // Assert
+  XD_TEST_ASSERT(xd_intern_count() == 0);
+  XD_TEST_ASSERT(xd_intern_lookup("PATH") == NULL);
+  XD_TEST_ASSERT(xd_intern("PATH") != NULL);
+
+xd_test_cleanup:
+  xd_intern_destroy();
+  XD_TEST_END;
+}  // test_xd_intern_destroy()
+
+static xd_test_case test_suite[] = {
+    XD_TEST_CASE(test_xd_intern_same_symbol),
+    XD_TEST_CASE(test_xd_intern_different_symbols),
+    XD_TEST_CASE(test_xd_intern_lookup),
+    XD_TEST_CASE(test_xd_intern_hash),
+    XD_TEST_CASE(test_xd_intern_grow),
+    XD_TEST_CASE(test_xd_intern_generic_funcs),
+    XD_TEST_CASE(test_xd_intern_destroy),
+};
+
+int main() {
+  XD_TEST_RUN_ALL(test_suite);
+}  // main()
@@ -14,6 +14,9 @@
  */
 
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "xd_command.h"
 #include "xd_ctest.h"
@@ -31,6 +34,10 @@ static int test_xd_job_create() {
   XD_TEST_ASSERT(job->command_count == 0);
   XD_TEST_ASSERT(job->is_background == 0);
   XD_TEST_ASSERT(job->pgid == 0);
+  XD_TEST_ASSERT(job->time_mode == XD_JOB_TIME_NONE);
+  XD_TEST_ASSERT(job->expansion_time == 0);
+  XD_TEST_ASSERT(job->spawn_time == 0);
+  XD_TEST_ASSERT(job->wait_time == 0);
 
 xd_test_cleanup:
   xd_job_destroy(job);
@@ -114,11 +121,89 @@ xd_test_cleanup:
   XD_TEST_END;
 }  // test_xd_job_add_command3()
 
+static int test_xd_job_print_times() {
+  XD_TEST_START;
+
+  // Arrange
+  char *buf1 = NULL;
+  size_t size1 = 0;
+  char *buf2 = NULL;
+  size_t size2 = 0;
+  FILE *stream1 = open_memstream(&buf1, &size1);
+  FILE *stream2 = open_memstream(&buf2, &size2);
+  xd_job_t *job = xd_job_create();
+  xd_command_t *command1 = xd_command_create();
+  xd_command_t *command2 = xd_command_create();
+  command1->rusage.ru_utime.tv_sec = 1;
+  command1->rusage.ru_utime.tv_usec = 500000;
+  command1->rusage.ru_stime.tv_usec = 250000;
+  command1->rusage.ru_maxrss = 100;
+  command2->rusage.ru_utime.tv_usec = 250000;
+  command2->rusage.ru_stime.tv_usec = 250000;
+  command2->rusage.ru_maxrss = 2048;
+  xd_job_add_command(job, command1);
+  xd_job_add_command(job, command2);
+  job->start_time = 1000000000ULL;
+  job->end_time = 63500000000ULL;
+
+  // Act
+  xd_job_print_times(job, "%R %2U %1S %1lR %M %P %% %X %", stream1);
+  xd_job_print_times(job, "", stream2);
+  fclose(stream1);
+  fclose(stream2);
+
+  // Assert
+  XD_TEST_ASSERT(
+      strcmp(buf1, "62.500 1.75 0.5 1m2.5s 2048 3.60 % %X %\n") == 0);
+  XD_TEST_ASSERT(size2 == 0);
+
+xd_test_cleanup:
+  xd_job_destroy(job);
+  free(buf1);
+  free(buf2);
+  XD_TEST_END;
+}  // test_xd_job_print_times()
+
+static int test_xd_job_print_usage() {
+  XD_TEST_START;
+
+  // Arrange
+  char *buf = NULL;
+  size_t size = 0;
+  FILE *stream = open_memstream(&buf, &size);
+  xd_job_t *job = xd_job_create();
+  xd_command_t *command = xd_command_create();
+  command->pid = 42;
+  command->str = strdup("sleep 1");
+  command->start_time = 1000000000ULL;
+  command->end_time = 3500000000ULL;
+  command->rusage.ru_utime.tv_sec = 1;
+  command->rusage.ru_stime.tv_usec = 250000;
+  command->rusage.ru_maxrss = 512;
+  xd_job_add_command(job, command);
+
+  // Act
+  xd_job_print_usage(job, 9000000000ULL, stream);
+  fclose(stream);
+
+  // Assert
+  XD_TEST_ASSERT(strcmp(buf,
+                        "      42      real 0m2.500s  cpu 0m1.250s  "
+                        "maxrss 512K  sleep 1\n") == 0);
+
+xd_test_cleanup:
+  xd_job_destroy(job);
+  free(buf);
+  XD_TEST_END;
+}  // test_xd_job_print_usage()
+
 static xd_test_case test_suite[] = {
     XD_TEST_CASE(test_xd_job_create),
     XD_TEST_CASE(test_xd_job_add_command1),
     XD_TEST_CASE(test_xd_job_add_command2),
     XD_TEST_CASE(test_xd_job_add_command3),
+    XD_TEST_CASE(test_xd_job_print_times),
+    XD_TEST_CASE(test_xd_job_print_usage),
 };
 
 int main() {
@@ -0,0 +1,423 @@
+/*
+ * ==============================================================================
+ * File: test_xd_jobs.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2025 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include <poll.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "xd_command.h"
+#include "xd_ctest.h"
+#include "xd_job.h"
+#include "xd_jobs.h"
+
+// ========================
+// Stubs
+// ========================
+
+int xd_sh_is_interactive = 0;
+volatile sig_atomic_t xd_sh_is_interrupted = 0;
+
+void xd_telemetry_record(const xd_job_t *job, int exit_code) {
+  (void)job;
+  (void)exit_code;
+}  // xd_telemetry_record()
+
+void xd_profile_record(const xd_job_t *job) {
+  (void)job;
+}  // xd_profile_record()
+
+char *xd_vars_get(char *name) {
+  (void)name;
+  return NULL;
+}  // xd_vars_get()
+
+// ========================
+// Helpers
+// ========================
+
+static void sigchld_handler(int signum) {
+  (void)signum;
+  xd_jobs_sigchld_notify();
+}  // sigchld_handler()
+
+/**
+ * @brief Creates a job of child processes exiting with the passed exit codes
+ * and adds it to the jobs table.
+ */
+static xd_job_t *add_job(const int *exit_codes, int count, int is_background) {
+  xd_job_t *job = xd_job_create();
+  job->is_background = is_background;
+  for (int i = 0; i < count; i++) {
+    xd_command_t *command = xd_command_create();
+    pid_t pid = fork();
+    if (pid == 0) {
+      _exit(exit_codes[i]);
+    }
+    command->pid = pid;
+    xd_job_add_command(job, command);
+    job->unreaped_count++;
+  }
+  job->pgid = job->commands[0]->pid;
+  xd_jobs_add(job);
+  return job;
+}  // add_job()
+
+/**
+ * @brief Creates a job of a single child process that runs until it's killed
+ * and adds it to the jobs table.
+ */
+static xd_job_t *add_running_job() {
+  xd_job_t *job = xd_job_create();
+  job->is_background = 1;
+  xd_command_t *command = xd_command_create();
+  pid_t pid = fork();
+  if (pid == 0) {
+    while (1) {
+      pause();
+    }
+  }
+  command->pid = pid;
+  xd_job_add_command(job, command);
+  job->unreaped_count++;
+  job->pgid = pid;
+  xd_jobs_add(job);
+  return job;
+}  // add_running_job()
+
+/**
+ * @brief Refreshes the jobs table until the stopped state of the passed job
+ * matches `is_stopped`.
+ */
+static void wait_stopped(xd_job_t *job, int is_stopped) {
+  while (xd_job_is_stopped(job) != is_stopped) {
+    struct pollfd pfd = {.fd = xd_jobs_sigchld_fd(), .events = POLLIN};
+    poll(&pfd, 1, 100);
+    xd_jobs_refresh();
+  }
+}  // wait_stopped()
+
+/**
+ * @brief Refreshes the jobs table until the job with the passed PID is removed
+ * from it.
+ */
+static void wait_removed(pid_t pid) {
+  while (xd_jobs_get_with_pid(pid) != NULL) {
+    struct pollfd pfd = {.fd = xd_jobs_sigchld_fd(), .events = POLLIN};
+    poll(&pfd, 1, 100);
+    xd_jobs_refresh();
+  }
+}  // wait_removed()
+
+/**
+ * @brief Kills the passed job started by `add_running_job()` and refreshes the
+ * jobs table until it's removed (the job is freed).
+ */
+static void finish_job(xd_job_t *job) {
+  pid_t pid = job->commands[0]->pid;
+  kill(pid, SIGKILL);
+  wait_removed(pid);
+}  // finish_job()
+
+/**
+ * @brief Kills all the jobs left in the jobs table and removes them.
+ */
+static void finish_all() {
+  xd_job_t *jobs[16];
+  int count = xd_jobs_get_all(jobs);
+  for (int i = 0; i < count; i++) {
+    finish_job(jobs[i]);
+  }
+}  // finish_all()
+
+// ========================
+// Tests
+// ========================
+
+static int test_xd_jobs_lowest_free_id() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  xd_job_t *jobs[4];
+  for (int i = 0; i < 4; i++) {
+    jobs[i] = add_running_job();
+  }
+  finish_job(jobs[2]);
+  finish_job(jobs[1]);
+
+  // Act
+  int id1 = add_running_job()->job_id;
+  int id2 = add_running_job()->job_id;
+  int id3 = add_running_job()->job_id;
+
+  // Assert
+  // the freed ids 2 and 3 are reused lowest first, then the table grows
+  XD_TEST_ASSERT(jobs[0]->job_id == 1);
+  XD_TEST_ASSERT(jobs[3]->job_id == 4);
+  XD_TEST_ASSERT(id1 == 2);
+  XD_TEST_ASSERT(id2 == 3);
+  XD_TEST_ASSERT(id3 == 5);
+  XD_TEST_ASSERT(xd_jobs_get_count() == 5);
+
+xd_test_cleanup:
+  finish_all();
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_lowest_free_id()
+
+static int test_xd_jobs_ids_start_over() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  xd_job_t *jobs[3];
+  for (int i = 0; i < 3; i++) {
+    jobs[i] = add_running_job();
+  }
+  finish_job(jobs[1]);
+  finish_job(jobs[0]);
+  finish_job(jobs[2]);
+
+  // Act
+  int count = xd_jobs_get_count();
+  int id1 = add_running_job()->job_id;
+  int id2 = add_running_job()->job_id;
+
+  // Assert
+  // the emptied table drops its highest id and its free ids
+  XD_TEST_ASSERT(count == 0);
+  XD_TEST_ASSERT(id1 == 1);
+  XD_TEST_ASSERT(id2 == 2);
+  XD_TEST_ASSERT(xd_jobs_get_with_id(3) == NULL);
+
+xd_test_cleanup:
+  finish_all();
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_ids_start_over()
+
+static int test_xd_jobs_current_previous() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  xd_job_t *job1 = add_running_job();
+  xd_job_t *job2 = add_running_job();
+  xd_jobs_refresh();
+  xd_job_t *current[4];
+  xd_job_t *previous[4];
+
+  // Act
+  // the most recently active job is current
+  current[0] = xd_jobs_get_current();
+  previous[0] = xd_jobs_get_previous();
+
+  // stopped jobs come before running ones
+  kill(job1->commands[0]->pid, SIGSTOP);
+  wait_stopped(job1, 1);
+  current[1] = xd_jobs_get_current();
+  previous[1] = xd_jobs_get_previous();
+
+  // a continued job is the most recently active running one
+  kill(job2->commands[0]->pid, SIGSTOP);
+  wait_stopped(job2, 1);
+  kill(job1->commands[0]->pid, SIGCONT);
+  wait_stopped(job1, 0);
+  current[2] = xd_jobs_get_current();
+  previous[2] = xd_jobs_get_previous();
+
+  // a finished job leaves both
+  finish_job(job2);
+  current[3] = xd_jobs_get_current();
+  previous[3] = xd_jobs_get_previous();
+
+  // Assert
+  XD_TEST_ASSERT(current[0] == job2 && previous[0] == job1);
+  XD_TEST_ASSERT(current[1] == job1 && previous[1] == job2);
+  XD_TEST_ASSERT(current[2] == job2 && previous[2] == job1);
+  XD_TEST_ASSERT(current[3] == job1 && previous[3] == NULL);
+
+xd_test_cleanup:
+  finish_all();
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_current_previous()
+
+static int test_xd_jobs_collect_pid_status() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  int exit_codes[] = {3};
+  xd_job_t *job = add_job(exit_codes, 1, 1);
+  pid_t pid = job->commands[0]->pid;
+  wait_removed(pid);
+
+  // Act
+  int wait_status = -1;
+  int ret1 = xd_jobs_collect_pid_status(pid, &wait_status);
+  int ret2 = xd_jobs_collect_pid_status(pid, &wait_status);
+
+  // Assert
+  XD_TEST_ASSERT(ret1 == 0);
+  XD_TEST_ASSERT(xd_jobs_exit_code(wait_status) == 3);
+  XD_TEST_ASSERT(ret2 == -1);
+
+xd_test_cleanup:
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_collect_pid_status()
+
+static int test_xd_jobs_collect_job_status() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  int exit_codes[] = {1, 2};
+  xd_job_t *job = add_job(exit_codes, 2, 1);
+  int job_id = job->job_id;
+  pid_t pid1 = job->commands[0]->pid;
+  pid_t pid2 = job->commands[1]->pid;
+  wait_removed(pid1);
+  wait_removed(pid2);
+
+  // Act
+  int wait_status = -1;
+  int ret1 = xd_jobs_collect_job_status(job_id, &wait_status);
+  int ret2 = xd_jobs_collect_job_status(job_id, &wait_status);
+  int ret3 = xd_jobs_collect_pid_status(pid1, &wait_status);
+
+  // Assert
+  XD_TEST_ASSERT(ret1 == 0);
+  XD_TEST_ASSERT(ret2 == -1);
+  XD_TEST_ASSERT(ret3 == -1);
+
+xd_test_cleanup:
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_collect_job_status()
+
+static int test_xd_jobs_collect_job_status_last_command() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  int exit_codes[] = {1, 2};
+  xd_job_t *job = add_job(exit_codes, 2, 1);
+  int job_id = job->job_id;
+  pid_t pid1 = job->commands[0]->pid;
+  pid_t pid2 = job->commands[1]->pid;
+  wait_removed(pid1);
+  wait_removed(pid2);
+
+  // Act
+  int pid_status = -1;
+  int job_status = -1;
+  int ret1 = xd_jobs_collect_pid_status(pid1, &pid_status);
+  int ret2 = xd_jobs_collect_job_status(job_id, &job_status);
+
+  // Assert
+  XD_TEST_ASSERT(ret1 == 0);
+  XD_TEST_ASSERT(xd_jobs_exit_code(pid_status) == 1);
+  XD_TEST_ASSERT(ret2 == 0);
+  XD_TEST_ASSERT(xd_jobs_exit_code(job_status) == 2);
+
+xd_test_cleanup:
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_collect_job_status_last_command()
+
+static int test_xd_jobs_collect_foreground() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  int exit_codes[] = {4};
+  xd_job_t *job = add_job(exit_codes, 1, 0);
+  int job_id = job->job_id;
+  pid_t pid = job->commands[0]->pid;
+  wait_removed(pid);
+
+  // Act
+  int wait_status = -1;
+  int ret1 = xd_jobs_collect_pid_status(pid, &wait_status);
+  int ret2 = xd_jobs_collect_job_status(job_id, &wait_status);
+
+  // Assert
+  XD_TEST_ASSERT(ret1 == -1);
+  XD_TEST_ASSERT(ret2 == -1);
+
+xd_test_cleanup:
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_collect_foreground()
+
+static int test_xd_jobs_collect_waited() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_jobs_init();
+  int exit_codes[] = {5};
+  xd_job_t *job = add_job(exit_codes, 1, 1);
+  int job_id = job->job_id;
+  pid_t pid = job->commands[0]->pid;
+  xd_command_t *command = NULL;
+  int idx = xd_jobs_wait_any(&job, &command, 1, -1);
+  int exit_code = xd_jobs_exit_code(job->wait_status);
+  job->is_waited = 1;  // as done by `wait` once it returns the status
+  wait_removed(pid);
+
+  // Act
+  int wait_status = -1;
+  int ret1 = xd_jobs_collect_pid_status(pid, &wait_status);
+  int ret2 = xd_jobs_collect_job_status(job_id, &wait_status);
+
+  // Assert
+  // `sleep 1 & wait $!; wait $!` fails the second time
+  XD_TEST_ASSERT(idx == 0);
+  XD_TEST_ASSERT(exit_code == 5);
+  XD_TEST_ASSERT(ret1 == -1);
+  XD_TEST_ASSERT(ret2 == -1);
+
+xd_test_cleanup:
+  xd_jobs_destroy();
+  XD_TEST_END;
+}  // test_xd_jobs_collect_waited()
+
+static xd_test_case test_suite[] = {
+    XD_TEST_CASE(test_xd_jobs_lowest_free_id),
+    XD_TEST_CASE(test_xd_jobs_ids_start_over),
+    XD_TEST_CASE(test_xd_jobs_current_previous),
+    XD_TEST_CASE(test_xd_jobs_collect_pid_status),
+    XD_TEST_CASE(test_xd_jobs_collect_job_status),
+    XD_TEST_CASE(test_xd_jobs_collect_job_status_last_command),
+    XD_TEST_CASE(test_xd_jobs_collect_foreground),
+    XD_TEST_CASE(test_xd_jobs_collect_waited),
+};
+
+int main() {
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = sigchld_handler;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGCHLD, &action, NULL);
+
+  XD_TEST_RUN_ALL(test_suite);
+}  // main()
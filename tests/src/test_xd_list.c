@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "xd_alloc.h"
 #include "xd_ctest.h"
 #include "xd_list.h"
 
@@ -1202,6 +1203,93 @@ xd_test_cleanup:
   XD_TEST_END;
 }  // test_xd_list_get_node()
 
+static int test_xd_list_pool_reuse() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_list_t *list =
+      xd_list_create(xd_string_copy, xd_string_destroy, xd_string_comp);
+  for (int i = 0; i < 16; i++) {
+    xd_list_add_last(list, "A");
+  }
+  xd_list_clear(list);
+  xd_alloc_stats_t before = *xd_alloc_get_stats(XD_ALLOC_LIST);
+
+  // Act
+  for (int i = 0; i < 16; i++) {
+    xd_list_add_first(list, "B");
+  }
+  while (xd_list_remove_last(list) == 0) {
+  }
+  xd_alloc_stats_t after = *xd_alloc_get_stats(XD_ALLOC_LIST);
+
+  // Assert
+  XD_TEST_ASSERT(after.allocations == before.allocations);
+  XD_TEST_ASSERT(after.frees == before.frees);
+  XD_TEST_ASSERT(after.current_bytes == before.current_bytes);
+  XD_TEST_ASSERT(list->length == 0);
+
+xd_test_cleanup:
+  xd_list_destroy(list);
+  XD_TEST_END;
+}  // test_xd_list_pool_reuse()
+
+static int test_xd_list_pool_clear() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_list_t *list =
+      xd_list_create(xd_string_copy, xd_string_destroy, xd_string_comp);
+  for (int i = 0; i < 8; i++) {
+    xd_list_add_last(list, "A");
+  }
+  xd_list_destroy(list);
+  list = NULL;
+  xd_alloc_stats_t before = *xd_alloc_get_stats(XD_ALLOC_LIST);
+
+  // Act
+  xd_list_pool_clear();
+  xd_alloc_stats_t cleared = *xd_alloc_get_stats(XD_ALLOC_LIST);
+  list = xd_list_create(xd_string_copy, xd_string_destroy, xd_string_comp);
+  xd_list_add_last(list, "A");
+  xd_alloc_stats_t after = *xd_alloc_get_stats(XD_ALLOC_LIST);
+
+  // Assert
+  XD_TEST_ASSERT(cleared.frees >= before.frees + 8);
+  XD_TEST_ASSERT(cleared.current_bytes < before.current_bytes);
+  XD_TEST_ASSERT(after.allocations == cleared.allocations + 2);
+
+xd_test_cleanup:
+  xd_list_destroy(list);
+  XD_TEST_END;
+}  // test_xd_list_pool_clear()
+
+static int test_xd_list_create_borrowed() {
+  XD_TEST_START;
+
+  // Arrange
+  char str1[] = "A";
+  char str2[] = "B";
+  xd_list_t *list = xd_list_create_borrowed(xd_string_comp);
+
+  // Act
+  xd_list_add_last(list, str1);
+  xd_list_add_last(list, str2);
+  int ret = xd_list_remove(list, "A");
+
+  // Assert
+  XD_TEST_ASSERT(list != NULL);
+  XD_TEST_ASSERT(ret == 0);
+  XD_TEST_ASSERT(list->length == 1);
+  XD_TEST_ASSERT(list->head->data == str2);
+  XD_TEST_ASSERT(xd_list_find(list, "B") == str2);
+  XD_TEST_ASSERT(xd_list_create_borrowed(NULL) == NULL);
+
+xd_test_cleanup:
+  xd_list_destroy(list);
+  XD_TEST_END;
+}  // test_xd_list_create_borrowed()
+
 static xd_test_case test_suite[] = {
     XD_TEST_CASE(test_xd_list_create),
     XD_TEST_CASE(test_xd_list_add_first),
@@ -1230,6 +1318,9 @@ static xd_test_case test_suite[] = {
     XD_TEST_CASE(test_xd_list_remove_node4),
     XD_TEST_CASE(test_xd_list_remove_node5),
     XD_TEST_CASE(test_xd_list_get_node),
+    XD_TEST_CASE(test_xd_list_pool_reuse),
+    XD_TEST_CASE(test_xd_list_pool_clear),
+    XD_TEST_CASE(test_xd_list_create_borrowed),
 };
 
 int main() {
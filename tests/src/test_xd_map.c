@@ -15,6 +15,7 @@
 
 #include <ctype.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -58,6 +59,13 @@ static unsigned int xd_string_hash(void *data) {
   return (int)str[0];
 }  // xd_string_hash()
 
+static int xd_counting_hash_calls = 0;
+
+static unsigned int xd_counting_hash(void *data) {
+  xd_counting_hash_calls++;
+  return xd_string_hash(data);
+}  // xd_counting_hash()
+
 // ========================
 // Test Functions
 // ========================
@@ -564,6 +572,45 @@ xd_test_cleanup:
   XD_TEST_END;
 }  // test_xd_map_to_array()
 
+static int test_xd_map_rehash_cached_hash() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_map_t *map = xd_map_create(
+      xd_string_copy, xd_string_destroy, xd_string_comp, xd_string_copy,
+      xd_string_destroy, xd_string_comp, xd_counting_hash);
+  char key[16];
+  int entry_count = 100;
+  xd_counting_hash_calls = 0;
+
+  // Act - enough entries to grow the buckets several times
+  for (int i = 0; i < entry_count; i++) {
+    snprintf(key, sizeof(key), "%d", i);
+    xd_map_put(map, key, key);
+  }
+
+  // Assert - every key is hashed exactly once, on insertion
+  XD_TEST_ASSERT(map->bucket_count > 17);
+  XD_TEST_ASSERT(xd_counting_hash_calls == entry_count);
+  for (int i = 0; i < entry_count; i++) {
+    snprintf(key, sizeof(key), "%d", i);
+    XD_TEST_ASSERT(strcmp(xd_map_get(map, key), key) == 0);
+  }
+
+  for (int i = 0; i < map->bucket_count; i++) {
+    for (xd_list_node_t *node = map->buckets[i]->head; node != NULL;
+         node = node->next) {
+      xd_bucket_entry_t *entry = node->data;
+      XD_TEST_ASSERT(entry->hash == xd_string_hash(entry->key));
+      XD_TEST_ASSERT(entry->hash % map->bucket_count == (unsigned int)i);
+    }
+  }
+
+xd_test_cleanup:
+  xd_map_destroy(map);
+  XD_TEST_END;
+}  // test_xd_map_rehash_cached_hash()
+
 static xd_test_case test_suite[] = {
     XD_TEST_CASE(test_xd_map_create),
     XD_TEST_CASE(test_xd_map_put1),
@@ -575,6 +622,7 @@ static xd_test_case test_suite[] = {
     XD_TEST_CASE(test_xd_map_remove2),
     XD_TEST_CASE(test_xd_map_clear),
     XD_TEST_CASE(test_xd_map_to_array),
+    XD_TEST_CASE(test_xd_map_rehash_cached_hash),
 };
 
 int main() {
@@ -14,11 +14,58 @@
  */
 
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
+#include "xd_alloc.h"
 #include "xd_ctest.h"
 #include "xd_string.h"
 
+// ========================
+// Util Functions
+// ========================
+
+/**
+ * @brief Returns the seconds elapsed since the passed time.
+ */
+static double xd_elapsed_sec(const struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - start->tv_sec) +
+         (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}  // xd_elapsed_sec()
+
+/**
+ * @brief Prints the throughput of a benchmark that appended the passed number
+ * of bytes in the passed time.
+ */
+static void xd_report_throughput(const char *name, size_t bytes, double sec) {
+  printf("  [BENCH] %s: %zu bytes in %.3f ms (%.1f MB/s)\n", name, bytes,
+         sec * 1e3, sec > 0 ? (double)bytes / sec / 1e6 : 0.0);
+}  // xd_report_throughput()
+
+/**
+ * @brief Records a change of the capacity of the passed string, counting it in
+ * `growths` and clearing `is_doubling` unless the capacity doubled.
+ */
+static void xd_track_capacity(const xd_string_t *string, int *capacity,
+                              int *growths, int *is_doubling) {
+  if (string->capacity == *capacity) {
+    return;
+  }
+  if (string->capacity != *capacity * 2) {
+    *is_doubling = 0;
+  }
+  *capacity = string->capacity;
+  (*growths)++;
+}  // xd_track_capacity()
+
+// ========================
+// Test Functions
+// ========================
+
 static int test_xd_string_create() {
   XD_TEST_START;
 
@@ -162,6 +209,230 @@ xd_test_cleanup:
   XD_TEST_END;
 }  // test_xd_string_clear()
 
+static int test_xd_string_small() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_alloc_stats_t before = *xd_alloc_get_stats(XD_ALLOC_STRING);
+  const char *str = "0123456789012345678901234567890";
+
+  // Act
+  xd_string_t *string = xd_string_create();
+  xd_string_append_str(string, str);
+  xd_alloc_stats_t after = *xd_alloc_get_stats(XD_ALLOC_STRING);
+
+  // Assert
+  XD_TEST_ASSERT(string->str == string->small);
+  XD_TEST_ASSERT(after.allocations == before.allocations + 1);
+  XD_TEST_ASSERT(strcmp(string->str, str) == 0);
+
+xd_test_cleanup:
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_small()
+
+static int test_xd_string_append_n() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  const char *str = "0123456789";
+
+  // Act
+  xd_string_append_n(string, str, 4);
+  xd_string_append_n(string, str + 8, 2);
+  xd_string_append_n(string, str, 0);
+
+  // Assert
+  XD_TEST_ASSERT(string->length == 6);
+  XD_TEST_ASSERT(strcmp(string->str, "012389") == 0);
+
+xd_test_cleanup:
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_append_n()
+
+static int test_xd_string_append_fmt1() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  xd_string_append_str(string, "x=");
+
+  // Act
+  xd_string_append_fmt(string, "%d,%s", 42, "y");
+
+  // Assert
+  XD_TEST_ASSERT(string->length == 6);
+  XD_TEST_ASSERT(strcmp(string->str, "x=42,y") == 0);
+  XD_TEST_ASSERT(string->capacity == XD_STR_DEF_CAP);
+
+xd_test_cleanup:
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_append_fmt1()
+
+static int test_xd_string_append_fmt2() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  const char *str = "0123456789012345678901234567890123456789";
+  xd_string_append_str(string, "x=");
+
+  // Act
+  xd_string_append_fmt(string, "%s%s", str, str);
+
+  // Assert
+  XD_TEST_ASSERT(string->length == 2 + 2 * (int)strlen(str));
+  XD_TEST_ASSERT(string->capacity > string->length);
+  XD_TEST_ASSERT(strncmp(string->str, "x=", 2) == 0);
+  XD_TEST_ASSERT(strncmp(string->str + 2, str, strlen(str)) == 0);
+  XD_TEST_ASSERT(strcmp(string->str + 2 + strlen(str), str) == 0);
+
+xd_test_cleanup:
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_append_fmt2()
+
+static int test_xd_string_reserve() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  xd_string_append_str(string, "abc");
+
+  // Act
+  xd_string_reserve(string, 1000);
+  char *str = string->str;
+  for (int i = 0; i < 996; i++) {
+    xd_string_append_chr(string, 'x');
+  }
+
+  // Assert
+  XD_TEST_ASSERT(string->capacity >= 1000);
+  XD_TEST_ASSERT(string->str == str);
+  XD_TEST_ASSERT(string->length == 999);
+  XD_TEST_ASSERT(strncmp(string->str, "abcx", 4) == 0);
+
+xd_test_cleanup:
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_reserve()
+
+static int test_xd_string_release1() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  xd_string_append_str(string, "abc");
+
+  // Act
+  char *str = xd_string_release(string);
+
+  // Assert
+  XD_TEST_ASSERT(str != NULL);
+  XD_TEST_ASSERT(str != string->small);
+  XD_TEST_ASSERT(strcmp(str, "abc") == 0);
+  XD_TEST_ASSERT(string->length == 0);
+  XD_TEST_ASSERT(string->str[0] == '\0');
+
+xd_test_cleanup:
+  free(str);
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_release1()
+
+static int test_xd_string_release2() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  const char *long_str = "0123456789012345678901234567890123456789";
+  xd_string_append_str(string, long_str);
+  char *buffer = string->str;
+
+  // Act
+  char *str = xd_string_release(string);
+
+  // Assert
+  XD_TEST_ASSERT(str == buffer);
+  XD_TEST_ASSERT(strcmp(str, long_str) == 0);
+  XD_TEST_ASSERT(string->str == string->small);
+  XD_TEST_ASSERT(string->length == 0);
+  XD_TEST_ASSERT(string->capacity == XD_STR_DEF_CAP);
+
+xd_test_cleanup:
+  free(str);
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_release2()
+
+static int test_xd_string_append_chr_throughput() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  const int count = 1 << 20;
+  int capacity = string->capacity;
+  int growths = 0;
+  int is_doubling = 1;
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  // Act
+  for (int i = 0; i < count; i++) {
+    xd_string_append_chr(string, (char)('a' + i % 26));
+    xd_track_capacity(string, &capacity, &growths, &is_doubling);
+  }
+  xd_report_throughput("append_chr", (size_t)count, xd_elapsed_sec(&start));
+
+  // Assert
+  // the capacity doubles from 32 to 2^21, reallocating 16 times in total
+  XD_TEST_ASSERT(string->length == count);
+  XD_TEST_ASSERT(string->str[count - 1] == (char)('a' + (count - 1) % 26));
+  XD_TEST_ASSERT(is_doubling);
+  XD_TEST_ASSERT(growths == 16);
+  XD_TEST_ASSERT(string->capacity == 1 << 21);
+
+xd_test_cleanup:
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_append_chr_throughput()
+
+static int test_xd_string_append_n_throughput() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_string_t *string = xd_string_create();
+  const char *word = "word ";
+  const int count = 1 << 18;
+  int capacity = string->capacity;
+  int growths = 0;
+  int is_doubling = 1;
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  // Act
+  for (int i = 0; i < count; i++) {
+    xd_string_append_n(string, word, 5);
+    xd_track_capacity(string, &capacity, &growths, &is_doubling);
+  }
+  xd_report_throughput("append_n", (size_t)count * 5, xd_elapsed_sec(&start));
+
+  // Assert
+  // 5 * 2^18 bytes need a capacity of 2^21, also reached in 16 doublings
+  XD_TEST_ASSERT(string->length == 5 * count);
+  XD_TEST_ASSERT(strncmp(string->str + 5 * (count - 1), word, 5) == 0);
+  XD_TEST_ASSERT(is_doubling);
+  XD_TEST_ASSERT(growths == 16);
+  XD_TEST_ASSERT(string->capacity == 1 << 21);
+
+xd_test_cleanup:
+  xd_string_destroy(string);
+  XD_TEST_END;
+}  // test_xd_string_append_n_throughput()
+
 static xd_test_case test_suite[] = {
     XD_TEST_CASE(test_xd_string_create),
     XD_TEST_CASE(test_xd_string_append_str1),
@@ -169,6 +440,15 @@ static xd_test_case test_suite[] = {
     XD_TEST_CASE(test_xd_string_append_chr1),
     XD_TEST_CASE(test_xd_string_append_chr2),
     XD_TEST_CASE(test_xd_string_clear),
+    XD_TEST_CASE(test_xd_string_small),
+    XD_TEST_CASE(test_xd_string_append_n),
+    XD_TEST_CASE(test_xd_string_append_fmt1),
+    XD_TEST_CASE(test_xd_string_append_fmt2),
+    XD_TEST_CASE(test_xd_string_reserve),
+    XD_TEST_CASE(test_xd_string_release1),
+    XD_TEST_CASE(test_xd_string_release2),
+    XD_TEST_CASE(test_xd_string_append_chr_throughput),
+    XD_TEST_CASE(test_xd_string_append_n_throughput),
 };
 
 int main() {
@@ -0,0 +1,116 @@
+/*
+ * ==============================================================================
+ * File: test_xd_utils.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2025 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "xd_ctest.h"
+#include "xd_utils.h"
+
+// ========================
+// Util Functions
+// ========================
+
+/**
+ * @brief Folds the passed 64-bit SipHash value as `xd_utils_hash()` does.
+ */
+static unsigned int xd_fold(uint64_t hash) {
+  return (unsigned int)(hash ^ (hash >> 32));
+}  // xd_fold()
+
+/**
+ * @brief Sets the key `00 01 02 ... 0f` of the SipHash reference vectors.
+ */
+static void xd_set_reference_key() {
+  xd_utils_hash_set_key(0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL);
+}  // xd_set_reference_key()
+
+// ========================
+// Test Functions
+// ========================
+
+static int test_xd_utils_hash_empty() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_set_reference_key();
+
+  // Act
+  unsigned int hash = xd_utils_hash("", 0);
+
+  // Assert
+  // SipHash-1-3 of the empty message is `dc c4 0f 05 58 01 ac ab`
+  XD_TEST_ASSERT(hash == xd_fold(0xabac0158050fc4dcULL));
+
+xd_test_cleanup:
+  XD_TEST_END;
+}  // test_xd_utils_hash_empty()
+
+static int test_xd_utils_hash_reference_vectors() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_set_reference_key();
+  unsigned char message[16];
+  for (int i = 0; i < 16; i++) {
+    message[i] = (unsigned char)i;
+  }
+
+  // Act - Assert
+  // SipHash-1-3 of the messages `00 01 ... (length - 1)`, covering a partial
+  // word, a full word, and a full word followed by a partial one
+  XD_TEST_ASSERT(xd_utils_hash(message, 1) == xd_fold(0xc9f49bf37d57ca93ULL));
+  XD_TEST_ASSERT(xd_utils_hash(message, 7) == xd_fold(0xd3927d989bb11140ULL));
+  XD_TEST_ASSERT(xd_utils_hash(message, 8) == xd_fold(0x369095118d299a8eULL));
+  XD_TEST_ASSERT(xd_utils_hash(message, 15) ==
+                 xd_fold(0xd320d86d2a519956ULL));
+  XD_TEST_ASSERT(xd_utils_hash(message, 16) ==
+                 xd_fold(0xcc4fdd1a7d908b66ULL));
+
+xd_test_cleanup:
+  XD_TEST_END;
+}  // test_xd_utils_hash_reference_vectors()
+
+static int test_xd_utils_hash_key() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_utils_hash_set_key(1, 2);
+  unsigned int hash1 = xd_utils_hash("PATH", 4);
+  xd_set_reference_key();
+
+  // Act
+  unsigned int hash2 = xd_utils_hash("PATH", 4);
+  unsigned int hash3 = xd_utils_str_hash_func("PATH");
+
+  // Assert
+  XD_TEST_ASSERT(hash1 != hash2);
+  XD_TEST_ASSERT(hash2 == hash3);
+
+xd_test_cleanup:
+  XD_TEST_END;
+}  // test_xd_utils_hash_key()
+
+static xd_test_case test_suite[] = {
+    XD_TEST_CASE(test_xd_utils_hash_empty),
+    XD_TEST_CASE(test_xd_utils_hash_reference_vectors),
+    XD_TEST_CASE(test_xd_utils_hash_key),
+};
+
+int main() {
+  XD_TEST_RUN_ALL(test_suite);
+}  // main()
@@ -0,0 +1,225 @@
+/*
+ * ==============================================================================
+ * File: test_xd_vars.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2025 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xd_ctest.h"
+#include "xd_vars.h"
+
+extern char **environ;
+
+// ========================
+// Util Functions
+// ========================
+
+/**
+ * @brief Returns the number of entries of the passed environment.
+ */
+static int xd_env_count(char **envp) {
+  int count = 0;
+  while (envp != NULL && envp[count] != NULL) {
+    count++;
+  }
+  return count;
+}  // xd_env_count()
+
+/**
+ * @brief Checks whether the passed environment has the passed entry.
+ */
+static int xd_env_has(char **envp, const char *entry) {
+  for (int i = 0; envp != NULL && envp[i] != NULL; i++) {
+    if (strcmp(envp[i], entry) == 0) {
+      return 1;
+    }
+  }
+  return 0;
+}  // xd_env_has()
+
+// ========================
+// Test Functions
+// ========================
+
+static int test_xd_vars_envp_unmodified() {
+  XD_TEST_START;
+
+  // Arrange
+  char **saved_environ = environ;
+  char *env[] = {"A=1", "B=2", NULL};
+  environ = env;
+  xd_vars_init();
+
+  // Act
+  char **envp1 = xd_vars_create_envp();
+  char *value = xd_vars_get("A");
+  char **envp2 = xd_vars_create_envp();
+  xd_vars_put("C", "3", 0);
+  char **envp3 = xd_vars_create_envp();
+
+  // Assert
+  // reading a variable or setting an unexported one keeps the environment
+  XD_TEST_ASSERT(envp1 == env);
+  XD_TEST_ASSERT(value != NULL && strcmp(value, "1") == 0);
+  XD_TEST_ASSERT(envp2 == env);
+  XD_TEST_ASSERT(envp3 == env);
+
+xd_test_cleanup:
+  xd_vars_destroy();
+  environ = saved_environ;
+  XD_TEST_END;
+}  // test_xd_vars_envp_unmodified()
+
+static int test_xd_vars_envp_updated() {
+  XD_TEST_START;
+
+  // Arrange
+  char **saved_environ = environ;
+  char *env[] = {"A=1", "B=2", "C=3", NULL};
+  environ = env;
+  xd_vars_init();
+  char **envp = NULL;
+
+  // Act
+  xd_vars_get("B");
+  xd_vars_put("A", "4", 1);
+  xd_vars_remove("C");
+  xd_vars_put("D", "5", 1);
+  envp = xd_vars_create_envp();
+
+  // Assert
+  XD_TEST_ASSERT(envp != env);
+  XD_TEST_ASSERT(xd_env_count(envp) == 3);
+  XD_TEST_ASSERT(xd_env_has(envp, "A=4"));
+  XD_TEST_ASSERT(xd_env_has(envp, "B=2"));
+  XD_TEST_ASSERT(xd_env_has(envp, "D=5"));
+  XD_TEST_ASSERT(strcmp(env[0], "A=1") == 0);
+
+xd_test_cleanup:
+  xd_vars_destroy_envp(envp);
+  xd_vars_destroy();
+  environ = saved_environ;
+  XD_TEST_END;
+}  // test_xd_vars_envp_updated()
+
+static int test_xd_vars_envp_filtered() {
+  XD_TEST_START;
+
+  // Arrange
+  char **saved_environ = environ;
+  char *env[] = {"1X=bad", "=empty", "NOEQUALS", "A-B=bad",
+                 "D=1",    "E=5",    "D=2",      NULL};
+  environ = env;
+  xd_vars_init();
+  char **envp = NULL;
+
+  // Act
+  envp = xd_vars_create_envp();
+  char *value = xd_vars_get("D");
+
+  // Assert
+  // invalid names are dropped and the later duplicate wins
+  XD_TEST_ASSERT(envp != env);
+  XD_TEST_ASSERT(xd_env_count(envp) == 2);
+  XD_TEST_ASSERT(xd_env_has(envp, "D=2"));
+  XD_TEST_ASSERT(xd_env_has(envp, "E=5"));
+  XD_TEST_ASSERT(value != NULL && strcmp(value, "2") == 0);
+  XD_TEST_ASSERT(xd_vars_get("1X") == NULL);
+
+xd_test_cleanup:
+  xd_vars_destroy_envp(envp);
+  xd_vars_destroy();
+  environ = saved_environ;
+  XD_TEST_END;
+}  // test_xd_vars_envp_filtered()
+
+static int test_xd_vars_envp_order() {
+  XD_TEST_START;
+
+  // Arrange
+  char **saved_environ = environ;
+  char *env[] = {"A=1", "B=2", "C=3", "D=4", NULL};
+  environ = env;
+  xd_vars_init();
+  char **envp = NULL;
+
+  // Act
+  xd_vars_put("Z", "9", 1);
+  xd_vars_put("C", "5", 1);
+  xd_vars_get("A");
+  xd_vars_put("Y", "8", 1);
+  xd_vars_remove("B");
+  envp = xd_vars_create_envp();
+
+  // Assert
+  // the original order is kept, the new variables follow sorted by name
+  XD_TEST_ASSERT(xd_env_count(envp) == 5);
+  XD_TEST_ASSERT(strcmp(envp[0], "A=1") == 0);
+  XD_TEST_ASSERT(strcmp(envp[1], "C=5") == 0);
+  XD_TEST_ASSERT(strcmp(envp[2], "D=4") == 0);
+  XD_TEST_ASSERT(strcmp(envp[3], "Y=8") == 0);
+  XD_TEST_ASSERT(strcmp(envp[4], "Z=9") == 0);
+
+xd_test_cleanup:
+  xd_vars_destroy_envp(envp);
+  xd_vars_destroy();
+  environ = saved_environ;
+  XD_TEST_END;
+}  // test_xd_vars_envp_order()
+
+static int test_xd_vars_envp_cached() {
+  XD_TEST_START;
+
+  // Arrange
+  char **saved_environ = environ;
+  char *env[] = {"A=1", NULL};
+  environ = env;
+  xd_vars_init();
+  xd_vars_put("B", "2", 1);
+
+  // Act
+  char **envp1 = xd_vars_create_envp();
+  xd_vars_destroy_envp(envp1);
+  xd_vars_put("C", "3", 0);
+  char **envp2 = xd_vars_create_envp();
+  xd_vars_destroy_envp(envp2);
+  xd_vars_put("A", "4", 1);
+  char **envp3 = xd_vars_create_envp();
+
+  // Assert
+  // only a change to an exported variable builds the array again
+  XD_TEST_ASSERT(envp1 == envp2);
+  XD_TEST_ASSERT(xd_env_count(envp3) == 2);
+  XD_TEST_ASSERT(strcmp(envp3[0], "A=4") == 0);
+  XD_TEST_ASSERT(strcmp(envp3[1], "B=2") == 0);
+
+xd_test_cleanup:
+  xd_vars_destroy();
+  environ = saved_environ;
+  XD_TEST_END;
+}  // test_xd_vars_envp_cached()
+
+static xd_test_case test_suite[] = {
+    XD_TEST_CASE(test_xd_vars_envp_unmodified),
+    XD_TEST_CASE(test_xd_vars_envp_updated),
+    XD_TEST_CASE(test_xd_vars_envp_filtered),
+    XD_TEST_CASE(test_xd_vars_envp_order),
+    XD_TEST_CASE(test_xd_vars_envp_cached),
+};
+
+int main() {
+  XD_TEST_RUN_ALL(test_suite);
+}  // main()
@@ -0,0 +1,416 @@
+/*
+ * ==============================================================================
+ * File: test_xd_vec.c
+ * Author: Duraid Maihoub
+ * Date: 17 October 2026
+ * Description: Part of the xd-shell project.
+ * Repository: https://github.com/xduraid/xd-shell
+ * ==============================================================================
+ * Copyright (c) 2026 Duraid Maihoub
+ *
+ * xd-shell is distributed under the MIT License. See the LICENSE file
+ * for more information.
+ * ==============================================================================
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "xd_alloc.h"
+#include "xd_ctest.h"
+#include "xd_list.h"
+#include "xd_vec.h"
+
+// ========================
+// Util Functions
+// ========================
+
+static void *xd_string_copy(void *data) {
+  if (data == NULL) {
+    return NULL;
+  }
+  return strdup(data);
+}  // xd_string_copy()
+
+static void xd_string_destroy(void *data) {
+  free(data);
+}  // xd_string_destroy()
+
+static int xd_string_comp(const void *data1, const void *data2) {
+  if (data1 == NULL && data2 == NULL) {
+    return 0;
+  }
+  if (data1 == NULL) {
+    return -1;
+  }
+  if (data2 == NULL) {
+    return 1;
+  }
+  return strcmp(data1, data2);
+}  // xd_string_comp()
+
+static xd_vec_t *xd_string_vec_create() {
+  return xd_vec_create(xd_string_copy, xd_string_destroy, xd_string_comp);
+}  // xd_string_vec_create()
+
+static int xd_string_ptr_comp(const void *ptr1, const void *ptr2) {
+  return strcmp(*(char *const *)ptr1, *(char *const *)ptr2);
+}  // xd_string_ptr_comp()
+
+/**
+ * @brief Returns the seconds elapsed since the passed time.
+ */
+static double xd_elapsed_sec(const struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - start->tv_sec) +
+         (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}  // xd_elapsed_sec()
+
+/**
+ * @brief Prints the times taken by the vec and the list for the passed loop.
+ */
+static void xd_report_times(const char *name, int count, double vec_sec,
+                            double list_sec) {
+  printf("  [BENCH] %s x%d: vec %.3f ms, list %.3f ms\n", name, count,
+         vec_sec * 1e3, list_sec * 1e3);
+}  // xd_report_times()
+
+// ========================
+// Test Functions
+// ========================
+
+static int test_xd_vec_create() {
+  XD_TEST_START;
+
+  // Arrange - Act
+  xd_vec_t *vec = xd_string_vec_create();
+
+  // Assert
+  XD_TEST_ASSERT(vec != NULL);
+  XD_TEST_ASSERT(vec->data != NULL);
+  XD_TEST_ASSERT(vec->data[0] == NULL);
+  XD_TEST_ASSERT(vec->length == 0);
+  XD_TEST_ASSERT(vec->capacity == XD_VEC_DEF_CAP);
+  XD_TEST_ASSERT(xd_vec_create(NULL, xd_string_destroy, xd_string_comp) ==
+                 NULL);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  XD_TEST_END;
+}  // test_xd_vec_create()
+
+static int test_xd_vec_push() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_vec_t *vec = xd_string_vec_create();
+  char str[] = "A";
+
+  // Act
+  for (int i = 0; i < XD_VEC_DEF_CAP + 1; i++) {
+    xd_vec_push(vec, str);
+  }
+
+  // Assert
+  XD_TEST_ASSERT(vec->length == XD_VEC_DEF_CAP + 1);
+  XD_TEST_ASSERT(vec->capacity == 2 * XD_VEC_DEF_CAP);
+  XD_TEST_ASSERT(vec->data[0] != str);
+  XD_TEST_ASSERT(strcmp(vec->data[XD_VEC_DEF_CAP], "A") == 0);
+  XD_TEST_ASSERT(vec->data[vec->length] == NULL);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  XD_TEST_END;
+}  // test_xd_vec_push()
+
+static int test_xd_vec_pop() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_vec_t *vec = xd_string_vec_create();
+  xd_vec_push(vec, "A");
+  xd_vec_push(vec, "B");
+
+  // Act
+  int ret1 = xd_vec_pop(vec);
+  int ret2 = xd_vec_pop(vec);
+  int ret3 = xd_vec_pop(vec);
+
+  // Assert
+  XD_TEST_ASSERT(ret1 == 0);
+  XD_TEST_ASSERT(ret2 == 0);
+  XD_TEST_ASSERT(ret3 == -1);
+  XD_TEST_ASSERT(vec->length == 0);
+  XD_TEST_ASSERT(vec->data[0] == NULL);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  XD_TEST_END;
+}  // test_xd_vec_pop()
+
+static int test_xd_vec_get_set() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_vec_t *vec = xd_string_vec_create();
+  xd_vec_push(vec, "A");
+  xd_vec_push(vec, "B");
+
+  // Act
+  int ret1 = xd_vec_set(vec, 1, "C");
+  int ret2 = xd_vec_set(vec, 0, xd_vec_get(vec, 0));
+  int ret3 = xd_vec_set(vec, 2, "D");
+
+  // Assert
+  XD_TEST_ASSERT(ret1 == 0);
+  XD_TEST_ASSERT(ret2 == 0);
+  XD_TEST_ASSERT(ret3 == -1);
+  XD_TEST_ASSERT(strcmp(xd_vec_get(vec, 0), "A") == 0);
+  XD_TEST_ASSERT(strcmp(xd_vec_get(vec, 1), "C") == 0);
+  XD_TEST_ASSERT(xd_vec_get(vec, 2) == NULL);
+  XD_TEST_ASSERT(xd_vec_get(vec, -1) == NULL);
+  XD_TEST_ASSERT(xd_vec_get(NULL, 0) == NULL);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  XD_TEST_END;
+}  // test_xd_vec_get_set()
+
+static int test_xd_vec_sort_dedupe() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_vec_t *vec = xd_string_vec_create();
+  const char *strs[] = {"d", "b", "a", "d", "c", "b", "a", "e", "a"};
+  for (size_t i = 0; i < sizeof(strs) / sizeof(strs[0]); i++) {
+    xd_vec_push(vec, (void *)strs[i]);
+  }
+
+  // Act
+  xd_vec_sort(vec);
+  int removed = xd_vec_dedupe(vec);
+
+  // Assert
+  XD_TEST_ASSERT(removed == 4);
+  XD_TEST_ASSERT(vec->length == 5);
+  XD_TEST_ASSERT(strcmp(vec->data[0], "a") == 0);
+  XD_TEST_ASSERT(strcmp(vec->data[1], "b") == 0);
+  XD_TEST_ASSERT(strcmp(vec->data[2], "c") == 0);
+  XD_TEST_ASSERT(strcmp(vec->data[3], "d") == 0);
+  XD_TEST_ASSERT(strcmp(vec->data[4], "e") == 0);
+  XD_TEST_ASSERT(vec->data[5] == NULL);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  XD_TEST_END;
+}  // test_xd_vec_sort_dedupe()
+
+static int test_xd_vec_bsearch() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_vec_t *vec = xd_string_vec_create();
+  const char *strs[] = {"a", "c", "e", "g", "i"};
+  for (size_t i = 0; i < sizeof(strs) / sizeof(strs[0]); i++) {
+    xd_vec_push(vec, (void *)strs[i]);
+  }
+
+  // Act - Assert
+  XD_TEST_ASSERT(xd_vec_bsearch(vec, "a") == 0);
+  XD_TEST_ASSERT(xd_vec_bsearch(vec, "e") == 2);
+  XD_TEST_ASSERT(xd_vec_bsearch(vec, "i") == 4);
+  XD_TEST_ASSERT(xd_vec_bsearch(vec, "b") == -1);
+  XD_TEST_ASSERT(xd_vec_bsearch(vec, "z") == -1);
+  XD_TEST_ASSERT(xd_vec_bsearch(NULL, "a") == -1);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  XD_TEST_END;
+}  // test_xd_vec_bsearch()
+
+static int test_xd_vec_release() {
+  XD_TEST_START;
+
+  // Arrange
+  xd_vec_t *vec = xd_string_vec_create();
+  xd_vec_push(vec, "A");
+  xd_vec_push(vec, "B");
+  void **expected = vec->data;
+
+  // Act
+  char **arr = (char **)xd_vec_release(vec);
+
+  // Assert
+  XD_TEST_ASSERT((void **)arr == expected);
+  XD_TEST_ASSERT(strcmp(arr[0], "A") == 0);
+  XD_TEST_ASSERT(strcmp(arr[1], "B") == 0);
+  XD_TEST_ASSERT(arr[2] == NULL);
+  XD_TEST_ASSERT(vec->length == 0);
+  XD_TEST_ASSERT(vec->data != NULL);
+  XD_TEST_ASSERT(vec->data[0] == NULL);
+
+xd_test_cleanup:
+  for (int i = 0; arr != NULL && arr[i] != NULL; i++) {
+    free(arr[i]);
+  }
+  free((void *)arr);
+  xd_vec_destroy(vec);
+  XD_TEST_END;
+}  // test_xd_vec_release()
+
+static int test_xd_vec_vs_list_allocations() {
+  XD_TEST_START;
+
+  // Arrange
+  const int count = 1000;
+  char strs[1000][8];
+  for (int i = 0; i < count; i++) {
+    snprintf(strs[i], sizeof(strs[i]), "%04d", count - 1 - i);
+  }
+  xd_list_pool_clear();
+  const xd_alloc_stats_t *vec_stats = xd_alloc_get_stats(XD_ALLOC_VEC);
+  const xd_alloc_stats_t *list_stats = xd_alloc_get_stats(XD_ALLOC_LIST);
+  size_t vec_allocations = vec_stats->allocations;
+  size_t vec_bytes = vec_stats->current_bytes;
+  size_t list_allocations = list_stats->allocations;
+  xd_vec_t *vec = xd_string_vec_create();
+  xd_list_t *list =
+      xd_list_create(xd_string_copy, xd_string_destroy, xd_string_comp);
+
+  // Act
+  for (int i = 0; i < count; i++) {
+    xd_vec_push(vec, strs[i]);
+    xd_list_add_last(list, strs[i]);
+  }
+  int is_indexed = 1;
+  for (int i = 0; i < count; i++) {
+    if (strcmp(xd_vec_get(vec, i), xd_list_get(list, i)) != 0) {
+      is_indexed = 0;
+    }
+  }
+  xd_vec_sort(vec);
+  int is_sorted = 1;
+  for (int i = 0; i < count; i++) {
+    if (strcmp(xd_vec_get(vec, i), strs[count - 1 - i]) != 0) {
+      is_sorted = 0;
+    }
+  }
+  size_t vec_allocated = vec_stats->allocations - vec_allocations;
+  size_t list_allocated = list_stats->allocations - list_allocations;
+  xd_vec_destroy(vec);
+  vec = NULL;
+
+  // Assert
+  XD_TEST_ASSERT(is_indexed);
+  XD_TEST_ASSERT(is_sorted);
+  // the vec grows its single array in place, the list allocates every node
+  XD_TEST_ASSERT(vec_allocated == 2);
+  XD_TEST_ASSERT(list_allocated == (size_t)count + 1);
+  XD_TEST_ASSERT(vec_stats->current_bytes == vec_bytes);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  xd_list_destroy(list);
+  xd_list_pool_clear();
+  XD_TEST_END;
+}  // test_xd_vec_vs_list_allocations()
+
+static int test_xd_vec_vs_list_throughput() {
+  XD_TEST_START;
+
+  // Arrange
+  const int count = 4096;
+  char **strs = (char **)malloc(sizeof(char *) * count);
+  char **list_arr = (char **)malloc(sizeof(char *) * count);
+  for (int i = 0; i < count; i++) {
+    strs[i] = (char *)malloc(8);
+    snprintf(strs[i], 8, "%04d", (i * 7919) % count);
+  }
+  xd_vec_t *vec = xd_string_vec_create();
+  xd_list_t *list =
+      xd_list_create(xd_string_copy, xd_string_destroy, xd_string_comp);
+  struct timespec start;
+  double vec_sec, list_sec;
+
+  // Act
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < count; i++) {
+    xd_vec_push(vec, strs[i]);
+  }
+  vec_sec = xd_elapsed_sec(&start);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < count; i++) {
+    xd_list_add_last(list, strs[i]);
+  }
+  list_sec = xd_elapsed_sec(&start);
+  xd_report_times("push", count, vec_sec, list_sec);
+
+  size_t vec_sum = 0;
+  size_t list_sum = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < count; i++) {
+    vec_sum += (size_t)((char *)xd_vec_get(vec, i))[3];
+  }
+  vec_sec = xd_elapsed_sec(&start);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < count; i++) {
+    list_sum += (size_t)((char *)xd_list_get(list, i))[3];
+  }
+  list_sec = xd_elapsed_sec(&start);
+  xd_report_times("index", count, vec_sec, list_sec);
+
+  // the list is sorted as it was before `xd_vec_t`, through a copied array
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  xd_vec_sort(vec);
+  vec_sec = xd_elapsed_sec(&start);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  int list_count = 0;
+  for (xd_list_node_t *node = list->head; node != NULL; node = node->next) {
+    list_arr[list_count++] = node->data;
+  }
+  qsort((void *)list_arr, list_count, sizeof(char *), xd_string_ptr_comp);
+  list_sec = xd_elapsed_sec(&start);
+  xd_report_times("sort", count, vec_sec, list_sec);
+
+  int is_same = (list_count == vec->length);
+  for (int i = 0; is_same && i < count; i++) {
+    is_same = (strcmp(xd_vec_get(vec, i), list_arr[i]) == 0);
+  }
+
+  // Assert
+  XD_TEST_ASSERT(vec->length == count);
+  XD_TEST_ASSERT(list->length == count);
+  XD_TEST_ASSERT(vec_sum == list_sum);
+  XD_TEST_ASSERT(is_same);
+
+xd_test_cleanup:
+  xd_vec_destroy(vec);
+  xd_list_destroy(list);
+  xd_list_pool_clear();
+  for (int i = 0; i < count; i++) {
+    free(strs[i]);
+  }
+  free((void *)strs);
+  free((void *)list_arr);
+  XD_TEST_END;
+}  // test_xd_vec_vs_list_throughput()
+
+static xd_test_case test_suite[] = {
+    XD_TEST_CASE(test_xd_vec_create),
+    XD_TEST_CASE(test_xd_vec_push),
+    XD_TEST_CASE(test_xd_vec_pop),
+    XD_TEST_CASE(test_xd_vec_get_set),
+    XD_TEST_CASE(test_xd_vec_sort_dedupe),
+    XD_TEST_CASE(test_xd_vec_bsearch),
+    XD_TEST_CASE(test_xd_vec_release),
+    XD_TEST_CASE(test_xd_vec_vs_list_allocations),
+    XD_TEST_CASE(test_xd_vec_vs_list_throughput),
+};
+
+int main() {
+  XD_TEST_RUN_ALL(test_suite);
+}  // main()